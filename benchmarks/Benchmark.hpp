@@ -0,0 +1,294 @@
+// Benchmark.hpp
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Keeps the optimizer from discarding a value the benchmark computed
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// Class measuring the timed region of a benchmark
+class Timer {
+private:
+  std::chrono::steady_clock::time_point started;      // Start of the current region
+  double elapsed;                                     // Seconds accumulated over finished regions
+public:
+  Timer() : elapsed(0) {}
+
+  void start() { started = std::chrono::steady_clock::now(); }
+  void stop() { elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count(); }
+  const double seconds() const { return elapsed; }
+};
+
+// Distributions the workloads draw element indices from
+enum class Distribution { Uniform, Zipfian, Sorted };
+
+inline const char* distribution_name(Distribution distribution) {
+  switch (distribution) {
+    case Distribution::Uniform: return "uniform";
+    case Distribution::Zipfian: return "zipfian";
+    case Distribution::Sorted: return "sorted";
+  }
+  return "";
+}
+
+// Class drawing Zipfian ranks in O(1) per sample (Gray et al., "Quickly generating billion-record synthetic databases")
+// Rank 0 is the most popular; theta 0.99 matches the YCSB default skew
+class ZipfianGenerator {
+private:
+  size_t items;                       // Number of ranks
+  double theta;                       // Skew
+  double zetan;                       // Generalized harmonic number of items
+  double alpha;                       // 1 / (1 - theta)
+  double eta;                         // Correction term of the inversion
+
+  static double zeta(size_t n, double theta) {
+    double sum = 0;
+    for (size_t i = 1; i <= n; i++) {
+      sum += 1.0 / std::pow(double(i), theta);
+    }
+    return sum;
+  }
+public:
+  ZipfianGenerator(size_t items, double theta = 0.99) : items(std::max<size_t>(items, 1)), theta(theta) {
+    zetan = zeta(this->items, theta);
+    alpha = 1.0 / (1.0 - theta);
+    eta = (1.0 - std::pow(2.0 / this->items, 1.0 - theta)) / (1.0 - zeta(2, theta) / zetan);
+  }
+
+  template <typename Rng>
+  size_t next(Rng& rng) {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double uz = u * zetan;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + std::pow(0.5, theta)) return std::min<size_t>(1, items - 1);
+    return std::min(items - 1, size_t(double(items) * std::pow(eta * u - eta + 1.0, alpha)));
+  }
+};
+
+// Returns count indices in [0, n) following the distribution, reproducible from the seed
+// Zipfian ranks go through a fixed permutation so the hot elements are scattered instead of all being the smallest
+inline std::vector<size_t> make_indices(Distribution distribution, size_t count, size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<size_t> indices(count);
+  if (n == 0) return indices;
+
+  switch (distribution) {
+    case Distribution::Uniform:
+      for (size_t& index : indices) {
+        index = std::uniform_int_distribution<size_t>(0, n - 1)(rng);
+      }
+      break;
+    case Distribution::Zipfian: {
+      std::vector<size_t> permutation(n);
+      for (size_t i = 0; i < n; i++) {
+        permutation[i] = i;
+      }
+      std::shuffle(permutation.begin(), permutation.end(), rng);
+
+      ZipfianGenerator zipf(n);
+      for (size_t& index : indices) {
+        index = permutation[zipf.next(rng)];
+      }
+      break;
+    }
+    case Distribution::Sorted:
+      for (size_t i = 0; i < count; i++) {
+        indices[i] = i % n;
+      }
+      break;
+  }
+
+  return indices;
+}
+
+// Returns the indices [0, n) in a random order
+inline std::vector<size_t> make_permutation(size_t n, uint64_t seed) {
+  std::vector<size_t> permutation(n);
+  for (size_t i = 0; i < n; i++) {
+    permutation[i] = i;
+  }
+  std::shuffle(permutation.begin(), permutation.end(), std::mt19937_64(seed));
+  return permutation;
+}
+
+// Struct describing one benchmark
+// run builds its own state, times the measured part with the timer and returns the number of operations it timed
+struct BenchmarkCase {
+  std::string container;              // Container under test, e.g. "AVLTree" or "std::map"
+  std::string workload;               // Operation mix, e.g. "insert" or "lookup_miss"
+  std::string distribution;           // Key or index distribution, empty when not applicable
+  size_t n;                           // Number of elements the workload works on
+  std::function<size_t(Timer&)> run;  // Runs the benchmark once
+
+  const std::string name() const {
+    std::string full = container + "/" + workload;
+    if (!distribution.empty()) full += "/" + distribution;
+    return full;
+  }
+};
+
+// Struct holding the measurements of one benchmark
+struct BenchmarkResult {
+  BenchmarkCase* benchmark;           // Benchmark measured
+  bool ok;                            // False if the benchmark threw or crashed
+  size_t ops;                         // Operations per repetition
+  double seconds;                     // Median timed seconds per repetition
+  long peak_rss_kb;                   // Peak resident set size of the process running the benchmark
+
+  const double ns_per_op() const { return ops == 0 ? 0 : seconds * 1e9 / double(ops); }
+  const double ops_per_second() const { return seconds == 0 ? 0 : double(ops) / seconds; }
+};
+
+// Struct holding the command line options of the suite
+struct BenchmarkOptions {
+  size_t size = 100000;               // Elements per workload
+  uint64_t seed = 42;                 // Seed of every generated workload
+  int repeat = 3;                     // Repetitions per benchmark, the median is reported
+  std::string filter;                 // Only benchmarks whose name contains this run
+  std::string json;                   // File to write JSON results to, "-" for stdout
+  bool isolate = true;                // Run every benchmark in its own process so peak RSS is per benchmark
+  bool list = false;                  // Only list the benchmark names
+};
+
+// Runs a benchmark in the calling process, repeat times
+inline BenchmarkResult run_benchmark(BenchmarkCase& benchmark, int repeat) {
+  BenchmarkResult result{&benchmark, true, 0, 0, 0};
+  std::vector<double> samples;
+
+  try {
+    for (int i = 0; i < std::max(1, repeat); i++) {
+      Timer timer;
+      result.ops = benchmark.run(timer);
+      samples.push_back(timer.seconds());
+    }
+  } catch (...) {
+    result.ok = false;
+    return result;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  result.seconds = samples[samples.size() / 2];
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  result.peak_rss_kb = usage.ru_maxrss;
+  return result;
+}
+
+// Runs a benchmark in a forked child, reading back its result and its own peak RSS
+inline BenchmarkResult run_isolated(BenchmarkCase& benchmark, int repeat) {
+  BenchmarkResult result{&benchmark, false, 0, 0, 0};
+
+  int channel[2];
+  if (pipe(channel) != 0) return run_benchmark(benchmark, repeat);
+
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child < 0) {
+    close(channel[0]);
+    close(channel[1]);
+    return run_benchmark(benchmark, repeat);
+  }
+
+  if (child == 0) {
+    close(channel[0]);
+    BenchmarkResult measured = run_benchmark(benchmark, repeat);
+    double message[3] = {measured.ok ? 1.0 : 0.0, double(measured.ops), measured.seconds};
+    ssize_t written = write(channel[1], message, sizeof(message));
+    _exit(written == ssize_t(sizeof(message)) ? 0 : 1);
+  }
+
+  close(channel[1]);
+  double message[3] = {0, 0, 0};
+  size_t received = 0;
+  while (received < sizeof(message)) {
+    ssize_t count = read(channel[0], reinterpret_cast<char*>(message) + received, sizeof(message) - received);
+    if (count <= 0) break;
+    received += count;
+  }
+  close(channel[0]);
+
+  int status = 0;
+  struct rusage usage;
+  wait4(child, &status, 0, &usage);
+
+  result.ok = received == sizeof(message) && message[0] == 1.0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  result.ops = size_t(message[1]);
+  result.seconds = message[2];
+  result.peak_rss_kb = usage.ru_maxrss;
+  return result;
+}
+
+// Escapes a string for a JSON document
+inline std::string json_escape(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+// Writes the results as one JSON document
+inline void write_json(std::FILE* out, const BenchmarkOptions& options, const std::vector<BenchmarkResult>& results) {
+  std::fprintf(out, "{\n  \"seed\": %llu,\n  \"size\": %zu,\n  \"repeat\": %d,\n  \"isolated\": %s,\n  \"results\": [\n",
+    (unsigned long long)options.seed, options.size, options.repeat, options.isolate ? "true" : "false");
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchmarkResult& result = results[i];
+    const BenchmarkCase& benchmark = *result.benchmark;
+    std::fprintf(out, "    {\"name\": \"%s\", \"container\": \"%s\", \"workload\": \"%s\", \"distribution\": \"%s\", "
+      "\"n\": %zu, \"ok\": %s, \"ops\": %zu, \"seconds\": %.9f, \"ns_per_op\": %.3f, \"ops_per_second\": %.1f, \"peak_rss_kb\": %ld}%s\n",
+      json_escape(benchmark.name()).c_str(), json_escape(benchmark.container).c_str(), json_escape(benchmark.workload).c_str(),
+      json_escape(benchmark.distribution).c_str(), benchmark.n, result.ok ? "true" : "false", result.ops, result.seconds,
+      result.ns_per_op(), result.ops_per_second(), result.peak_rss_kb, i + 1 < results.size() ? "," : "");
+  }
+
+  std::fprintf(out, "  ]\n}\n");
+}
+
+// Runs every selected benchmark, printing a table line per benchmark as it finishes
+inline std::vector<BenchmarkResult> run_benchmarks(std::vector<BenchmarkCase>& benchmarks, const BenchmarkOptions& options) {
+  std::vector<BenchmarkResult> results;
+  std::FILE* table = options.json == "-" ? stderr : stdout;
+
+  std::fprintf(table, "%-52s %10s %12s %14s %12s\n", "benchmark", "n", "ns/op", "ops/s", "peak RSS KB");
+  for (BenchmarkCase& benchmark : benchmarks) {
+    if (!options.filter.empty() && benchmark.name().find(options.filter) == std::string::npos) continue;
+
+    BenchmarkResult result = options.isolate ? run_isolated(benchmark, options.repeat) : run_benchmark(benchmark, options.repeat);
+    if (result.ok) {
+      std::fprintf(table, "%-52s %10zu %12.2f %14.0f %12ld\n", benchmark.name().c_str(), benchmark.n,
+        result.ns_per_op(), result.ops_per_second(), result.peak_rss_kb);
+    } else {
+      std::fprintf(table, "%-52s %10zu %12s\n", benchmark.name().c_str(), benchmark.n, "FAILED");
+    }
+    std::fflush(table);
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+#endif
@@ -0,0 +1,156 @@
+// HeapBenchmarks.hpp
+#ifndef HEAPBENCHMARKS_H
+#define HEAPBENCHMARKS_H
+
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "heaps/DaryHeap.hpp"
+#include "heaps/PairingHeap.hpp"
+#include "trees/AVLTree.hpp"
+
+// Min-priority queue of the standard library, for comparison
+using StdMinHeap = std::priority_queue<int, std::vector<int>, std::greater<int>>;
+
+// Pushes a priority, returning what heap_decrease needs to find it again
+template <typename H>
+auto heap_push(H& heap, int priority) { return heap.push(priority); }
+
+inline int heap_push(StdMinHeap& heap, int priority) {
+  heap.push(priority);
+  return priority;
+}
+
+// An AVLTree used as a priority queue: priorities are keys, so they must be distinct
+template <typename K, typename V>
+int heap_push(AVLTree<K, V>& heap, int priority) {
+  heap.insert(priority, priority);
+  return priority;
+}
+
+// Removes and returns the smallest priority
+template <typename H>
+int heap_pop(H& heap) { return heap.take(); }
+
+inline int heap_pop(StdMinHeap& heap) {
+  int priority = heap.top();
+  heap.pop();
+  return priority;
+}
+
+template <typename K, typename V>
+int heap_pop(AVLTree<K, V>& heap) {
+  int priority = heap.begin().get_key();
+  heap.remove(priority);
+  return priority;
+}
+
+// Pushes a whole range of priorities
+template <typename H>
+void heap_push_many(H& heap, const std::vector<int>& priorities) { heap.push_many(priorities.begin(), priorities.end()); }
+
+inline void heap_push_many(StdMinHeap& heap, const std::vector<int>& priorities) { heap = StdMinHeap(priorities.begin(), priorities.end()); }
+
+template <typename K, typename V>
+void heap_push_many(AVLTree<K, V>& heap, const std::vector<int>& priorities) {
+  for (int priority : priorities) {
+    heap.insert(priority, priority);
+  }
+}
+
+// Lowers the priority pushed under a handle
+template <typename H, typename Handle>
+void heap_decrease(H& heap, Handle handle, int, int priority) { heap.decrease_key(handle, priority); }
+
+template <typename K, typename V>
+void heap_decrease(AVLTree<K, V>& heap, int old_priority, int, int priority) {
+  heap.remove(old_priority);
+  heap.insert(priority, priority);
+}
+
+// Returns the priorities n + index of [0, n) in random order, leaving [0, n) free for decreases
+inline std::vector<int> make_priorities(size_t n, uint64_t seed) {
+  std::vector<int> priorities;
+  priorities.reserve(n);
+  for (size_t index : make_permutation(n, seed)) {
+    priorities.push_back(int(n + index));
+  }
+  return priorities;
+}
+
+// Registers the priority queue workloads of one container
+// decrease_key is registered only for containers that can find a pushed element again
+template <typename H, bool DecreaseKey = true>
+void add_heap_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  cases.push_back({name, "push", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<int> priorities = make_priorities(n, seed);
+    H heap;
+    timer.start();
+    for (int priority : priorities) {
+      heap_push(heap, priority);
+    }
+    timer.stop();
+    keep(heap);
+    return n;
+  }});
+
+  cases.push_back({name, "push_many", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<int> priorities = make_priorities(n, seed);
+    H heap;
+    timer.start();
+    heap_push_many(heap, priorities);
+    timer.stop();
+    keep(heap);
+    return n;
+  }});
+
+  cases.push_back({name, "pop", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<int> priorities = make_priorities(n, seed);
+    H heap;
+    for (int priority : priorities) {
+      heap_push(heap, priority);
+    }
+    long total = 0;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      total += heap_pop(heap);
+    }
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+
+  // Dijkstra-like: every element is lowered once, then everything is popped
+  if constexpr (DecreaseKey) {
+    cases.push_back({name, "decrease_key", "uniform", 2 * n, [n, seed](Timer& timer) {
+      std::vector<int> priorities = make_priorities(n, seed);
+      std::vector<size_t> order = make_permutation(n, seed + 1);
+      H heap;
+      std::vector<decltype(heap_push(heap, 0))> handles;
+      handles.reserve(n);
+      for (int priority : priorities) {
+        handles.push_back(heap_push(heap, priority));
+      }
+
+      long total = 0;
+      timer.start();
+      for (size_t i : order) {
+        heap_decrease(heap, handles[i], priorities[i], priorities[i] - int(n));
+      }
+      for (size_t i = 0; i < n; i++) {
+        total += heap_pop(heap);
+      }
+      timer.stop();
+      keep(total);
+      return 2 * n;
+    }});
+  }
+}
+
+#endif
@@ -0,0 +1,150 @@
+// LayoutBenchmarks.hpp
+#ifndef LAYOUTBENCHMARKS_H
+#define LAYOUTBENCHMARKS_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "linear/SoAVector.hpp"
+#include "linear/Vector.hpp"
+
+// A 64-byte record of which queries read one or two fields
+struct TradeRecord {
+  uint64_t id;
+  double price;
+  double quantity;
+  int64_t timestamp;
+  uint64_t account;
+  uint64_t venue;
+  int64_t side;
+  double fee;
+};
+
+// The same record stored one array per field
+using TradeColumns = SoAVector<uint64_t, double, double, int64_t, uint64_t, uint64_t, int64_t, double>;
+using TradeRows = Vector<TradeRecord>;
+
+// Returns an empty layout with room for n trades
+template <typename L>
+L make_layout(size_t n);
+
+template <>
+inline TradeRows make_layout<TradeRows>(size_t n) { return TradeRows(n, n); }
+
+template <>
+inline TradeColumns make_layout<TradeColumns>(size_t n) { return TradeColumns(n); }
+
+// Appends the i-th generated trade
+inline void layout_push(TradeRows& trades, size_t i, double price) {
+  trades.push_back(TradeRecord{i, price, double(i % 100), int64_t(i), i % 1000, i % 7, int64_t(i % 2), price / 1000});
+}
+
+inline void layout_push(TradeColumns& trades, size_t i, double price) {
+  trades.emplace_back(i, price, double(i % 100), int64_t(i), i % 1000, i % 7, int64_t(i % 2), price / 1000);
+}
+
+// Returns the total price of every trade
+inline double layout_sum(const TradeRows& trades) {
+  double total = 0;
+  for (const TradeRecord& trade : trades) {
+    total += trade.price;
+  }
+  return total;
+}
+
+inline double layout_sum(const TradeColumns& trades) {
+  double total = 0;
+  for (double price : trades.column<1>()) {
+    total += price;
+  }
+  return total;
+}
+
+// Returns the total quantity of the trades above a price
+inline double layout_filter_sum(const TradeRows& trades, double threshold) {
+  double total = 0;
+  for (const TradeRecord& trade : trades) {
+    total += trade.price > threshold ? trade.quantity : 0;
+  }
+  return total;
+}
+
+inline double layout_filter_sum(const TradeColumns& trades, double threshold) {
+  ColumnSpan<const double> prices = trades.column<1>();
+  ColumnSpan<const double> quantities = trades.column<2>();
+  double total = 0;
+  for (size_t i = 0; i < prices.size(); i++) {
+    total += prices[i] > threshold ? quantities[i] : 0;
+  }
+  return total;
+}
+
+// Returns n prices drawn uniformly from [0, 1000)
+inline std::vector<double> make_prices(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> price(0, 1000);
+  std::vector<double> prices(n);
+  for (double& value : prices) {
+    value = price(rng);
+  }
+  return prices;
+}
+
+// Registers the row and column scan workloads of one layout, built with room for every trade up front
+template <typename L>
+void add_layout_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  cases.push_back({name, "push", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<double> prices = make_prices(n, seed);
+    L trades = make_layout<L>(n);
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      layout_push(trades, i, prices[i]);
+    }
+    timer.stop();
+    keep(trades);
+    return n;
+  }});
+
+  // Each pass reads one field of every trade; several passes keep the time well above the timer resolution
+  cases.push_back({name, "sum_column", "sequential", 16 * n, [n, seed](Timer& timer) {
+    std::vector<double> prices = make_prices(n, seed);
+    L trades = make_layout<L>(n);
+    for (size_t i = 0; i < n; i++) {
+      layout_push(trades, i, prices[i]);
+    }
+
+    double total = 0;
+    timer.start();
+    for (int pass = 0; pass < 16; pass++) {
+      total += layout_sum(trades);
+    }
+    timer.stop();
+    keep(total);
+    return 16 * n;
+  }});
+
+  cases.push_back({name, "filter_sum", "sequential", 16 * n, [n, seed](Timer& timer) {
+    std::vector<double> prices = make_prices(n, seed);
+    L trades = make_layout<L>(n);
+    for (size_t i = 0; i < n; i++) {
+      layout_push(trades, i, prices[i]);
+    }
+
+    double total = 0;
+    timer.start();
+    for (int pass = 0; pass < 16; pass++) {
+      total += layout_filter_sum(trades, 500.0 + pass);
+    }
+    timer.stop();
+    keep(total);
+    return 16 * n;
+  }});
+}
+
+#endif
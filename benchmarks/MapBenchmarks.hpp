@@ -0,0 +1,196 @@
+// MapBenchmarks.hpp
+#ifndef MAPBENCHMARKS_H
+#define MAPBENCHMARKS_H
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "trees/AVLTree.hpp"
+#include "trees/BST.hpp"
+#include "trees/FilteredTree.hpp"
+#include "trees/PersistentAVLTree.hpp"
+
+// Keys are even so that odd keys are guaranteed misses
+inline int map_key(size_t index) { return int(2 * index); }
+
+// Inserts a pair, keeping the existing value on duplicates
+template <typename M>
+void map_insert(M& map, int key, int value) { map.try_emplace(key, value); }
+
+template <typename K, typename V>
+void map_insert(PersistentAVLTree<K, V>& map, int key, int value) { map = map.insert(key, value); }
+
+// Returns the value of a key known to be present
+template <typename M>
+int map_lookup(M& map, int key) { return map.search(key); }
+
+template <typename K, typename V>
+int map_lookup(std::map<K, V>& map, int key) { return map.find(key)->second; }
+
+// Returns if a key is present
+template <typename M>
+bool map_contains(M& map, int key) { return map.contains(key); }
+
+template <typename K, typename V>
+bool map_contains(std::map<K, V>& map, int key) { return map.find(key) != map.end(); }
+
+// Removes a key if present
+template <typename M>
+void map_remove(M& map, int key) { map.remove(key); }
+
+template <typename K, typename V>
+void map_remove(PersistentAVLTree<K, V>& map, int key) { map = map.remove(key); }
+
+template <typename K, typename V>
+void map_remove(std::map<K, V>& map, int key) { map.erase(key); }
+
+// Sums every value in key order
+template <typename M>
+long map_sum(M& map) {
+  long total = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    total += it.get_value();
+  }
+  return total;
+}
+
+template <typename K, typename V>
+long map_sum(BST<K, V>& map) {
+  long total = 0;
+  map.for_each([&](const K&, V& value) { total += value; });
+  return total;
+}
+
+template <typename K, typename V, typename T, typename F>
+long map_sum(FilteredTree<K, V, T, F>& map) {
+  return map.tree().reduce(0L, [](long total, const K&, const V& value) { return total + value; });
+}
+
+template <typename K, typename V>
+long map_sum(std::map<K, V>& map) {
+  long total = 0;
+  for (auto& pair : map) {
+    total += pair.second;
+  }
+  return total;
+}
+
+// Returns a map holding the keys of [0, n) inserted in random order
+template <typename M>
+M make_map(size_t n, uint64_t seed) {
+  M map;
+  for (size_t index : make_permutation(n, seed)) {
+    map_insert(map, map_key(index), int(index));
+  }
+  return map;
+}
+
+// Registers the ordered map workloads of one container
+// sorted_cap limits the sorted insert workload of trees that degrade to lists on sorted input
+template <typename M>
+void add_map_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options, size_t sorted_cap = 0) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+  const Distribution distributions[] = {Distribution::Uniform, Distribution::Zipfian, Distribution::Sorted};
+
+  for (Distribution distribution : distributions) {
+    size_t count = distribution == Distribution::Sorted && sorted_cap != 0 ? std::min(n, sorted_cap) : n;
+    cases.push_back({name, "insert", distribution_name(distribution), count, [count, seed, distribution](Timer& timer) {
+      std::vector<size_t> indices = make_indices(distribution, count, count, seed);
+      M map;
+      timer.start();
+      for (size_t index : indices) {
+        map_insert(map, map_key(index), int(index));
+      }
+      timer.stop();
+      keep(map);
+      return count;
+    }});
+  }
+
+  for (Distribution distribution : distributions) {
+    cases.push_back({name, "lookup_hit", distribution_name(distribution), n, [n, seed, distribution](Timer& timer) {
+      M map = make_map<M>(n, seed);
+      std::vector<size_t> indices = make_indices(distribution, n, n, seed + 1);
+      long total = 0;
+      timer.start();
+      for (size_t index : indices) {
+        total += map_lookup(map, map_key(index));
+      }
+      timer.stop();
+      keep(total);
+      return n;
+    }});
+  }
+
+  cases.push_back({name, "lookup_miss", "uniform", n, [n, seed](Timer& timer) {
+    M map = make_map<M>(n, seed);
+    std::vector<size_t> indices = make_indices(Distribution::Uniform, n, n, seed + 1);
+    size_t found = 0;
+    timer.start();
+    for (size_t index : indices) {
+      found += map_contains(map, map_key(index) + 1);
+    }
+    timer.stop();
+    keep(found);
+    return n;
+  }});
+
+  for (Distribution distribution : distributions) {
+    cases.push_back({name, "remove", distribution_name(distribution), n, [n, seed, distribution](Timer& timer) {
+      M map = make_map<M>(n, seed);
+      std::vector<size_t> indices = make_indices(distribution, n, n, seed + 1);
+      timer.start();
+      for (size_t index : indices) {
+        map_remove(map, map_key(index));
+      }
+      timer.stop();
+      keep(map);
+      return n;
+    }});
+  }
+
+  cases.push_back({name, "iterate", "", n, [n, seed](Timer& timer) {
+    M map = make_map<M>(n, seed);
+    timer.start();
+    long total = map_sum(map);
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+
+  // 80% lookups, 10% inserts, 10% removals over the same key space
+  for (Distribution distribution : distributions) {
+    cases.push_back({name, "mixed", distribution_name(distribution), n, [n, seed, distribution](Timer& timer) {
+      M map = make_map<M>(n, seed);
+      std::vector<size_t> indices = make_indices(distribution, n, n, seed + 1);
+      std::mt19937_64 rng(seed + 2);
+      std::vector<unsigned> choices(n);
+      for (unsigned& choice : choices) {
+        choice = unsigned(rng() % 10);
+      }
+
+      size_t found = 0;
+      timer.start();
+      for (size_t i = 0; i < n; i++) {
+        int key = map_key(indices[i]);
+        if (choices[i] == 0) {
+          map_insert(map, key, int(i));
+        } else if (choices[i] == 1) {
+          map_remove(map, key);
+        } else {
+          found += map_contains(map, key);
+        }
+      }
+      timer.stop();
+      keep(found);
+      return n;
+    }});
+  }
+}
+
+#endif
@@ -0,0 +1,107 @@
+// ScanBenchmarks.hpp
+#ifndef SCANBENCHMARKS_H
+#define SCANBENCHMARKS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "linear/UnrolledLinkedList.hpp"
+#include "linear/Vector.hpp"
+
+// Number of full passes per scan benchmark, keeping the time well above the timer resolution
+constexpr int scan_passes = 16;
+
+// Returns the index of a value, or -1
+template <typename S>
+int search_find(const S& items, int value) { return items.find(value); }
+
+inline int search_find(const std::vector<int>& items, int value) {
+  auto found = std::find(items.begin(), items.end(), value);
+  return found == items.end() ? -1 : int(found - items.begin());
+}
+
+// Returns how many elements equal a value
+template <typename S>
+size_t search_count(const S& items, int value) { return items.count(value); }
+
+inline size_t search_count(const std::vector<int>& items, int value) { return std::count(items.begin(), items.end(), value); }
+
+// Returns the smallest element
+template <typename S>
+int search_min(const S& items) { return items.min(); }
+
+inline int search_min(const std::vector<int>& items) { return *std::min_element(items.begin(), items.end()); }
+
+// Returns the sum of every element
+template <typename S>
+int64_t search_sum(const S& items) { return items.sum(); }
+
+inline int64_t search_sum(const std::vector<int>& items) { return std::accumulate(items.begin(), items.end(), int64_t(0)); }
+
+// Returns how many elements are below a threshold, building the filtered container
+template <typename S>
+size_t search_filter(const S& items, int threshold) { return items.filter([threshold](int x) { return x < threshold; }).size(); }
+
+inline size_t search_filter(const std::vector<int>& items, int threshold) {
+  std::vector<int> kept;
+  std::copy_if(items.begin(), items.end(), std::back_inserter(kept), [threshold](int x) { return x < threshold; });
+  return kept.size();
+}
+
+// Returns a container of n values drawn uniformly from [0, n), so every value is non-negative
+template <typename S>
+S make_scan_items(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  S items;
+  for (size_t i = 0; i < n; i++) {
+    items.push_back(int(rng() % n));
+  }
+  return items;
+}
+
+// Vector grows by a fixed step, so it is filled with its capacity reserved
+template <>
+inline Vector<int> make_scan_items<Vector<int>>(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  Vector<int> items(n, 10);
+  for (size_t i = 0; i < n; i++) {
+    items.push_back(int(rng() % n));
+  }
+  return items;
+}
+
+// Registers the search and aggregate workloads of one container of ints
+template <typename S>
+void add_scan_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  // Runs one pass per query over a container built outside the timed region
+  auto add = [&](const std::string& workload, auto pass) {
+    cases.push_back({name, workload, "uniform", scan_passes * n, [n, seed, pass](Timer& timer) {
+      S items = make_scan_items<S>(n, seed);
+      int64_t total = 0;
+      timer.start();
+      for (int query = 0; query < scan_passes; query++) {
+        total += pass(items, query);
+      }
+      timer.stop();
+      keep(total);
+      return scan_passes * n;
+    }});
+  };
+
+  // Negative values never occur, so every find reads the whole container
+  add("find_miss", [](const S& items, int query) { return int64_t(search_find(items, -1 - query)); });
+  add("count", [](const S& items, int query) { return int64_t(search_count(items, query)); });
+  add("min", [](const S& items, int) { return int64_t(search_min(items)); });
+  add("sum", [](const S& items, int) { return search_sum(items); });
+  add("filter", [n](const S& items, int query) { return int64_t(search_filter(items, int(n / 16 * (query + 1)))); });
+}
+
+#endif
@@ -0,0 +1,373 @@
+// SequenceBenchmarks.hpp
+#ifndef SEQUENCEBENCHMARKS_H
+#define SEQUENCEBENCHMARKS_H
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <queue>
+#include <random>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "linear/DoublyLinkedList.hpp"
+#include "linear/LinkedList.hpp"
+#include "linear/Queue.hpp"
+#include "linear/Stack.hpp"
+#include "linear/UnrolledLinkedList.hpp"
+
+// Operations a sequence supports cheaply enough to benchmark at full size
+enum SequenceOps : unsigned {
+  PushFront = 1,                      // push_front
+  Indexed = 2,                        // O(1) operator[]
+  PopBack = 4,                        // pop_back
+  PopFront = 8,                       // pop_front
+  Insert = 16,                        // insert at an index
+  Erase = 32                          // erase_if, removing many elements in one pass
+};
+
+// Linear-time workloads only run this many operations so a full run stays short
+constexpr size_t linear_workload_cap = 20000;
+constexpr size_t linear_search_cap = 1000;
+
+// Inserts at an index, whatever the container's insert signature is
+template <typename S>
+void sequence_insert(S& sequence, size_t index, int value) { sequence.insert(int(index), value); }
+
+template <typename T>
+void sequence_insert(std::vector<T>& sequence, size_t index, int value) { sequence.insert(sequence.begin() + index, value); }
+
+template <typename T>
+void sequence_insert(std::deque<T>& sequence, size_t index, int value) { sequence.insert(sequence.begin() + index, value); }
+
+template <typename T>
+void sequence_insert(std::list<T>& sequence, size_t index, int value) {
+  auto position = sequence.begin();
+  std::advance(position, index);
+  sequence.insert(position, value);
+}
+
+// Removes every element matching a predicate, keeping the order of the rest
+template <typename S, typename Pred>
+size_t sequence_erase_if(S& sequence, Pred pred) { return sequence.erase_if(pred); }
+
+template <typename T, typename Pred>
+size_t sequence_erase_if(std::vector<T>& sequence, Pred pred) {
+  size_t before = sequence.size();
+  sequence.erase(std::remove_if(sequence.begin(), sequence.end(), pred), sequence.end());
+  return before - sequence.size();
+}
+
+template <typename T, typename Pred>
+size_t sequence_erase_if(std::deque<T>& sequence, Pred pred) {
+  size_t before = sequence.size();
+  sequence.erase(std::remove_if(sequence.begin(), sequence.end(), pred), sequence.end());
+  return before - sequence.size();
+}
+
+// Sums every element through the container's iterator
+template <typename S>
+long sequence_sum(S& sequence) {
+  long total = 0;
+  for (auto it = sequence.begin(); it != sequence.end(); ++it) {
+    total += *it;
+  }
+  return total;
+}
+
+template <typename T>
+long sequence_sum(DoublyLinkedList<T>& sequence) {
+  long total = 0;
+  for (auto it = sequence.begin_head(); it != sequence.end(); ++it) {
+    total += *it;
+  }
+  return total;
+}
+
+// Linear search, through the container's own search when it has one
+template <typename S>
+bool sequence_contains(S& sequence, int value) {
+  for (auto it = sequence.begin(); it != sequence.end(); ++it) {
+    if (*it == value) return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool sequence_contains(DoublyLinkedList<T>& sequence, int value) {
+  for (auto it = sequence.begin_head(); it != sequence.end(); ++it) {
+    if (*it == value) return true;
+  }
+  return false;
+}
+
+template <typename T>
+bool sequence_contains(LinkedList<T>& sequence, int value) { return sequence.contains(value); }
+
+template <typename T, size_t N>
+bool sequence_contains(UnrolledLinkedList<T, N>& sequence, int value) { return sequence.contains(value); }
+
+// Returns a sequence holding 0, 2, 4, ... so odd values are guaranteed misses
+template <typename S>
+S make_sequence(size_t n) {
+  S sequence;
+  for (size_t i = 0; i < n; i++) {
+    sequence.push_back(int(2 * i));
+  }
+  return sequence;
+}
+
+// Registers the sequence workloads of one container
+template <typename S, unsigned Ops>
+void add_sequence_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+  const Distribution distributions[] = {Distribution::Uniform, Distribution::Zipfian, Distribution::Sorted};
+
+  cases.push_back({name, "push_back", "", n, [n](Timer& timer) {
+    S sequence;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      sequence.push_back(int(i));
+    }
+    timer.stop();
+    keep(sequence);
+    return n;
+  }});
+
+  if constexpr ((Ops & PushFront) != 0) {
+    cases.push_back({name, "push_front", "", n, [n](Timer& timer) {
+      S sequence;
+      timer.start();
+      for (size_t i = 0; i < n; i++) {
+        sequence.push_front(int(i));
+      }
+      timer.stop();
+      keep(sequence);
+      return n;
+    }});
+  }
+
+  if constexpr ((Ops & Insert) != 0) {
+    size_t inserts = std::min(n, linear_workload_cap);
+    cases.push_back({name, "insert_random", "uniform", inserts, [inserts, seed](Timer& timer) {
+      std::mt19937_64 rng(seed);
+      std::vector<size_t> positions(inserts);
+      for (size_t i = 0; i < inserts; i++) {
+        positions[i] = std::uniform_int_distribution<size_t>(0, i)(rng);
+      }
+
+      S sequence;
+      timer.start();
+      for (size_t i = 0; i < inserts; i++) {
+        sequence_insert(sequence, positions[i], int(i));
+      }
+      timer.stop();
+      keep(sequence);
+      return inserts;
+    }});
+  }
+
+  // A filtering pass dropping every third element
+  if constexpr ((Ops & Erase) != 0) {
+    cases.push_back({name, "erase_if", "", n, [n](Timer& timer) {
+      S sequence = make_sequence<S>(n);
+      timer.start();
+      size_t removed = sequence_erase_if(sequence, [](int value) { return value % 3 == 0; });
+      timer.stop();
+      keep(removed);
+      return n;
+    }});
+  }
+
+  cases.push_back({name, "iterate", "", n, [n](Timer& timer) {
+    S sequence = make_sequence<S>(n);
+    timer.start();
+    long total = sequence_sum(sequence);
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+
+  size_t searches = std::min(n, linear_search_cap);
+  for (Distribution distribution : distributions) {
+    cases.push_back({name, "find_hit", distribution_name(distribution), n, [n, searches, seed, distribution](Timer& timer) {
+      S sequence = make_sequence<S>(n);
+      std::vector<size_t> indices = make_indices(distribution, searches, n, seed);
+      size_t found = 0;
+      timer.start();
+      for (size_t index : indices) {
+        found += sequence_contains(sequence, int(2 * index));
+      }
+      timer.stop();
+      keep(found);
+      return searches;
+    }});
+  }
+
+  cases.push_back({name, "find_miss", "uniform", n, [n, searches, seed](Timer& timer) {
+    S sequence = make_sequence<S>(n);
+    std::vector<size_t> indices = make_indices(Distribution::Uniform, searches, n, seed);
+    size_t found = 0;
+    timer.start();
+    for (size_t index : indices) {
+      found += sequence_contains(sequence, int(2 * index + 1));
+    }
+    timer.stop();
+    keep(found);
+    return searches;
+  }});
+
+  if constexpr ((Ops & Indexed) != 0) {
+    for (Distribution distribution : distributions) {
+      cases.push_back({name, "random_access", distribution_name(distribution), n, [n, seed, distribution](Timer& timer) {
+        S sequence = make_sequence<S>(n);
+        std::vector<size_t> indices = make_indices(distribution, n, n, seed);
+        long total = 0;
+        timer.start();
+        for (size_t index : indices) {
+          total += sequence[int(index)];
+        }
+        timer.stop();
+        keep(total);
+        return n;
+      }});
+    }
+
+    // 80% reads, 10% appends, 10% removals from the back (never below the half being read)
+    if constexpr ((Ops & PopBack) != 0) {
+      for (Distribution distribution : distributions) {
+        cases.push_back({name, "mixed", distribution_name(distribution), n, [n, seed, distribution](Timer& timer) {
+          S sequence = make_sequence<S>(n);
+          std::vector<size_t> indices = make_indices(distribution, n, n / 2, seed);
+          std::mt19937_64 rng(seed + 1);
+          std::vector<unsigned> choices(n);
+          for (unsigned& choice : choices) {
+            choice = unsigned(rng() % 10);
+          }
+
+          long total = 0;
+          timer.start();
+          for (size_t i = 0; i < n; i++) {
+            if (choices[i] == 0) {
+              sequence.push_back(int(i));
+            } else if (choices[i] == 1 && sequence.size() > n / 2) {
+              sequence.pop_back();
+            } else {
+              total += sequence[int(indices[i])];
+            }
+          }
+          timer.stop();
+          keep(total);
+          return n;
+        }});
+      }
+    }
+  }
+
+  if constexpr ((Ops & PopBack) != 0) {
+    cases.push_back({name, "pop_back", "", n, [n](Timer& timer) {
+      S sequence = make_sequence<S>(n);
+      timer.start();
+      for (size_t i = 0; i < n; i++) {
+        sequence.pop_back();
+      }
+      timer.stop();
+      keep(sequence);
+      return n;
+    }});
+  }
+
+  if constexpr ((Ops & PopFront) != 0) {
+    cases.push_back({name, "pop_front", "", n, [n](Timer& timer) {
+      S sequence = make_sequence<S>(n);
+      timer.start();
+      for (size_t i = 0; i < n; i++) {
+        sequence.pop_front();
+      }
+      timer.stop();
+      keep(sequence);
+      return n;
+    }});
+  }
+}
+
+// Reads the element a stack or queue would remove next
+template <typename T, typename C>
+T& adapter_next(Stack<T, C>& stack) { return stack.top(); }
+
+template <typename T, typename C>
+T& adapter_next(Queue<T, C>& queue) { return queue.front(); }
+
+template <typename T, typename C>
+T& adapter_next(std::stack<T, C>& stack) { return stack.top(); }
+
+template <typename T, typename C>
+T& adapter_next(std::queue<T, C>& queue) { return queue.front(); }
+
+// Registers the push/pop workloads of a stack or queue
+template <typename A>
+void add_adapter_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  cases.push_back({name, "push", "", n, [n](Timer& timer) {
+    A adapter;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      adapter.push(int(i));
+    }
+    timer.stop();
+    keep(adapter);
+    return n;
+  }});
+
+  cases.push_back({name, "pop", "", n, [n](Timer& timer) {
+    A adapter;
+    for (size_t i = 0; i < n; i++) {
+      adapter.push(int(i));
+    }
+
+    long total = 0;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      total += adapter_next(adapter);
+      adapter.pop();
+    }
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+
+  // Pushes and pops in random order around a resident half
+  cases.push_back({name, "mixed", "uniform", n, [n, seed](Timer& timer) {
+    A adapter;
+    for (size_t i = 0; i < n / 2; i++) {
+      adapter.push(int(i));
+    }
+    std::mt19937_64 rng(seed);
+    std::vector<bool> pushes(n);
+    for (size_t i = 0; i < n; i++) {
+      pushes[i] = (rng() & 1) != 0;
+    }
+
+    long total = 0;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      if (pushes[i] || adapter.empty()) {
+        adapter.push(int(i));
+      } else {
+        total += adapter_next(adapter);
+        adapter.pop();
+      }
+    }
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+}
+
+#endif
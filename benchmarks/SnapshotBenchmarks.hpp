@@ -0,0 +1,83 @@
+// SnapshotBenchmarks.hpp
+#ifndef SNAPSHOTBENCHMARKS_H
+#define SNAPSHOTBENCHMARKS_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "linear/SnapshotVector.hpp"
+#include "linear/Vector.hpp"
+
+// Number of snapshots taken per benchmark
+constexpr int snapshot_rounds = 64;
+
+// Number of elements the writer changes between two snapshots
+constexpr int snapshot_writes = 16;
+
+// Returns a container of the values 0 to n - 1
+template <typename S>
+S make_snapshot_items(size_t n) {
+  S items;
+  for (size_t i = 0; i < n; i++) {
+    items.push_back(int(i));
+  }
+  return items;
+}
+
+// Vector grows by a fixed step, so it is filled with its capacity reserved
+template <>
+inline Vector<int> make_snapshot_items<Vector<int>>(size_t n) {
+  Vector<int> items(n, 10);
+  for (size_t i = 0; i < n; i++) {
+    items.push_back(int(i));
+  }
+  return items;
+}
+
+// Registers the snapshot workloads of one vector of ints, where copying is how a reader gets its own version
+template <typename S>
+void add_snapshot_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  // A writer hands out a copy, then changes a few random elements; the readers' copies must not see the changes
+  cases.push_back({name, "snapshot_write", "uniform", snapshot_rounds, [n, seed](Timer& timer) {
+    S items = make_snapshot_items<S>(n);
+    std::mt19937_64 rng(seed);
+    std::vector<S> readers;
+    readers.reserve(snapshot_rounds);
+
+    timer.start();
+    for (int round = 0; round < snapshot_rounds; round++) {
+      readers.push_back(items);
+      for (int write = 0; write < snapshot_writes; write++) {
+        items[int(rng() % n)] = round;
+      }
+    }
+    timer.stop();
+    keep(readers);
+    return size_t(snapshot_rounds);
+  }});
+
+  // Reading a snapshot costs a chunk lookup per element where a flat vector has none
+  cases.push_back({name, "iterate", "sequential", 16 * n, [n](Timer& timer) {
+    S items = make_snapshot_items<S>(n);
+    const S snapshot = items;
+    int64_t total = 0;
+
+    timer.start();
+    for (int pass = 0; pass < 16; pass++) {
+      for (int value : snapshot) {
+        total += value;
+      }
+    }
+    timer.stop();
+    keep(total);
+    return 16 * n;
+  }});
+}
+
+#endif
@@ -0,0 +1,139 @@
+// StringMapBenchmarks.hpp
+#ifndef STRINGMAPBENCHMARKS_H
+#define STRINGMAPBENCHMARKS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "trees/AVLTree.hpp"
+#include "trees/RadixTree.hpp"
+
+// Number of services the generated metric names are spread over
+constexpr size_t string_map_services = 97;
+
+// Metric names sharing long prefixes, e.g. "metrics/service-12/host-345/cpu.6789"
+inline std::string string_map_key(size_t index) {
+  return "metrics/service-" + std::to_string(index % string_map_services) + "/host-" +
+         std::to_string(index / string_map_services % 1000) + "/cpu." + std::to_string(index);
+}
+
+// Prefix holding every key of one service
+inline std::string string_map_prefix(size_t service) {
+  return "metrics/service-" + std::to_string(service) + "/";
+}
+
+// Returns the value of a key known to be present
+template <typename M>
+int string_map_lookup(M& map, const std::string& key) { return map.search(key); }
+
+template <typename V>
+int string_map_lookup(std::map<std::string, V>& map, const std::string& key) { return map.find(key)->second; }
+
+// Returns if a key is present
+template <typename M>
+bool string_map_contains(M& map, const std::string& key) { return map.contains(key); }
+
+template <typename V>
+bool string_map_contains(std::map<std::string, V>& map, const std::string& key) { return map.find(key) != map.end(); }
+
+// Counts the keys starting with a prefix
+template <typename V>
+size_t string_map_count_prefix(RadixTree<V>& map, const std::string& prefix) { return map.count_prefix(prefix); }
+
+template <typename V>
+size_t string_map_count_prefix(std::map<std::string, V>& map, const std::string& prefix) {
+  size_t count = 0;
+  for (auto it = map.lower_bound(prefix); it != map.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+    count++;
+  }
+  return count;
+}
+
+// Returns the keys of [0, n) in random order
+inline std::vector<std::string> make_string_keys(size_t n, uint64_t seed) {
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (size_t index : make_permutation(n, seed)) {
+    keys.push_back(string_map_key(index));
+  }
+  return keys;
+}
+
+// Returns a map holding the keys of [0, n) inserted in random order
+template <typename M>
+M make_string_map(size_t n, uint64_t seed) {
+  M map;
+  std::vector<std::string> keys = make_string_keys(n, seed);
+  for (size_t i = 0; i < n; i++) {
+    map.try_emplace(keys[i], int(i));
+  }
+  return map;
+}
+
+// Registers the string-keyed map workloads of one container
+// Prefix scans are registered only for containers that can visit a key range without a full traversal
+template <typename M, bool PrefixScans = false>
+void add_string_map_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  cases.push_back({name, "string_insert", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<std::string> keys = make_string_keys(n, seed);
+    M map;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      map.try_emplace(keys[i], int(i));
+    }
+    timer.stop();
+    keep(map);
+    return n;
+  }});
+
+  cases.push_back({name, "string_lookup_hit", "uniform", n, [n, seed](Timer& timer) {
+    M map = make_string_map<M>(n, seed);
+    std::vector<std::string> keys = make_string_keys(n, seed + 1);
+    long total = 0;
+    timer.start();
+    for (const std::string& key : keys) {
+      total += string_map_lookup(map, key);
+    }
+    timer.stop();
+    keep(total);
+    return n;
+  }});
+
+  // Misses share all but the last byte with a stored key
+  cases.push_back({name, "string_lookup_miss", "uniform", n, [n, seed](Timer& timer) {
+    M map = make_string_map<M>(n, seed);
+    std::vector<std::string> keys = make_string_keys(n, seed + 1);
+    for (std::string& key : keys) {
+      key.back() = 'x';
+    }
+    size_t found = 0;
+    timer.start();
+    for (const std::string& key : keys) {
+      found += string_map_contains(map, key);
+    }
+    timer.stop();
+    keep(found);
+    return n;
+  }});
+
+  if constexpr (PrefixScans) {
+    cases.push_back({name, "prefix_scan", "uniform", n, [n, seed](Timer& timer) {
+      M map = make_string_map<M>(n, seed);
+      size_t visited = 0;
+      timer.start();
+      for (size_t service = 0; service < string_map_services; service++) {
+        visited += string_map_count_prefix(map, string_map_prefix(service));
+      }
+      timer.stop();
+      keep(visited);
+      return visited;
+    }});
+  }
+}
+
+#endif
@@ -0,0 +1,153 @@
+// TimerBenchmarks.hpp
+#ifndef TIMERBENCHMARKS_H
+#define TIMERBENCHMARKS_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "timers/TimingWheel.hpp"
+#include "trees/AVLTree.hpp"
+
+// Timeouts are drawn from [0, timer_timeout) clock units (e.g. milliseconds) after the current time
+constexpr uint64_t timer_timeout = 30000;
+
+// Timers kept in an AVLTree ordered by deadline, the id breaking ties
+using TimerTree = AVLTree<std::pair<uint64_t, uint32_t>, uint32_t>;
+
+// Schedules a timer, returning what cancelling or rearming it needs
+template <typename W>
+auto timer_schedule(W& timers, uint64_t deadline, uint32_t id) { return timers.schedule(deadline, id); }
+
+inline std::pair<uint64_t, uint32_t> timer_schedule(TimerTree& timers, uint64_t deadline, uint32_t id) {
+  timers.insert(std::make_pair(deadline, id), id);
+  return std::make_pair(deadline, id);
+}
+
+// Cancels a scheduled timer
+template <typename W, typename Handle>
+void timer_cancel(W& timers, Handle& handle) { timers.cancel(handle); }
+
+inline void timer_cancel(TimerTree& timers, std::pair<uint64_t, uint32_t>& handle) { timers.remove(handle); }
+
+// Moves a scheduled timer to a new deadline
+template <typename W, typename Handle>
+void timer_rearm(W& timers, Handle& handle, uint64_t deadline) { timers.reschedule(handle, deadline); }
+
+inline void timer_rearm(TimerTree& timers, std::pair<uint64_t, uint32_t>& handle, uint64_t deadline) {
+  timers.remove(handle);
+  handle.first = deadline;
+  timers.insert(handle, handle.second);
+}
+
+// Fires every timer due by a time, returning how many fired
+template <typename W>
+size_t timer_advance(W& timers, uint64_t now) {
+  return timers.advance(now, [](uint32_t& id) { keep(id); });
+}
+
+inline size_t timer_advance(TimerTree& timers, uint64_t now) {
+  size_t fired = 0;
+  while (!timers.empty()) {
+    std::pair<uint64_t, uint32_t> first = timers.begin().get_key();
+    if (first.first > now) break;
+
+    timers.remove(first);
+    fired++;
+  }
+  return fired;
+}
+
+// Returns n deadlines spread uniformly over one timeout
+inline std::vector<uint64_t> make_deadlines(size_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint64_t> deadlines(n);
+  for (uint64_t& deadline : deadlines) {
+    deadline = 1 + rng() % timer_timeout;
+  }
+  return deadlines;
+}
+
+// Registers the timer workloads of one container
+template <typename W>
+void add_timer_benchmarks(std::vector<BenchmarkCase>& cases, const std::string& name, const BenchmarkOptions& options) {
+  const size_t n = options.size;
+  const uint64_t seed = options.seed;
+
+  cases.push_back({name, "schedule", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<uint64_t> deadlines = make_deadlines(n, seed);
+    W timers;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      timer_schedule(timers, deadlines[i], uint32_t(i));
+    }
+    timer.stop();
+    keep(timers);
+    return n;
+  }});
+
+  // Most connections close before their timeout, so most timers are cancelled rather than fired
+  cases.push_back({name, "cancel", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<uint64_t> deadlines = make_deadlines(n, seed);
+    std::vector<size_t> order = make_permutation(n, seed + 1);
+    W timers;
+    std::vector<decltype(timer_schedule(timers, 0, 0))> handles;
+    handles.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      handles.push_back(timer_schedule(timers, deadlines[i], uint32_t(i)));
+    }
+
+    timer.start();
+    for (size_t i : order) {
+      timer_cancel(timers, handles[i]);
+    }
+    timer.stop();
+    keep(timers);
+    return n;
+  }});
+
+  // The clock moves one unit at a time until every timer has fired
+  cases.push_back({name, "expire", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<uint64_t> deadlines = make_deadlines(n, seed);
+    W timers;
+    for (size_t i = 0; i < n; i++) {
+      timer_schedule(timers, deadlines[i], uint32_t(i));
+    }
+
+    size_t fired = 0;
+    timer.start();
+    for (uint64_t now = 1; now <= timer_timeout; now++) {
+      fired += timer_advance(timers, now);
+    }
+    timer.stop();
+    keep(fired);
+    return n;
+  }});
+
+  // Keepalive traffic: each operation pushes one connection's timeout back, the clock ticking every 16 operations
+  cases.push_back({name, "rearm", "uniform", n, [n, seed](Timer& timer) {
+    std::vector<uint64_t> deadlines = make_deadlines(n, seed);
+    std::vector<size_t> connections = make_indices(Distribution::Uniform, n, n, seed + 1);
+    W timers;
+    std::vector<decltype(timer_schedule(timers, 0, 0))> handles;
+    handles.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+      handles.push_back(timer_schedule(timers, timer_timeout + deadlines[i], uint32_t(i)));
+    }
+
+    uint64_t now = 0;
+    timer.start();
+    for (size_t i = 0; i < n; i++) {
+      timer_rearm(timers, handles[connections[i]], now + 2 * timer_timeout);
+      if (i % 16 == 15) timer_advance(timers, ++now);
+    }
+    timer.stop();
+    keep(timers);
+    return n;
+  }});
+}
+
+#endif
@@ -0,0 +1,150 @@
+// main.cpp
+// Benchmarks every container against its standard library counterpart
+//
+// Usage: cpp_toolkit_bench [--size N] [--seed S] [--repeat R] [--filter TEXT] [--json FILE|-] [--no-isolate] [--list]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <queue>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "HeapBenchmarks.hpp"
+#include "LayoutBenchmarks.hpp"
+#include "MapBenchmarks.hpp"
+#include "ScanBenchmarks.hpp"
+#include "SequenceBenchmarks.hpp"
+#include "SnapshotBenchmarks.hpp"
+#include "StringMapBenchmarks.hpp"
+#include "TimerBenchmarks.hpp"
+#include "linear/Deque.hpp"
+#include "linear/SmallVector.hpp"
+#include "linear/Vector.hpp"
+
+// Degenerate BSTs make sorted inserts quadratic, so that workload is capped
+constexpr size_t bst_sorted_cap = 10000;
+
+static void usage(const char* program) {
+  std::fprintf(stderr,
+    "Usage: %s [options]\n"
+    "  --size N        elements per workload (default 100000)\n"
+    "  --seed S        seed of every generated workload (default 42)\n"
+    "  --repeat R      repetitions per benchmark, the median is reported (default 3)\n"
+    "  --filter TEXT   only run benchmarks whose name contains TEXT\n"
+    "  --json FILE     also write the results as JSON, - for stdout\n"
+    "  --no-isolate    run in one process (peak RSS then covers everything run so far)\n"
+    "  --list          list the benchmark names and exit\n", program);
+}
+
+static bool parse_options(int argc, char** argv, BenchmarkOptions& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string flag = argv[i];
+    bool has_value = i + 1 < argc;
+
+    if (flag == "--size" && has_value) {
+      options.size = std::strtoull(argv[++i], nullptr, 10);
+    } else if (flag == "--seed" && has_value) {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (flag == "--repeat" && has_value) {
+      options.repeat = std::atoi(argv[++i]);
+    } else if (flag == "--filter" && has_value) {
+      options.filter = argv[++i];
+    } else if (flag == "--json" && has_value) {
+      options.json = argv[++i];
+    } else if (flag == "--no-isolate") {
+      options.isolate = false;
+    } else if (flag == "--list") {
+      options.list = true;
+    } else {
+      return false;
+    }
+  }
+
+  // Keys are stored as 2 * index in an int
+  return options.size >= 16 && options.size <= 1000000000 && options.repeat >= 1;
+}
+
+int main(int argc, char** argv) {
+  BenchmarkOptions options;
+  if (!parse_options(argc, argv, options)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<BenchmarkCase> cases;
+
+  add_sequence_benchmarks<Vector<int>, Indexed | PopBack | Insert | Erase>(cases, "Vector", options);
+  add_sequence_benchmarks<std::vector<int>, Indexed | PopBack | Insert | Erase>(cases, "std::vector", options);
+  add_sequence_benchmarks<SmallVector<int, 16>, Indexed | PopBack | Insert>(cases, "SmallVector", options);
+  add_layout_benchmarks<TradeRows>(cases, "Vector<TradeRecord>", options);
+  add_layout_benchmarks<TradeColumns>(cases, "SoAVector", options);
+  add_snapshot_benchmarks<SnapshotVector<int>>(cases, "SnapshotVector", options);
+  add_snapshot_benchmarks<Vector<int>>(cases, "Vector", options);
+  add_snapshot_benchmarks<std::vector<int>>(cases, "std::vector", options);
+
+  add_scan_benchmarks<Vector<int>>(cases, "Vector", options);
+  add_scan_benchmarks<std::vector<int>>(cases, "std::vector", options);
+  add_scan_benchmarks<UnrolledLinkedList<int>>(cases, "UnrolledLinkedList", options);
+
+  add_sequence_benchmarks<Deque<int>, PushFront | Indexed | PopBack | PopFront>(cases, "Deque", options);
+  add_sequence_benchmarks<std::deque<int>, PushFront | Indexed | PopBack | PopFront | Insert | Erase>(cases, "std::deque", options);
+  add_sequence_benchmarks<LinkedList<int>, PushFront | PopFront | Insert>(cases, "LinkedList", options);
+  add_sequence_benchmarks<DoublyLinkedList<int>, PushFront | PopBack | PopFront | Insert>(cases, "DoublyLinkedList", options);
+  add_sequence_benchmarks<UnrolledLinkedList<int>, PushFront | PopBack | PopFront | Insert>(cases, "UnrolledLinkedList", options);
+  add_sequence_benchmarks<std::list<int>, PushFront | PopBack | PopFront | Insert>(cases, "std::list", options);
+
+  add_adapter_benchmarks<Stack<int>>(cases, "Stack", options);
+  add_adapter_benchmarks<std::stack<int>>(cases, "std::stack", options);
+  add_adapter_benchmarks<Queue<int>>(cases, "Queue", options);
+  add_adapter_benchmarks<std::queue<int>>(cases, "std::queue", options);
+
+  add_map_benchmarks<BST<int, int>>(cases, "BST", options, bst_sorted_cap);
+  add_map_benchmarks<AVLTree<int, int>>(cases, "AVLTree", options);
+  add_map_benchmarks<FilteredTree<int, int>>(cases, "FilteredTree", options);
+  add_map_benchmarks<PersistentAVLTree<int, int>>(cases, "PersistentAVLTree", options);
+  add_map_benchmarks<std::map<int, int>>(cases, "std::map", options);
+
+  add_string_map_benchmarks<AVLTree<std::string, int>>(cases, "AVLTree", options);
+  add_string_map_benchmarks<RadixTree<int>, true>(cases, "RadixTree", options);
+  add_string_map_benchmarks<std::map<std::string, int>, true>(cases, "std::map", options);
+
+  add_heap_benchmarks<DaryHeap<int>>(cases, "DaryHeap", options);
+  add_heap_benchmarks<PairingHeap<int>>(cases, "PairingHeap", options);
+  add_heap_benchmarks<AVLTree<int, int>>(cases, "AVLTree", options);
+  add_heap_benchmarks<StdMinHeap, false>(cases, "std::priority_queue", options);
+
+  add_timer_benchmarks<TimingWheel<uint32_t>>(cases, "TimingWheel", options);
+  add_timer_benchmarks<TimerTree>(cases, "AVLTree", options);
+
+  if (options.list) {
+    for (const BenchmarkCase& benchmark : cases) {
+      if (options.filter.empty() || benchmark.name().find(options.filter) != std::string::npos) {
+        std::printf("%s\n", benchmark.name().c_str());
+      }
+    }
+    return 0;
+  }
+
+  std::vector<BenchmarkResult> results = run_benchmarks(cases, options);
+
+  if (!options.json.empty()) {
+    std::FILE* out = options.json == "-" ? stdout : std::fopen(options.json.c_str(), "w");
+    if (out == nullptr) {
+      std::fprintf(stderr, "Could not open %s for writing!\n", options.json.c_str());
+      return 1;
+    }
+    write_json(out, options, results);
+    if (out != stdout) std::fclose(out);
+  }
+
+  for (const BenchmarkResult& result : results) {
+    if (!result.ok) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,160 @@
+// BloomFilter.hpp
+#ifndef BLOOMFILTER_H
+#define BLOOMFILTER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../linear/Vector.hpp"
+#include "../memory/MemoryUsage.hpp"
+
+// Struct hashing the bytes of a trivially copyable key with a fixed function, for filters that are saved to disk
+// std::hash may differ between standard libraries and builds, which would make a reloaded filter check the wrong bits
+// Keys must have no padding, so equal keys have equal bytes; floating point zeros are folded so -0.0 matches 0.0
+template <typename Key>
+struct BloomByteHash {
+  static_assert(std::is_trivially_copyable<Key>::value && (std::has_unique_object_representations<Key>::value || std::is_floating_point<Key>::value),
+                "BloomByteHash needs keys whose bytes are equal exactly when the keys are");
+
+  // Identifies this hash together with the probe layout of BloomFilter; change it whenever either changes
+  static constexpr uint64_t tag = 0x424c4f4f4d480001ULL;
+
+  size_t operator()(const Key& key) const {
+    Key folded = key;
+    if constexpr (std::is_floating_point<Key>::value) {
+      if (folded == Key(0)) folded = Key(0);
+    }
+
+    unsigned char bytes[sizeof(Key)];
+    std::memcpy(bytes, &folded, sizeof(Key));
+
+    uint64_t hashed = 0x9e3779b97f4a7c15ULL ^ uint64_t(sizeof(Key));
+    for (size_t offset = 0; offset < sizeof(Key); offset += 8) {
+      uint64_t word = 0;
+      std::memcpy(&word, bytes + offset, std::min<size_t>(8, sizeof(Key) - offset));
+      hashed = (hashed ^ word) * 0xff51afd7ed558ccdULL;
+      hashed ^= hashed >> 32;
+    }
+    return size_t(hashed);
+  }
+};
+
+// Class representing a blocked Bloom filter
+// Every key sets all of its bits inside one 512 bit block, so a query touches a single cache line
+template <typename Key, typename Hash = std::hash<Key>>
+class BloomFilter {
+private:
+  static constexpr size_t block_words = 8;      // 64 bit words per 512 bit block
+
+  Vector<uint64_t> words;             // Bit array, block_words words per block
+  size_t blocks;                      // Number of blocks
+  int hashes;                         // Bits set per key
+  Hash hash;                          // Hash function for the keys
+
+  // Private helper functions
+  static uint64_t mix(uint64_t);                                            // Scrambles a hash so weak hashes (e.g. identity) spread evenly
+  template <typename Fn>
+  void probe(const Key&, Fn) const;                                         // Calls fn(word, mask) for every bit of a key
+public:
+  // Constructors
+  BloomFilter(size_t expected = 1024, double bits_per_key = 10);            // Sized for the expected number of keys (10 bits per key gives about 1% false positives)
+  BloomFilter(Vector<uint64_t>, int);                                       // Adopts bits saved from data() with the given hash count
+
+  // Accessors
+  const bool possibly_contains(const Key&) const;                           // Returns false only if the key was never inserted
+  const int hash_count() const { return hashes; }                           // Returns the number of bits set per key
+  const size_t bit_count() const { return blocks * block_words * 64; }      // Returns the size of the bit array
+  const Vector<uint64_t>& data() const { return words; }                    // Returns the bit array, for saving
+  const MemoryUsage memory_usage() const;                                   // Returns the bytes held by the filter, broken down
+
+  // Mutators
+  void insert(const Key&);                                                  // Adds a key to the filter
+  void clear();                                                             // Removes every key
+};
+
+// Function definitions
+template <typename Key, typename Hash>
+BloomFilter<Key, Hash>::BloomFilter(size_t expected, double bits_per_key) : words(), blocks(0), hashes(0) {
+  if (bits_per_key < 1) bits_per_key = 1;
+
+  double bits = std::ceil(double(expected == 0 ? 1 : expected) * bits_per_key);
+  blocks = std::max<size_t>(1, size_t(std::ceil(bits / (block_words * 64))));
+  hashes = std::max(1, std::min(16, int(std::lround(bits_per_key * 0.693))));
+
+  words = Vector<uint64_t>(blocks * block_words, block_words);
+  for (size_t i = 0; i < blocks * block_words; i++) {
+    words.push_back(0);
+  }
+}
+
+template <typename Key, typename Hash>
+BloomFilter<Key, Hash>::BloomFilter(Vector<uint64_t> bits, int hashes) : words(std::move(bits)), blocks(0), hashes(hashes) {
+  if (words.size() == 0 || words.size() % block_words != 0 || hashes < 1) {
+    throw std::invalid_argument("Bloom filter bits must fill whole blocks!");
+  }
+  blocks = words.size() / block_words;
+}
+
+template <typename Key, typename Hash>
+uint64_t BloomFilter<Key, Hash>::mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+template <typename Key, typename Hash>
+template <typename Fn>
+void BloomFilter<Key, Hash>::probe(const Key& key, Fn fn) const {
+  uint64_t hashed = mix(uint64_t(hash(key)));
+  size_t block = size_t(hashed % blocks) * block_words;
+
+  // Each 9 bit slice of a rehash picks one bit of the block, seven slices per rehash
+  uint64_t bits = mix(hashed ^ 0x9e3779b97f4a7c15ULL);
+  for (int i = 0; i < hashes; i++) {
+    if (i > 0 && i % 7 == 0) bits = mix(hashed + uint64_t(i));
+
+    size_t bit = bits & 511;
+    bits >>= 9;
+    fn(block + bit / 64, uint64_t(1) << (bit % 64));
+  }
+}
+
+template <typename Key, typename Hash>
+const bool BloomFilter<Key, Hash>::possibly_contains(const Key& key) const {
+  const uint64_t* bits = words.data();
+  bool present = true;
+  probe(key, [&](size_t word, uint64_t mask) { present = present && (bits[word] & mask) != 0; });
+  return present;
+}
+
+template <typename Key, typename Hash>
+const MemoryUsage BloomFilter<Key, Hash>::memory_usage() const {
+  MemoryUsage usage = words.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(words);
+  return usage;
+}
+
+template <typename Key, typename Hash>
+void BloomFilter<Key, Hash>::insert(const Key& key) {
+  uint64_t* bits = words.data();
+  probe(key, [&](size_t word, uint64_t mask) { bits[word] |= mask; });
+}
+
+template <typename Key, typename Hash>
+void BloomFilter<Key, Hash>::clear() {
+  uint64_t* bits = words.data();
+  for (size_t i = 0; i < words.size(); i++) {
+    bits[i] = 0;
+  }
+}
+
+#endif
@@ -0,0 +1,208 @@
+// CuckooFilter.hpp
+#ifndef CUCKOOFILTER_H
+#define CUCKOOFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+#include "../linear/Vector.hpp"
+#include "../memory/MemoryUsage.hpp"
+
+// Class representing a cuckoo filter: an approximate set that, unlike BloomFilter, supports removal
+// Every key leaves a 16 bit fingerprint in one of two 4-slot buckets, so a query reads at most two 64 bit words
+// False positives run at about 0.01%; removing a key that was never inserted may remove another key's fingerprint
+template <typename Key, typename Hash = std::hash<Key>>
+class CuckooFilter {
+private:
+  static constexpr uint64_t lane_ones = 0x0001000100010001ULL;   // The low bit of every 16 bit slot
+  static constexpr uint64_t lane_highs = 0x8000800080008000ULL;  // The high bit of every 16 bit slot
+  static constexpr int max_kicks = 500;                          // Evictions tried before an insert gives up
+
+  Vector<uint64_t> buckets;           // Four 16 bit fingerprints per bucket, 0 marking a free slot
+  size_t mask;                        // Number of buckets - 1 (a power of two)
+  size_t stored;                      // Number of fingerprints held
+  uint64_t random;                    // State of the generator picking which slot to evict
+  Hash hash;                          // Hash function for the keys
+
+  // Private helper functions
+  static uint64_t mix(uint64_t);                                            // Scrambles a hash so weak hashes (e.g. identity) spread evenly
+  static const bool has_slot(uint64_t, uint16_t);                           // Returns if a bucket holds a fingerprint (0 for a free slot)
+  static const int slot_of(uint64_t, uint16_t);                             // Returns the first slot of a bucket holding a fingerprint, or -1
+  void locate(const Key&, uint16_t&, size_t&, size_t&) const;               // Computes a key's fingerprint and its two buckets
+  const size_t alternate(size_t, uint16_t) const;                           // Returns the other bucket of a fingerprint
+  static void set_slot(uint64_t&, int, uint16_t);                           // Writes a fingerprint into a slot
+public:
+  // Constructor
+  CuckooFilter(size_t expected = 1024);                                     // Sized so the expected number of keys fills at most 95% of the slots
+
+  // Accessors
+  const bool possibly_contains(const Key&) const;                           // Returns false only if the key is not in the filter
+  const size_t size() const { return stored; }                              // Returns the number of keys held
+  const size_t capacity() const { return 4 * (mask + 1); }                  // Returns the number of slots
+  const MemoryUsage memory_usage() const;                                   // Returns the bytes held by the filter, broken down
+
+  // Mutators
+  bool insert(const Key&);                                                  // Adds a key, returning false (filter unchanged) when it is too full
+  bool remove(const Key&);                                                  // Removes one copy of a key's fingerprint, returning if one was found
+  void clear();                                                             // Removes every key
+};
+
+// Function definitions
+template <typename Key, typename Hash>
+CuckooFilter<Key, Hash>::CuckooFilter(size_t expected) : buckets(), mask(0), stored(0), random(0x9e3779b97f4a7c15ULL) {
+  size_t wanted = (expected + expected / 19 + 3) / 4;
+  size_t count = 1;
+  while (count < wanted) count *= 2;
+  mask = count - 1;
+
+  buckets = Vector<uint64_t>(count, count);
+  for (size_t i = 0; i < count; i++) {
+    buckets.push_back(0);
+  }
+}
+
+template <typename Key, typename Hash>
+uint64_t CuckooFilter<Key, Hash>::mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+template <typename Key, typename Hash>
+const bool CuckooFilter<Key, Hash>::has_slot(uint64_t bucket, uint16_t fingerprint) {
+  // A slot equal to the fingerprint becomes zero, which the borrow of the subtraction finds in every slot at once
+  uint64_t x = bucket ^ (fingerprint * lane_ones);
+  return ((x - lane_ones) & ~x & lane_highs) != 0;
+}
+
+template <typename Key, typename Hash>
+const int CuckooFilter<Key, Hash>::slot_of(uint64_t bucket, uint16_t fingerprint) {
+  for (int slot = 0; slot < 4; slot++) {
+    if (uint16_t(bucket >> (16 * slot)) == fingerprint) return slot;
+  }
+  return -1;
+}
+
+template <typename Key, typename Hash>
+void CuckooFilter<Key, Hash>::set_slot(uint64_t& bucket, int slot, uint16_t fingerprint) {
+  bucket = (bucket & ~(uint64_t(0xffff) << (16 * slot))) | (uint64_t(fingerprint) << (16 * slot));
+}
+
+template <typename Key, typename Hash>
+void CuckooFilter<Key, Hash>::locate(const Key& key, uint16_t& fingerprint, size_t& first, size_t& second) const {
+  uint64_t hashed = mix(uint64_t(hash(key)));
+  fingerprint = uint16_t(hashed >> 48);
+  if (fingerprint == 0) fingerprint = 1;
+
+  first = size_t(hashed) & mask;
+  second = alternate(first, fingerprint);
+}
+
+template <typename Key, typename Hash>
+const size_t CuckooFilter<Key, Hash>::alternate(size_t bucket, uint16_t fingerprint) const {
+  // The xor is its own inverse, so either bucket leads to the other from the fingerprint alone
+  return (bucket ^ size_t(mix(fingerprint))) & mask;
+}
+
+template <typename Key, typename Hash>
+const bool CuckooFilter<Key, Hash>::possibly_contains(const Key& key) const {
+  uint16_t fingerprint;
+  size_t first, second;
+  locate(key, fingerprint, first, second);
+
+  const uint64_t* words = buckets.data();
+  return has_slot(words[first], fingerprint) || has_slot(words[second], fingerprint);
+}
+
+template <typename Key, typename Hash>
+const MemoryUsage CuckooFilter<Key, Hash>::memory_usage() const {
+  MemoryUsage usage = buckets.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(buckets);
+  return usage;
+}
+
+template <typename Key, typename Hash>
+bool CuckooFilter<Key, Hash>::insert(const Key& key) {
+  uint16_t fingerprint;
+  size_t first, second;
+  locate(key, fingerprint, first, second);
+
+  uint64_t* words = buckets.data();
+  for (size_t bucket : {first, second}) {
+    int slot = slot_of(words[bucket], 0);
+    if (slot != -1) {
+      set_slot(words[bucket], slot, fingerprint);
+      stored++;
+      return true;
+    }
+  }
+
+  // Both buckets are full: evict a random fingerprint to its other bucket, and so on until one lands in a free slot
+  // Every eviction is recorded so a chain that finds no free slot can be undone
+  struct Eviction {
+    size_t bucket;
+    int slot;
+    uint16_t fingerprint;
+  };
+  Eviction evictions[max_kicks];
+
+  size_t bucket = (random & 1) ? first : second;
+  for (int kick = 0; kick < max_kicks; kick++) {
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+
+    int slot = int(random >> 62);
+    uint16_t evicted = uint16_t(words[bucket] >> (16 * slot));
+    evictions[kick] = {bucket, slot, evicted};
+    set_slot(words[bucket], slot, fingerprint);
+
+    fingerprint = evicted;
+    bucket = alternate(bucket, fingerprint);
+    int free_slot = slot_of(words[bucket], 0);
+    if (free_slot != -1) {
+      set_slot(words[bucket], free_slot, fingerprint);
+      stored++;
+      return true;
+    }
+  }
+
+  for (int kick = max_kicks - 1; kick >= 0; kick--) {
+    set_slot(words[evictions[kick].bucket], evictions[kick].slot, evictions[kick].fingerprint);
+  }
+  return false;
+}
+
+template <typename Key, typename Hash>
+bool CuckooFilter<Key, Hash>::remove(const Key& key) {
+  uint16_t fingerprint;
+  size_t first, second;
+  locate(key, fingerprint, first, second);
+
+  uint64_t* words = buckets.data();
+  for (size_t bucket : {first, second}) {
+    int slot = slot_of(words[bucket], fingerprint);
+    if (slot != -1) {
+      set_slot(words[bucket], slot, 0);
+      stored--;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Key, typename Hash>
+void CuckooFilter<Key, Hash>::clear() {
+  uint64_t* words = buckets.data();
+  for (size_t i = 0; i < buckets.size(); i++) {
+    words[i] = 0;
+  }
+  stored = 0;
+}
+
+#endif
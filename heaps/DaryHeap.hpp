@@ -0,0 +1,328 @@
+// DaryHeap.hpp
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Class representing a priority queue as an implicit d-ary heap in one array
+// The top is the element no other element orders before under Compare, so the default std::less gives a min-heap
+// With 4 children per node the heap is half as deep as a binary heap and a node's children share a cache line for small T
+// Every pushed element gets a handle, valid until the element is popped or erased, to change or erase it later
+template <typename T, typename Compare = std::less<T>, size_t Arity = 4>
+class DaryHeap {
+  static_assert(Arity >= 2, "DaryHeap needs at least two children per node");
+public:
+  using Handle = size_t;
+
+private:
+  static constexpr size_t npos = size_t(-1);
+
+  // Struct pairing an element with the handle it was pushed under
+  struct Entry {
+    T value;                          // Element
+    Handle handle;                    // Handle of the element, indexing positions
+  };
+
+  std::vector<Entry> entries;         // Elements in heap order
+  std::vector<size_t> positions;      // Index in entries of each handle's element, npos for released handles
+  std::vector<Handle> released;       // Handles free for reuse
+  Compare compare;                    // Orders the elements, the top being first
+
+  // Private helper functions
+  Handle acquire();                                   // Returns a free handle
+  void place(size_t, Entry&&);                        // Moves an entry to an index, recording its new position
+  void sift_up(size_t);                               // Moves an entry toward the root until its parent orders before it
+  void sift_down(size_t);                             // Moves an entry toward the leaves until no child orders before it
+  void remove_at(size_t);                             // Removes the entry at an index
+  size_t index_of(Handle) const;                      // Returns the index of a handle's element
+public:
+  // Constructors
+  DaryHeap() = default;                               // Default constructor
+  explicit DaryHeap(const Compare& compare);          // Constructor with a comparator
+
+  // Accessors
+  const T& top() const;                               // Returns the element ordered first
+  const T& get(Handle) const;                         // Returns the element of a handle
+  const T* try_top() const;                           // Returns the element ordered first, or nullptr if the heap is empty
+  const T* try_get(Handle) const;                     // Returns the element of a handle, or nullptr if the handle is not live
+  const bool empty() const;                           // Returns if the heap is empty
+  const int size() const;                             // Returns the number of elements in the heap
+  const MemoryUsage memory_usage() const;             // Returns the bytes held by the heap, broken down
+
+  // Mutators
+  Handle push(const T&);                              // Adds an element, returning its handle
+  Handle push(T&&);                                   // Moves an element into the heap, returning its handle
+  template <typename... Args>
+  Handle emplace(Args&&...);                          // Constructs an element in place, returning its handle
+  template <typename It>
+  Handle push_many(It, It);                           // Adds a range in O(n) by reheapifying; its handles are consecutive from the returned one
+  void pop();                                         // Removes the element ordered first
+  T take();                                           // Removes and returns the element ordered first
+  void decrease_key(Handle, T);                       // Replaces an element with one ordering no later (moves it toward the top)
+  void update(Handle, T);                             // Replaces an element with any other
+  void erase(Handle);                                 // Removes the element of a handle
+  void reserve(size_t);                               // Reserves room for a number of elements
+  void clear();                                       // Removes every element, releasing every handle
+};
+
+// Function definitions
+template <typename T, typename Compare, size_t Arity>
+DaryHeap<T, Compare, Arity>::DaryHeap(const Compare& compare) : compare(compare) {}
+
+template <typename T, typename Compare, size_t Arity>
+typename DaryHeap<T, Compare, Arity>::Handle DaryHeap<T, Compare, Arity>::acquire() {
+  if (!released.empty()) {
+    Handle handle = released.back();
+    released.pop_back();
+    return handle;
+  }
+
+  positions.push_back(npos);
+  return positions.size() - 1;
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::place(size_t index, Entry&& entry) {
+  positions[entry.handle] = index;
+  entries[index] = std::move(entry);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::sift_up(size_t index) {
+  // Shift parents down into the hole instead of swapping, one move per level
+  Entry entry = std::move(entries[index]);
+  while (index > 0) {
+    size_t parent = (index - 1) / Arity;
+    if (!compare(entry.value, entries[parent].value)) break;
+
+    place(index, std::move(entries[parent]));
+    index = parent;
+  }
+  place(index, std::move(entry));
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::sift_down(size_t index) {
+  const size_t count = entries.size();
+  Entry entry = std::move(entries[index]);
+
+  while (true) {
+    size_t first = index * Arity + 1;
+    if (first >= count) break;
+
+    size_t last = first + Arity < count ? first + Arity : count;
+    size_t best = first;
+    for (size_t child = first + 1; child < last; child++) {
+      if (compare(entries[child].value, entries[best].value)) best = child;
+    }
+    if (!compare(entries[best].value, entry.value)) break;
+
+    place(index, std::move(entries[best]));
+    index = best;
+  }
+  place(index, std::move(entry));
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::remove_at(size_t index) {
+  Handle handle = entries[index].handle;
+  size_t last = entries.size() - 1;
+
+  if (index != last) {
+    place(index, std::move(entries[last]));
+    entries.pop_back();
+
+    // The moved entry may belong above or below its new index
+    if (index > 0 && compare(entries[index].value, entries[(index - 1) / Arity].value)) {
+      sift_up(index);
+    } else {
+      sift_down(index);
+    }
+  } else {
+    entries.pop_back();
+  }
+
+  positions[handle] = npos;
+  released.push_back(handle);
+}
+
+template <typename T, typename Compare, size_t Arity>
+size_t DaryHeap<T, Compare, Arity>::index_of(Handle handle) const {
+  if (handle >= positions.size() || positions[handle] == npos) throw std::out_of_range("Invalid heap handle");
+  return positions[handle];
+}
+
+template <typename T, typename Compare, size_t Arity>
+const T& DaryHeap<T, Compare, Arity>::top() const {
+  if (entries.empty()) throw std::out_of_range("Heap is empty");
+  return entries.front().value;
+}
+
+template <typename T, typename Compare, size_t Arity>
+const T& DaryHeap<T, Compare, Arity>::get(Handle handle) const {
+  return entries[index_of(handle)].value;
+}
+
+template <typename T, typename Compare, size_t Arity>
+const T* DaryHeap<T, Compare, Arity>::try_top() const {
+  return entries.empty() ? nullptr : &entries.front().value;
+}
+
+template <typename T, typename Compare, size_t Arity>
+const T* DaryHeap<T, Compare, Arity>::try_get(Handle handle) const {
+  if (handle >= positions.size() || positions[handle] == npos) return nullptr;
+  return &entries[positions[handle]].value;
+}
+
+template <typename T, typename Compare, size_t Arity>
+const bool DaryHeap<T, Compare, Arity>::empty() const {
+  return entries.empty();
+}
+
+template <typename T, typename Compare, size_t Arity>
+const int DaryHeap<T, Compare, Arity>::size() const {
+  return int(entries.size());
+}
+
+template <typename T, typename Compare, size_t Arity>
+const MemoryUsage DaryHeap<T, Compare, Arity>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = entries.size() * sizeof(T);
+  usage.slack = (entries.capacity() - entries.size()) * sizeof(Entry);
+  usage.overhead = sizeof(*this) + entries.size() * (sizeof(Entry) - sizeof(T)) +
+                   positions.capacity() * sizeof(size_t) + released.capacity() * sizeof(Handle);
+  usage.allocations = (entries.capacity() > 0) + (positions.capacity() > 0) + (released.capacity() > 0);
+  return usage;
+}
+
+template <typename T, typename Compare, size_t Arity>
+typename DaryHeap<T, Compare, Arity>::Handle DaryHeap<T, Compare, Arity>::push(const T& value) {
+  return emplace(value);
+}
+
+template <typename T, typename Compare, size_t Arity>
+typename DaryHeap<T, Compare, Arity>::Handle DaryHeap<T, Compare, Arity>::push(T&& value) {
+  return emplace(std::move(value));
+}
+
+template <typename T, typename Compare, size_t Arity>
+template <typename... Args>
+typename DaryHeap<T, Compare, Arity>::Handle DaryHeap<T, Compare, Arity>::emplace(Args&&... args) {
+  T value(std::forward<Args>(args)...);
+  Handle handle = acquire();
+
+  entries.push_back(Entry{std::move(value), handle});
+  positions[handle] = entries.size() - 1;
+  sift_up(entries.size() - 1);
+  return handle;
+}
+
+template <typename T, typename Compare, size_t Arity>
+template <typename It>
+typename DaryHeap<T, Compare, Arity>::Handle DaryHeap<T, Compare, Arity>::push_many(It first, It last) {
+  // Fresh handles rather than released ones, so the batch's handles are consecutive
+  const size_t before = entries.size();
+  const Handle base = positions.size();
+  if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value) {
+    size_t count = size_t(std::distance(first, last));
+    entries.reserve(before + count);
+    positions.reserve(base + count);
+  }
+
+  try {
+    for (; first != last; ++first) {
+      entries.push_back(Entry{T(*first), positions.size()});
+      positions.push_back(entries.size() - 1);
+    }
+  } catch (...) {
+    // Drop the part of the batch already appended, leaving the heap as it was
+    entries.resize(before);
+    positions.resize(base);
+    throw;
+  }
+
+  const size_t added = entries.size() - before;
+  if (added == 0) return base;
+
+  // Sifting each new element up costs O(k log n); rebuilding bottom-up costs O(n), so take the cheaper one
+  size_t depth = 1;
+  for (size_t reach = 1; reach < entries.size(); reach = reach * Arity + 1) {
+    depth++;
+  }
+
+  if (added * depth < entries.size()) {
+    for (size_t index = before; index < entries.size(); index++) {
+      sift_up(index);
+    }
+  } else if (entries.size() > 1) {
+    for (size_t index = (entries.size() - 2) / Arity + 1; index-- > 0;) {
+      sift_down(index);
+    }
+  }
+  return base;
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::pop() {
+  if (entries.empty()) throw std::out_of_range("Heap is empty");
+  remove_at(0);
+}
+
+template <typename T, typename Compare, size_t Arity>
+T DaryHeap<T, Compare, Arity>::take() {
+  if (entries.empty()) throw std::out_of_range("Heap is empty");
+
+  T value = std::move(entries.front().value);
+  remove_at(0);
+  return value;
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::decrease_key(Handle handle, T value) {
+  size_t index = index_of(handle);
+  if (compare(entries[index].value, value)) throw std::invalid_argument("decrease_key would move the element away from the top");
+
+  entries[index].value = std::move(value);
+  sift_up(index);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::update(Handle handle, T value) {
+  size_t index = index_of(handle);
+  bool rises = compare(value, entries[index].value);
+
+  entries[index].value = std::move(value);
+  if (rises) {
+    sift_up(index);
+  } else {
+    sift_down(index);
+  }
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::erase(Handle handle) {
+  remove_at(index_of(handle));
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::reserve(size_t count) {
+  entries.reserve(count);
+  positions.reserve(count);
+}
+
+template <typename T, typename Compare, size_t Arity>
+void DaryHeap<T, Compare, Arity>::clear() {
+  entries.clear();
+  positions.clear();
+  released.clear();
+}
+
+#endif
@@ -0,0 +1,359 @@
+// PairingHeap.hpp
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Struct defining a node of a pairing heap
+template <typename T>
+struct PairingHeapNode {
+  T value;                            // Element stored in the node
+  PairingHeapNode<T>* child;          // Leftmost child
+  PairingHeapNode<T>* next;           // Next sibling to the right
+  PairingHeapNode<T>* prev;           // Previous sibling, or the parent for a leftmost child
+
+  // Constructor forwarding its arguments to the element
+  template <typename... Args>
+  explicit PairingHeapNode(Args&&... args) : value(std::forward<Args>(args)...), child(nullptr), next(nullptr), prev(nullptr) {}
+};
+
+// Class representing a priority queue as a pairing heap (Fredman et al., 1986)
+// The top is the element no other element orders before under Compare, so the default std::less gives a min-heap
+// push and decrease_key take O(1) and pop amortized O(log n), which suits workloads lowering many keys, like Dijkstra's algorithm
+// Every element lives in its own node; the handle returned by push points at it and stays valid until the element is popped or erased
+template <typename T, typename Compare = std::less<T>>
+class PairingHeap {
+public:
+  using Handle = PairingHeapNode<T>*;
+
+private:
+  PairingHeapNode<T>* root;           // Node holding the element ordered first
+  int heap_size;                      // Number of elements in the heap
+  Compare compare;                    // Orders the elements, the top being first
+
+  // Private helper functions
+  PairingHeapNode<T>* meld(PairingHeapNode<T>*, PairingHeapNode<T>*);         // Links two heaps, the later root becoming the leftmost child of the other
+  PairingHeapNode<T>* merge_pairs(PairingHeapNode<T>*);                       // Combines a list of siblings into one heap (two-pass pairing)
+  void cut(PairingHeapNode<T>*);                                              // Detaches a non-root node and its subtree from its parent
+  PairingHeapNode<T>* insert(PairingHeapNode<T>*);                            // Adds a detached node to the heap
+  void clear(PairingHeapNode<T>*);                                            // Deletes a node, its siblings to the right and all their descendants
+public:
+  // Constructors and Destructor
+  PairingHeap() : root(nullptr), heap_size(0), compare() {}                   // Default constructor
+  explicit PairingHeap(const Compare& compare) : root(nullptr), heap_size(0), compare(compare) {}  // Constructor with a comparator
+  PairingHeap(const PairingHeap<T, Compare>&);                                // Copy constructor (handles refer to the original)
+  PairingHeap(PairingHeap<T, Compare>&&) noexcept;                            // Move constructor
+  ~PairingHeap();                                                             // Destructor
+
+  // Assignment
+  PairingHeap<T, Compare>& operator=(const PairingHeap<T, Compare>&);         // Copy assignment operator
+  PairingHeap<T, Compare>& operator=(PairingHeap<T, Compare>&&) noexcept;     // Move assignment operator
+
+  // Accessors
+  const T& top() const;                                                       // Returns the element ordered first
+  const T& get(Handle handle) const { return handle->value; }                 // Returns the element of a handle
+  const T* try_top() const;                                                   // Returns the element ordered first, or nullptr if the heap is empty
+  const bool empty() const;                                                   // Returns if the heap is empty
+  const int size() const;                                                     // Returns the number of elements in the heap
+  const MemoryUsage memory_usage() const;                                     // Returns the bytes held by the heap, broken down
+
+  // Mutators
+  Handle push(const T&);                                                      // Adds an element, returning its handle
+  Handle push(T&&);                                                           // Moves an element into the heap, returning its handle
+  template <typename... Args>
+  Handle emplace(Args&&...);                                                  // Constructs an element in place, returning its handle
+  template <typename It>
+  void push_many(It, It);                                                     // Adds a range in O(n)
+  void pop();                                                                 // Removes the element ordered first
+  T take();                                                                   // Removes and returns the element ordered first
+  void decrease_key(Handle, T);                                               // Replaces an element with one ordering no later (moves it toward the top)
+  void update(Handle, T);                                                     // Replaces an element with any other
+  void erase(Handle);                                                         // Removes the element of a handle
+  void merge(PairingHeap<T, Compare>&);                                       // Moves every element of another heap into this one in O(1), keeping their handles
+  void clear();                                                               // Removes every element
+};
+
+// Function definitions
+template <typename T, typename Compare>
+PairingHeapNode<T>* PairingHeap<T, Compare>::meld(PairingHeapNode<T>* a, PairingHeapNode<T>* b) {
+  if (a == nullptr) return b;
+  if (b == nullptr) return a;
+  if (compare(b->value, a->value)) std::swap(a, b);
+
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != nullptr) a->child->prev = b;
+  a->child = b;
+  a->next = nullptr;
+  a->prev = nullptr;
+  return a;
+}
+
+template <typename T, typename Compare>
+PairingHeapNode<T>* PairingHeap<T, Compare>::merge_pairs(PairingHeapNode<T>* first) {
+  if (first == nullptr) return nullptr;
+
+  // First pass, left to right: meld siblings in pairs, chaining the results through prev in reverse
+  PairingHeapNode<T>* paired = nullptr;
+  while (first != nullptr) {
+    PairingHeapNode<T>* a = first;
+    PairingHeapNode<T>* b = a->next;
+    first = b == nullptr ? nullptr : b->next;
+
+    a->next = nullptr;
+    if (b != nullptr) b->next = nullptr;
+
+    PairingHeapNode<T>* melded = meld(a, b);
+    melded->prev = paired;
+    paired = melded;
+  }
+
+  // Second pass, right to left: meld each pair into the accumulated heap
+  PairingHeapNode<T>* result = paired;
+  paired = paired->prev;
+  result->prev = nullptr;
+  while (paired != nullptr) {
+    PairingHeapNode<T>* previous = paired->prev;
+    paired->prev = nullptr;
+    result = meld(paired, result);
+    paired = previous;
+  }
+  return result;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::cut(PairingHeapNode<T>* node) {
+  if (node->prev->child == node) {
+    node->prev->child = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+  if (node->next != nullptr) node->next->prev = node->prev;
+
+  node->next = nullptr;
+  node->prev = nullptr;
+}
+
+template <typename T, typename Compare>
+PairingHeapNode<T>* PairingHeap<T, Compare>::insert(PairingHeapNode<T>* node) {
+  root = meld(root, node);
+  heap_size++;
+  return node;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::clear(PairingHeapNode<T>* node) {
+  // Chains of children can be as deep as the heap is large, so splice each child list into the
+  // sibling list being deleted instead of recursing; every list is walked once, keeping this O(n)
+  while (node != nullptr) {
+    if (node->child != nullptr) {
+      PairingHeapNode<T>* last = node->child;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      last->next = node->next;
+      node->next = node->child;
+    }
+
+    PairingHeapNode<T>* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(const PairingHeap<T, Compare>& other) : root(nullptr), heap_size(0), compare(other.compare) {
+  // Pushing every element is O(n) and avoids recursing down deep chains; the copy's shape may differ
+  std::vector<const PairingHeapNode<T>*> pending;
+  if (other.root != nullptr) pending.push_back(other.root);
+
+  try {
+    while (!pending.empty()) {
+      const PairingHeapNode<T>* node = pending.back();
+      pending.pop_back();
+      push(node->value);
+
+      if (node->next != nullptr) pending.push_back(node->next);
+      if (node->child != nullptr) pending.push_back(node->child);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::PairingHeap(PairingHeap<T, Compare>&& other) noexcept : root(other.root), heap_size(other.heap_size), compare(std::move(other.compare)) {
+  other.root = nullptr;
+  other.heap_size = 0;
+}
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>::~PairingHeap() {
+  clear();
+}
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>& PairingHeap<T, Compare>::operator=(const PairingHeap<T, Compare>& other) {
+  if (this != &other) {
+    PairingHeap<T, Compare> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+PairingHeap<T, Compare>& PairingHeap<T, Compare>::operator=(PairingHeap<T, Compare>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(root, other.root);
+    std::swap(heap_size, other.heap_size);
+    std::swap(compare, other.compare);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare>
+const T& PairingHeap<T, Compare>::top() const {
+  if (root == nullptr) throw std::out_of_range("Heap is empty");
+  return root->value;
+}
+
+template <typename T, typename Compare>
+const T* PairingHeap<T, Compare>::try_top() const {
+  return root == nullptr ? nullptr : &root->value;
+}
+
+template <typename T, typename Compare>
+const bool PairingHeap<T, Compare>::empty() const {
+  return root == nullptr;
+}
+
+template <typename T, typename Compare>
+const int PairingHeap<T, Compare>::size() const {
+  return heap_size;
+}
+
+template <typename T, typename Compare>
+const MemoryUsage PairingHeap<T, Compare>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = heap_size * sizeof(T);
+  usage.overhead = sizeof(*this) + heap_size * (sizeof(PairingHeapNode<T>) - sizeof(T));
+  usage.allocations = heap_size;
+  return usage;
+}
+
+template <typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::push(const T& value) {
+  return insert(new PairingHeapNode<T>(value));
+}
+
+template <typename T, typename Compare>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::push(T&& value) {
+  return insert(new PairingHeapNode<T>(std::move(value)));
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename PairingHeap<T, Compare>::Handle PairingHeap<T, Compare>::emplace(Args&&... args) {
+  return insert(new PairingHeapNode<T>(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Compare>
+template <typename It>
+void PairingHeap<T, Compare>::push_many(It first, It last) {
+  // Each push is a single O(1) meld, so the range costs O(n) without any reheapifying
+  for (; first != last; ++first) {
+    push(*first);
+  }
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::pop() {
+  if (root == nullptr) throw std::out_of_range("Heap is empty");
+
+  PairingHeapNode<T>* old = root;
+  root = merge_pairs(old->child);
+  delete old;
+  heap_size--;
+}
+
+template <typename T, typename Compare>
+T PairingHeap<T, Compare>::take() {
+  if (root == nullptr) throw std::out_of_range("Heap is empty");
+
+  T value = std::move(root->value);
+  pop();
+  return value;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::decrease_key(Handle node, T value) {
+  if (compare(node->value, value)) throw std::invalid_argument("decrease_key would move the element away from the top");
+
+  node->value = std::move(value);
+  if (node == root) return;
+
+  // Only the node's link to its parent can break the heap order, so cut its subtree out and meld it back
+  cut(node);
+  root = meld(root, node);
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::update(Handle node, T value) {
+  if (!compare(node->value, value)) {
+    decrease_key(node, std::move(value));
+    return;
+  }
+
+  // A later element may now order after its children: hand them to the heap and meld the node back alone
+  PairingHeapNode<T>* children = merge_pairs(node->child);
+  node->child = nullptr;
+  if (node == root) {
+    root = children;
+  } else {
+    cut(node);
+    root = meld(root, children);
+  }
+
+  node->value = std::move(value);
+  root = meld(root, node);
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::erase(Handle node) {
+  if (node == root) {
+    pop();
+    return;
+  }
+
+  cut(node);
+  root = meld(root, merge_pairs(node->child));
+  delete node;
+  heap_size--;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::merge(PairingHeap<T, Compare>& other) {
+  if (this == &other) return;
+
+  root = meld(root, other.root);
+  heap_size += other.heap_size;
+  other.root = nullptr;
+  other.heap_size = 0;
+}
+
+template <typename T, typename Compare>
+void PairingHeap<T, Compare>::clear() {
+  clear(root);
+  root = nullptr;
+  heap_size = 0;
+}
+
+#endif
@@ -0,0 +1,520 @@
+// LSMTree.hpp
+#ifndef LSMTREE_H
+#define LSMTREE_H
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../filters/BloomFilter.hpp"
+#include "../linear/Vector.hpp"
+#include "../trees/AVLTree.hpp"
+#include "Serialization.hpp"
+
+// Struct defining a value or deletion marker stored by the LSM tree
+template <typename Value>
+struct LSMEntry {
+  Value value;                        // Stored value, unused for deletions
+  uint8_t deleted;                    // Non-zero for a tombstone hiding older values of the key
+};
+
+// Returns an entry with its padding zeroed, as entries are written to the runs byte for byte
+template <typename Value>
+LSMEntry<Value> make_entry(const Value& value, uint8_t deleted) {
+  LSMEntry<Value> entry;
+  std::memset(static_cast<void*>(&entry), 0, sizeof(entry));
+  entry.value = value;
+  entry.deleted = deleted;
+  return entry;
+}
+
+// Struct defining one run listed in the manifest
+struct LSMRunRecord {
+  uint64_t id;                        // Run number, also naming its files
+  uint32_t level;                     // Compaction level, 0 for freshly flushed runs
+  uint32_t hashes;                    // Hash count of the run's Bloom filter
+};
+
+// Class representing an ordered map that spills to disk as a log-structured merge tree
+// Writes land in an AVLTree memtable; a full memtable is flushed by a background thread to an immutable sorted run
+// Runs are serialized sorted pair files (see Serialization.hpp) read through mmap, each with a Bloom filter so most
+// lookups for absent keys never touch the run. Whenever a level holds fanout runs they are merged into one run of the
+// next level, which bounds the number of runs a lookup may probe to about fanout per level
+// Files live in one directory; a MANIFEST lists the live runs and is replaced atomically after every flush and merge
+// Writes still in the memtable are lost if the process dies before they are flushed (there is no write-ahead log)
+template <typename Key, typename Value>
+class LSMTree {
+  static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "LSMTree keys and values must be trivially copyable");
+private:
+  using Entry = LSMEntry<Value>;
+  using Pair = SerializedPair<Key, Entry>;
+  using Source = std::pair<const Pair*, const Pair*>;
+  using Filter = BloomFilter<Key, BloomByteHash<Key>>;
+
+  // An immutable sorted run on disk with its Bloom filter
+  struct Run {
+    LSMRunRecord record;              // Manifest record of the run
+    MappedTree<Key, Entry> pairs;     // Mapped pairs, sorted by key
+    Filter filter;                    // Filter over every key of the run, tombstones included
+    std::string data_path;            // Path of the pair file
+    std::string filter_path;          // Path of the filter file
+    bool rebuilt;                     // Set if the saved filter was built with another hash and had to be rebuilt
+    std::atomic<bool> obsolete;       // Set once merged away; the files are removed with the last reference
+
+    Run(const LSMRunRecord& record, const std::string& data_path, const std::string& filter_path, double bits_per_key)
+      : record(record), pairs(data_path, false), filter(), data_path(data_path), filter_path(filter_path), rebuilt(false), obsolete(false) {
+      MappedVector<uint64_t> bits(filter_path);
+      if (bits.tag() == BloomByteHash<Key>::tag) {
+        filter = Filter(bits.to_vector(), int(record.hashes));
+        return;
+      }
+
+      // A filter from another hash would check the wrong bits and hide keys, so it is rebuilt from the pairs
+      filter = Filter(pairs.size(), bits_per_key);
+      for (size_t i = 0; i < pairs.size(); i++) {
+        filter.insert(pairs.data()[i].first);
+      }
+      save(filter.data(), filter_path, BloomByteHash<Key>::tag);
+      this->record.hashes = uint32_t(filter.hash_count());
+      rebuilt = true;
+    }
+
+    ~Run() {
+      if (!obsolete.load()) return;
+
+      pairs = MappedTree<Key, Entry>();
+      ::unlink(data_path.c_str());
+      ::unlink(filter_path.c_str());
+    }
+  };
+
+  std::string directory;                            // Directory holding the manifest and the runs
+  size_t memtable_limit;                            // Number of entries that triggers a flush
+  size_t fanout;                                    // Number of runs per level that triggers a merge
+  double bits_per_key;                              // Bloom filter bits per key
+
+  AVLTree<Key, Entry> memtable;                     // Newest writes
+  std::unique_ptr<AVLTree<Key, Entry>> immutable;   // Full memtable being flushed, still searched until its run is live
+  std::vector<std::shared_ptr<Run>> runs;           // Live runs, newest first (levels never decrease along the vector)
+  uint64_t next_id;                                 // Id of the next run
+
+  std::exception_ptr background_error;              // First failure of the background thread, rethrown to callers
+  bool stopping;                                    // Set when the background thread should exit
+  mutable std::mutex mutex;                         // Guards every member above
+  std::condition_variable work;                     // Wakes the background thread
+  std::condition_variable idle;                     // Signalled whenever a flush completes or fails
+  std::thread background;                           // Flushes and merges runs
+
+  // Private helper functions
+  std::string run_path(uint64_t, const char*) const;                        // Returns the path of a run file
+  void load_manifest();                                                     // Opens the runs listed in the manifest
+  void save_manifest(const Vector<LSMRunRecord>&) const;                    // Replaces the manifest
+  Vector<LSMRunRecord> manifest_records() const;                            // Lists the live runs, caller holds the mutex
+  const int merge_level() const;                                            // Returns the lowest level holding fanout runs, or -1
+  template <typename Fn>
+  static void merge(const std::vector<Source>&, Fn);                        // Calls fn(pair) for the newest version of every key of newest-first sources
+  std::shared_ptr<Run> write_run(const std::vector<Source>&, uint64_t, uint32_t, bool);  // Merges sources into a new run
+  void rotate_memtable(std::unique_lock<std::mutex>&);                      // Hands the memtable to the background thread
+  bool find_entry(const Key&, Entry&) const;                                // Finds the newest entry for a key
+  void rethrow_background_error() const;                                    // Rethrows a background failure, caller holds the mutex
+  void background_loop();                                                   // Main loop of the background thread
+public:
+  // Constructor and Destructor
+  explicit LSMTree(const std::string&, size_t memtable_limit = 1 << 16, size_t fanout = 4, double bits_per_key = 10);  // Opens or creates the tree in the given directory
+  LSMTree(const LSMTree<Key, Value>&) = delete;
+  LSMTree<Key, Value>& operator=(const LSMTree<Key, Value>&) = delete;
+  ~LSMTree();                                                               // Flushes the memtable and stops the background thread
+
+  // Accessors
+  Value search(const Key&) const;                                           // Returns the value associated with the given key
+  std::optional<Value> try_get(const Key&) const;                           // Returns the value associated with the given key, or nothing if it is absent (values are copied out, as the memtable may change)
+  const bool contains(const Key&) const;                                    // Returns if the given key exists
+  const size_t run_count() const;                                           // Returns the number of runs on disk
+  const size_t memtable_size() const;                                       // Returns the number of entries waiting to be flushed
+  const MemoryUsage memory_usage() const;                                   // Returns the bytes held by the memtables, filters and mapped runs, broken down
+
+  // Mutators
+  void insert(const Key&, const Value&);                                    // Inserts a key-value pair, replacing any older value (a blind write: checking first would cost a disk lookup)
+  void remove(const Key&);                                                  // Removes a key-value pair
+  void flush();                                                             // Writes the memtable to disk and waits until it is there
+
+  // Utility
+  template <typename Fn>
+  void for_each(Fn) const;                                                  // Calls fn(key, value) on every pair in key order
+};
+
+// Function definitions
+template <typename Key, typename Value>
+LSMTree<Key, Value>::LSMTree(const std::string& directory, size_t memtable_limit, size_t fanout, double bits_per_key)
+  : directory(directory), memtable_limit(memtable_limit == 0 ? 1 : memtable_limit), fanout(fanout < 2 ? 2 : fanout),
+    bits_per_key(bits_per_key), next_id(1), stopping(false) {
+  if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw std::runtime_error("Could not create " + directory + "!");
+  }
+
+  load_manifest();
+  background = std::thread(&LSMTree<Key, Value>::background_loop, this);
+}
+
+template <typename Key, typename Value>
+LSMTree<Key, Value>::~LSMTree() {
+  try {
+    flush();
+  } catch (...) {
+    // A destructor cannot report the failure; the previous manifest still describes a consistent tree
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  work.notify_one();
+  background.join();
+}
+
+template <typename Key, typename Value>
+std::string LSMTree<Key, Value>::run_path(uint64_t id, const char* suffix) const {
+  return directory + "/run-" + std::to_string(id) + suffix;
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::load_manifest() {
+  std::string path = directory + "/MANIFEST";
+  if (::access(path.c_str(), F_OK) != 0) return;
+
+  MappedVector<LSMRunRecord> records(path);
+  bool rebuilt = false;
+  for (const LSMRunRecord& record : records) {
+    runs.push_back(std::make_shared<Run>(record, run_path(record.id, ".data"), run_path(record.id, ".bloom"), bits_per_key));
+    rebuilt = rebuilt || runs.back()->rebuilt;
+    next_id = std::max(next_id, record.id + 1);
+  }
+
+  // Rebuilt filters may use another hash count, which the manifest has to record
+  if (rebuilt) save_manifest(manifest_records());
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::save_manifest(const Vector<LSMRunRecord>& records) const {
+  save(records, directory + "/MANIFEST");
+}
+
+template <typename Key, typename Value>
+Vector<LSMRunRecord> LSMTree<Key, Value>::manifest_records() const {
+  Vector<LSMRunRecord> records(runs.size() + 1, 10);
+  for (const auto& run : runs) {
+    records.push_back(run->record);
+  }
+  return records;
+}
+
+template <typename Key, typename Value>
+const int LSMTree<Key, Value>::merge_level() const {
+  size_t i = 0;
+  while (i < runs.size()) {
+    size_t end = i;
+    while (end < runs.size() && runs[end]->record.level == runs[i]->record.level) {
+      end++;
+    }
+    if (end - i >= fanout) return int(runs[i]->record.level);
+    i = end;
+  }
+  return -1;
+}
+
+template <typename Key, typename Value>
+template <typename Fn>
+void LSMTree<Key, Value>::merge(const std::vector<Source>& sources, Fn fn) {
+  std::vector<const Pair*> positions;
+  for (const Source& source : sources) {
+    positions.push_back(source.first);
+  }
+
+  // Min-heap of source indices by current key; on equal keys the newer (lower index) source comes first
+  auto later = [&positions](size_t a, size_t b) {
+    if (positions[b]->first < positions[a]->first) return true;
+    if (positions[a]->first < positions[b]->first) return false;
+    return a > b;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heap(later);
+  for (size_t i = 0; i < sources.size(); i++) {
+    if (positions[i] != sources[i].second) heap.push(i);
+  }
+
+  while (!heap.empty()) {
+    size_t newest = heap.top();
+    const Pair* pair = positions[newest];
+    fn(*pair);
+
+    // Step every source past this key, dropping the older versions
+    while (!heap.empty() && !(pair->first < positions[heap.top()]->first)) {
+      size_t source = heap.top();
+      heap.pop();
+      if (++positions[source] != sources[source].second) heap.push(source);
+    }
+  }
+}
+
+template <typename Key, typename Value>
+std::shared_ptr<typename LSMTree<Key, Value>::Run> LSMTree<Key, Value>::write_run(const std::vector<Source>& sources, uint64_t id, uint32_t level, bool drop_tombstones) {
+  size_t expected = 0;
+  for (const Source& source : sources) {
+    expected += source.second - source.first;
+  }
+
+  LSMRunRecord record{id, level, 0};
+  Filter filter(expected, bits_per_key);
+  record.hashes = uint32_t(filter.hash_count());
+
+  SerialFileWriter writer(run_path(id, ".data"));
+  merge(sources, [&](const Pair& pair) {
+    // Tombstones only matter while older runs might still hold the key
+    if (drop_tombstones && pair.second.deleted) return;
+
+    writer.append(&pair, sizeof(Pair));
+    filter.insert(pair.first);
+  });
+  writer.finish(SerialKind::SortedPairs, sizeof(Pair), sizeof(Key), sizeof(Entry));
+  save(filter.data(), run_path(id, ".bloom"), BloomByteHash<Key>::tag);
+
+  return std::make_shared<Run>(record, run_path(id, ".data"), run_path(id, ".bloom"), bits_per_key);
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::rethrow_background_error() const {
+  if (background_error) std::rethrow_exception(background_error);
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::rotate_memtable(std::unique_lock<std::mutex>& lock) {
+  // Only one memtable can be in flight, so writers wait here when flushing falls behind
+  idle.wait(lock, [this] { return immutable == nullptr || background_error; });
+  rethrow_background_error();
+  if (memtable.empty()) return;
+
+  immutable.reset(new AVLTree<Key, Entry>(std::move(memtable)));
+  work.notify_one();
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::background_loop() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    work.wait(lock, [this] { return stopping || immutable != nullptr || (!background_error && merge_level() >= 0); });
+
+    try {
+      if (immutable != nullptr) {
+        // Nothing else changes the runs, so they can be read again after unlocking
+        const AVLTree<Key, Entry>* table = immutable.get();
+        uint64_t id = next_id++;
+        bool oldest = runs.empty();
+        lock.unlock();
+
+        std::vector<Pair> pairs = serial_pairs<Key, Entry>(table->get_root());
+        std::shared_ptr<Run> run = write_run({Source(pairs.data(), pairs.data() + pairs.size())}, id, 0, oldest);
+
+        lock.lock();
+        runs.insert(runs.begin(), run);
+        Vector<LSMRunRecord> records = manifest_records();
+        lock.unlock();
+
+        save_manifest(records);
+
+        lock.lock();
+        immutable.reset();
+        idle.notify_all();
+        continue;
+      }
+
+      if (stopping) return;
+
+      int level = merge_level();
+      if (level < 0 || background_error) continue;
+
+      // The runs of one level sit next to each other, newest first
+      size_t first = 0;
+      while (runs[first]->record.level != uint32_t(level)) {
+        first++;
+      }
+      std::vector<std::shared_ptr<Run>> inputs(runs.begin() + first, runs.begin() + first + fanout);
+      bool oldest = first + fanout == runs.size();
+      uint64_t id = next_id++;
+      lock.unlock();
+
+      std::vector<Source> sources;
+      for (const auto& input : inputs) {
+        sources.push_back(Source(input->pairs.data(), input->pairs.data() + input->pairs.size()));
+      }
+      std::shared_ptr<Run> run = write_run(sources, id, uint32_t(level + 1), oldest);
+
+      // Flushes only add runs at the front, so the inputs moved by exactly the runs added since
+      lock.lock();
+      first = 0;
+      while (runs[first] != inputs.front()) {
+        first++;
+      }
+      runs.erase(runs.begin() + first, runs.begin() + first + fanout);
+      runs.insert(runs.begin() + first, run);
+      Vector<LSMRunRecord> records = manifest_records();
+      lock.unlock();
+
+      // Old files may only go once the manifest no longer names them
+      save_manifest(records);
+      for (const auto& input : inputs) {
+        input->obsolete.store(true);
+      }
+      inputs.clear();
+
+      lock.lock();
+    } catch (...) {
+      if (!lock.owns_lock()) lock.lock();
+      background_error = std::current_exception();
+      idle.notify_all();
+      if (immutable != nullptr || stopping) return;
+    }
+  }
+}
+
+template <typename Key, typename Value>
+bool LSMTree<Key, Value>::find_entry(const Key& key, Entry& entry) const {
+  std::unique_lock<std::mutex> lock(mutex);
+  const Entry* found = memtable.find(key);
+  if (found == nullptr && immutable != nullptr) found = immutable->find(key);
+  if (found != nullptr) {
+    entry = *found;
+    return true;
+  }
+
+  // Runs are immutable, so they are probed without holding the lock
+  std::vector<std::shared_ptr<Run>> snapshot = runs;
+  lock.unlock();
+
+  for (const auto& run : snapshot) {
+    if (!run->filter.possibly_contains(key)) continue;
+    const Entry* stored = run->pairs.find(key);
+    if (stored != nullptr) {
+      entry = *stored;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename Key, typename Value>
+Value LSMTree<Key, Value>::search(const Key& key) const {
+  Entry entry;
+  if (!find_entry(key, entry) || entry.deleted) throw std::out_of_range("Key not found!");
+  return entry.value;
+}
+
+template <typename Key, typename Value>
+std::optional<Value> LSMTree<Key, Value>::try_get(const Key& key) const {
+  Entry entry;
+  if (!find_entry(key, entry) || entry.deleted) return std::nullopt;
+  return entry.value;
+}
+
+template <typename Key, typename Value>
+const bool LSMTree<Key, Value>::contains(const Key& key) const {
+  Entry entry;
+  return find_entry(key, entry) && !entry.deleted;
+}
+
+template <typename Key, typename Value>
+const size_t LSMTree<Key, Value>::run_count() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return runs.size();
+}
+
+template <typename Key, typename Value>
+const size_t LSMTree<Key, Value>::memtable_size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return memtable.size() + (immutable != nullptr ? immutable->size() : 0);
+}
+
+template <typename Key, typename Value>
+const MemoryUsage LSMTree<Key, Value>::memory_usage() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  MemoryUsage usage = memtable.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(memtable) + runs.capacity() * sizeof(std::shared_ptr<Run>);
+  usage.allocations += runs.capacity() > 0 ? 1 : 0;
+  if (immutable != nullptr) {
+    usage += immutable->memory_usage();
+    usage.allocations++;
+  }
+
+  for (const std::shared_ptr<Run>& run : runs) {
+    usage += run->pairs.memory_usage();
+    usage += run->filter.memory_usage();
+    usage.overhead += sizeof(Run) - sizeof(run->pairs) - sizeof(run->filter) + run->data_path.capacity() + run->filter_path.capacity();
+    usage.allocations++;
+  }
+  return usage;
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::insert(const Key& key, const Value& value) {
+  std::unique_lock<std::mutex> lock(mutex);
+  rethrow_background_error();
+
+  memtable.insert_or_assign(key, make_entry(value, 0));
+  if (size_t(memtable.size()) >= memtable_limit) rotate_memtable(lock);
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::remove(const Key& key) {
+  std::unique_lock<std::mutex> lock(mutex);
+  rethrow_background_error();
+
+  memtable.insert_or_assign(key, make_entry(Value(), 1));
+  if (size_t(memtable.size()) >= memtable_limit) rotate_memtable(lock);
+}
+
+template <typename Key, typename Value>
+void LSMTree<Key, Value>::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  rotate_memtable(lock);
+  idle.wait(lock, [this] { return immutable == nullptr || background_error; });
+  rethrow_background_error();
+}
+
+template <typename Key, typename Value>
+template <typename Fn>
+void LSMTree<Key, Value>::for_each(Fn fn) const {
+  std::unique_lock<std::mutex> lock(mutex);
+  std::vector<Pair> newest = serial_pairs<Key, Entry>(memtable.get_root());
+  std::vector<Pair> flushing;
+  if (immutable != nullptr) flushing = serial_pairs<Key, Entry>(immutable->get_root());
+  std::vector<std::shared_ptr<Run>> snapshot = runs;
+  lock.unlock();
+
+  std::vector<Source> sources;
+  sources.push_back(Source(newest.data(), newest.data() + newest.size()));
+  sources.push_back(Source(flushing.data(), flushing.data() + flushing.size()));
+  for (const auto& run : snapshot) {
+    sources.push_back(Source(run->pairs.data(), run->pairs.data() + run->pairs.size()));
+  }
+
+  merge(sources, [&fn](const Pair& pair) {
+    if (!pair.second.deleted) fn(pair.first, pair.second.value);
+  });
+}
+
+#endif
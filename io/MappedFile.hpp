@@ -0,0 +1,153 @@
+// MappedFile.hpp
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Class representing a read-only memory mapping of a whole file (POSIX)
+// Pages are loaded lazily by the kernel, so opening a file costs O(1) regardless of its size
+class MappedFile {
+private:
+  void* address;                      // Start of the mapping, nullptr for an empty file
+  size_t length;                      // Size of the mapping in bytes
+
+public:
+  // Constructors and Destructor
+  MappedFile() : address(nullptr), length(0) {}                 // Default constructor
+  explicit MappedFile(const std::string&);                      // Maps the file at the given path
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) noexcept;                            // Move constructor
+  ~MappedFile();                                                // Destructor
+
+  // Assignment
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) noexcept;                 // Move assignment operator
+
+  // Accessors
+  const char* data() const { return static_cast<const char*>(address); }   // Returns the first mapped byte
+  const size_t size() const { return length; }                             // Returns the size of the mapping
+  const bool empty() const { return length == 0; }                         // Returns if nothing is mapped
+
+  // Utility
+  void unmap();                                                 // Releases the mapping
+  void will_need() const;                                       // Asks the kernel to read the whole file ahead
+};
+
+// Flushes the directory entry of the given file, so a rename into place survives a crash
+inline void sync_parent_directory(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+  int descriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (descriptor < 0) throw std::runtime_error("Could not open " + directory + "!");
+
+  bool synced = ::fsync(descriptor) == 0;
+  ::close(descriptor);
+  if (!synced) throw std::runtime_error("Could not sync " + directory + "!");
+}
+
+// Writes the given buffers to a file with a single gathered write, replacing the file atomically
+// The data goes to a temporary file first, so a crash never leaves a half-written file behind
+inline void write_file(const std::string& path, const struct iovec* buffers, int count) {
+  std::string temporary = path + ".tmp";
+  int descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor < 0) throw std::runtime_error("Could not open " + temporary + " for writing!");
+
+  // writev may stop early, so skip what was written and retry with the rest
+  std::vector<struct iovec> pending(buffers, buffers + count);
+  struct iovec* next = pending.data();
+  while (count > 0) {
+    ssize_t written = ::writev(descriptor, next, count);
+    if (written < 0 && errno == EINTR) continue;
+    if (written < 0) {
+      ::close(descriptor);
+      ::unlink(temporary.c_str());
+      throw std::runtime_error("Could not write " + temporary + "!");
+    }
+
+    while (count > 0 && size_t(written) >= next->iov_len) {
+      written -= next->iov_len;
+      next++;
+      count--;
+    }
+    if (count > 0) {
+      next->iov_base = static_cast<char*>(next->iov_base) + written;
+      next->iov_len -= written;
+    }
+  }
+
+  bool synced = ::fsync(descriptor) == 0;
+  ::close(descriptor);
+  if (!synced || ::rename(temporary.c_str(), path.c_str()) != 0) {
+    ::unlink(temporary.c_str());
+    throw std::runtime_error("Could not replace " + path + "!");
+  }
+  sync_parent_directory(path);
+}
+
+// Function definitions
+inline MappedFile::MappedFile(const std::string& path) : address(nullptr), length(0) {
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) throw std::runtime_error("Could not open " + path + "!");
+
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0) {
+    ::close(descriptor);
+    throw std::runtime_error("Could not stat " + path + "!");
+  }
+
+  length = size_t(status.st_size);
+  if (length > 0) {
+    address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (address == MAP_FAILED) {
+      address = nullptr;
+      length = 0;
+      ::close(descriptor);
+      throw std::runtime_error("Could not map " + path + "!");
+    }
+  }
+
+  // The mapping keeps the file alive on its own
+  ::close(descriptor);
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept : address(other.address), length(other.length) {
+  other.address = nullptr;
+  other.length = 0;
+}
+
+inline MappedFile::~MappedFile() {
+  unmap();
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    std::swap(address, other.address);
+    std::swap(length, other.length);
+  }
+  return *this;
+}
+
+inline void MappedFile::unmap() {
+  if (address != nullptr) ::munmap(address, length);
+
+  address = nullptr;
+  length = 0;
+}
+
+inline void MappedFile::will_need() const {
+  if (address != nullptr) ::madvise(address, length, MADV_WILLNEED);
+}
+
+#endif
@@ -0,0 +1,573 @@
+// Serialization.hpp
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../linear/Vector.hpp"
+#include "../trees/AVLTree.hpp"
+#include "../trees/BST.hpp"
+#include "MappedFile.hpp"
+
+// Binary file layout: a 64 byte SerialHeader followed by the payload
+//   array files hold the raw elements of a Vector
+//   sorted pair files hold SerializedPair records in increasing key order (written from either tree kind)
+// The payload is stored in native byte order and layout, so readers can use it in place from the mapped pages
+
+constexpr uint32_t serial_version = 1;
+constexpr uint32_t serial_byte_order = 0x01020304;
+constexpr char serial_magic[8] = {'C', 'P', 'P', 'T', 'K', 'B', 'I', 'N'};
+
+// Bytes of records a tree is gathered into before each write while saving
+constexpr size_t serial_batch_bytes = 1 << 16;
+
+// Kinds of payload a serialized file can hold
+enum class SerialKind : uint32_t {
+  Array = 1,                          // Elements of a Vector
+  SortedPairs = 2                     // Key-value pairs of an AVLTree or BST
+};
+
+// Struct defining the header at the start of every serialized file
+struct SerialHeader {
+  char magic[8];                      // Identifies the file format
+  uint32_t version;                   // Format version, bumped on incompatible changes
+  uint32_t kind;                      // SerialKind of the payload
+  uint32_t byte_order;                // serial_byte_order as written by the producing machine
+  uint32_t record_size;               // Size of one element or pair record
+  uint32_t key_size;                  // Size of the element or key type
+  uint32_t value_size;                // Size of the value type, 0 for arrays
+  uint64_t count;                     // Number of records in the payload
+  uint64_t payload_size;              // Size of the payload in bytes
+  uint64_t checksum;                  // serial_checksum of the payload
+  uint64_t tag;                       // Set by the producer to identify how the payload was computed, zero if unused
+};
+
+static_assert(sizeof(SerialHeader) == 64, "SerialHeader must stay 64 bytes so payloads start cache line aligned");
+
+// Struct defining one key-value record of a sorted pair file
+template <typename Key, typename Value>
+struct SerializedPair {
+  Key first;                          // Key of the pair
+  Value second;                       // Value of the pair
+};
+
+// Class computing serial_checksum over data supplied in pieces
+// Four independent multiply-xor lanes consume 8 byte words, 32 bytes per step
+class SerialChecksum {
+private:
+  uint64_t lanes[4];                  // Running lane states
+  unsigned char pending[32];          // Bytes not yet forming a whole step
+  size_t pending_size;                // Number of bytes in pending
+  uint64_t total;                     // Number of bytes seen so far
+
+  // Private helper function to fold one 32 byte step into the lanes
+  void step(const unsigned char*);
+public:
+  // Constructor
+  SerialChecksum() : lanes{0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL, 0x9ce484222325cbf2ULL, 0x2325cbf29ce48422ULL}, pending_size(0), total(0) {}
+
+  // Public Functions
+  void update(const void*, size_t);                 // Adds bytes to the checksum
+  uint64_t finish() const;                          // Returns the checksum of every byte added so far
+};
+
+inline void SerialChecksum::step(const unsigned char* bytes) {
+  const uint64_t prime = 0x100000001b3ULL;
+  for (int lane = 0; lane < 4; lane++) {
+    uint64_t word;
+    std::memcpy(&word, bytes + 8 * lane, sizeof(word));
+    lanes[lane] = (lanes[lane] ^ word) * prime;
+    lanes[lane] ^= lanes[lane] >> 32;
+  }
+}
+
+inline void SerialChecksum::update(const void* data, size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  total += size;
+
+  if (pending_size > 0) {
+    size_t taken = std::min(size, sizeof(pending) - pending_size);
+    std::memcpy(pending + pending_size, bytes, taken);
+    pending_size += taken;
+    bytes += taken;
+    size -= taken;
+
+    if (pending_size < sizeof(pending)) return;
+    step(pending);
+    pending_size = 0;
+  }
+
+  for (; size >= sizeof(pending); bytes += sizeof(pending), size -= sizeof(pending)) {
+    step(bytes);
+  }
+
+  std::memcpy(pending, bytes, size);
+  pending_size = size;
+}
+
+inline uint64_t SerialChecksum::finish() const {
+  const uint64_t prime = 0x100000001b3ULL;
+
+  uint64_t hash = total;
+  for (int lane = 0; lane < 4; lane++) {
+    hash = (hash ^ lanes[lane]) * prime;
+  }
+  for (size_t i = 0; i < pending_size; i++) {
+    hash = (hash ^ pending[i]) * prime;
+  }
+  return hash;
+}
+
+// Checksums a byte range in one go
+inline uint64_t serial_checksum(const void* data, size_t size) {
+  SerialChecksum checksum;
+  checksum.update(data, size);
+  return checksum.finish();
+}
+
+// Builds the header describing a payload whose checksum is already known
+inline SerialHeader make_serial_header(SerialKind kind, uint32_t record_size, uint32_t key_size, uint32_t value_size, uint64_t count, uint64_t checksum) {
+  SerialHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, serial_magic, sizeof(header.magic));
+  header.version = serial_version;
+  header.kind = uint32_t(kind);
+  header.byte_order = serial_byte_order;
+  header.record_size = record_size;
+  header.key_size = key_size;
+  header.value_size = value_size;
+  header.count = count;
+  header.payload_size = count * record_size;
+  header.checksum = checksum;
+  return header;
+}
+
+// Builds the header describing a payload held in memory
+inline SerialHeader make_serial_header(SerialKind kind, uint32_t record_size, uint32_t key_size, uint32_t value_size, uint64_t count, const void* payload) {
+  return make_serial_header(kind, record_size, key_size, value_size, count, serial_checksum(payload, count * record_size));
+}
+
+// Checks that a mapped file holds the expected payload, returning its header
+// Checksumming touches every page, so callers that trust the file can skip it to open in O(1)
+inline const SerialHeader& validate_serial_file(const MappedFile& file, SerialKind kind, uint32_t record_size, uint32_t key_size, uint32_t value_size, bool verify) {
+  if (file.size() < sizeof(SerialHeader)) throw std::runtime_error("File too small to be serialized data!");
+
+  const SerialHeader& header = *reinterpret_cast<const SerialHeader*>(file.data());
+  if (std::memcmp(header.magic, serial_magic, sizeof(header.magic)) != 0) throw std::runtime_error("Not a serialized file!");
+  if (header.version != serial_version) throw std::runtime_error("Unsupported serialization version!");
+  if (header.byte_order != serial_byte_order) throw std::runtime_error("File was written with a different byte order!");
+  if (header.kind != uint32_t(kind)) throw std::runtime_error("File holds a different kind of container!");
+  if (header.record_size != record_size || header.key_size != key_size || header.value_size != value_size) {
+    throw std::runtime_error("File was written for different element types!");
+  }
+  if (header.count > (file.size() - sizeof(SerialHeader)) / record_size || header.payload_size != header.count * record_size) {
+    throw std::runtime_error("File is truncated!");
+  }
+  if (verify && serial_checksum(file.data() + sizeof(SerialHeader), header.payload_size) != header.checksum) {
+    throw std::runtime_error("Checksum mismatch!");
+  }
+
+  return header;
+}
+
+// Calls fn(node) on every node of a tree in key order without recursion (works for AVLTreeNode and BSTNode)
+template <typename Node, typename Fn>
+void serial_in_order(const Node* root, Fn fn) {
+  std::vector<const Node*> path;
+  const Node* node = root;
+
+  while (node != nullptr || !path.empty()) {
+    while (node != nullptr) {
+      path.push_back(node);
+      node = node->left;
+    }
+
+    node = path.back();
+    path.pop_back();
+    fn(node);
+    node = node->right;
+  }
+}
+
+// Fills a record from a node in place
+// Records go to disk byte for byte, so the padding is zeroed to keep files and checksums deterministic
+template <typename Key, typename Value, typename Node>
+void serial_fill_pair(SerializedPair<Key, Value>& pair, const Node* node) {
+  std::memset(static_cast<void*>(&pair), 0, sizeof(pair));
+  std::memcpy(static_cast<void*>(&pair.first), &node->key, sizeof(Key));
+  std::memcpy(static_cast<void*>(&pair.second), &node->value, sizeof(Value));
+}
+
+// Collects the pairs of a tree in key order
+template <typename Key, typename Value, typename Node>
+std::vector<SerializedPair<Key, Value>> serial_pairs(const Node* root) {
+  std::vector<SerializedPair<Key, Value>> pairs;
+  serial_in_order(root, [&pairs](const Node* node) { serial_fill_pair(pairs.emplace_back(), node); });
+  return pairs;
+}
+
+// Writes a header and a payload with one gathered write
+inline void write_serial_file(const std::string& path, const SerialHeader& header, const void* payload) {
+  struct iovec buffers[2];
+  buffers[0].iov_base = const_cast<SerialHeader*>(&header);
+  buffers[0].iov_len = sizeof(header);
+  buffers[1].iov_base = const_cast<void*>(payload);
+  buffers[1].iov_len = header.payload_size;
+  write_file(path, buffers, 2);
+}
+
+// Class streaming a serialized file to disk record by record, for payloads too large to gather in memory
+// Like write_file, the data goes to a temporary file that only replaces the target once finished
+class SerialFileWriter {
+private:
+  std::string path;                   // File replaced on finish
+  std::string temporary;              // File being written
+  int descriptor;                     // Open descriptor of the temporary file, -1 once closed
+  SerialChecksum checksum;            // Checksum of the payload so far
+  uint64_t payload_size;              // Number of payload bytes appended
+  std::vector<char> buffer;           // Payload bytes not yet written
+
+  // Private helper functions
+  void write_all(const void*, size_t, off_t);                               // Writes bytes at an offset, retrying short writes
+  void flush_buffer();                                                      // Writes out the buffered payload
+  void abandon();                                                           // Closes and removes the temporary file
+public:
+  // Constructor and Destructor
+  explicit SerialFileWriter(const std::string&);                            // Starts writing the file at the given path
+  SerialFileWriter(const SerialFileWriter&) = delete;
+  SerialFileWriter& operator=(const SerialFileWriter&) = delete;
+  ~SerialFileWriter();                                                      // Discards the file unless it was finished
+
+  // Public Functions
+  void append(const void*, size_t);                                         // Appends payload bytes
+  void finish(SerialKind, uint32_t, uint32_t, uint32_t);                    // Writes the header for (kind, record size, key size, value size) and publishes the file
+};
+
+inline SerialFileWriter::SerialFileWriter(const std::string& path) : path(path), temporary(path + ".tmp"), descriptor(-1), payload_size(0) {
+  descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor < 0) throw std::runtime_error("Could not open " + temporary + " for writing!");
+  buffer.reserve(1 << 20);
+}
+
+inline SerialFileWriter::~SerialFileWriter() {
+  abandon();
+}
+
+inline void SerialFileWriter::abandon() {
+  if (descriptor < 0) return;
+
+  ::close(descriptor);
+  ::unlink(temporary.c_str());
+  descriptor = -1;
+}
+
+inline void SerialFileWriter::write_all(const void* data, size_t size, off_t offset) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t written = ::pwrite(descriptor, bytes, size, offset);
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) {
+      abandon();
+      throw std::runtime_error("Could not write " + temporary + "!");
+    }
+
+    bytes += written;
+    size -= written;
+    offset += written;
+  }
+}
+
+inline void SerialFileWriter::flush_buffer() {
+  write_all(buffer.data(), buffer.size(), off_t(sizeof(SerialHeader) + payload_size - buffer.size()));
+  buffer.clear();
+}
+
+inline void SerialFileWriter::append(const void* data, size_t size) {
+  if (descriptor < 0) throw std::logic_error("Serialized file was already finished!");
+
+  checksum.update(data, size);
+  payload_size += size;
+
+  const char* bytes = static_cast<const char*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + size);
+  if (buffer.size() >= buffer.capacity() / 2) flush_buffer();
+}
+
+inline void SerialFileWriter::finish(SerialKind kind, uint32_t record_size, uint32_t key_size, uint32_t value_size) {
+  if (descriptor < 0) throw std::logic_error("Serialized file was already finished!");
+  if (payload_size % record_size != 0) throw std::logic_error("Payload is not a whole number of records!");
+
+  flush_buffer();
+  SerialHeader header = make_serial_header(kind, record_size, key_size, value_size, payload_size / record_size, checksum.finish());
+  write_all(&header, sizeof(header), 0);
+
+  bool synced = ::fsync(descriptor) == 0;
+  ::close(descriptor);
+  descriptor = -1;
+  if (!synced || ::rename(temporary.c_str(), path.c_str()) != 0) {
+    ::unlink(temporary.c_str());
+    throw std::runtime_error("Could not replace " + path + "!");
+  }
+  sync_parent_directory(path);
+}
+
+// Saves the elements of a vector, with an optional tag that MappedVector::tag() returns
+template <typename T>
+void save(const Vector<T>& vector, const std::string& path, uint64_t tag = 0) {
+  static_assert(std::is_trivially_copyable<T>::value, "Only vectors of trivially copyable elements can be serialized");
+
+  SerialHeader header = make_serial_header(SerialKind::Array, sizeof(T), sizeof(T), 0, vector.size(), vector.data());
+  header.tag = tag;
+  write_serial_file(path, header, vector.data());
+}
+
+// Streams the pairs of a tree to a sorted pair file in batches, so saving never holds a second copy of the tree
+template <typename Key, typename Value, typename Node>
+void write_serial_pairs(const Node* root, const std::string& path) {
+  using Pair = SerializedPair<Key, Value>;
+
+  SerialFileWriter writer(path);
+  std::vector<Pair> batch(std::max<size_t>(1, serial_batch_bytes / sizeof(Pair)));
+  size_t filled = 0;
+  serial_in_order(root, [&](const Node* node) {
+    serial_fill_pair(batch[filled++], node);
+    if (filled == batch.size()) {
+      writer.append(batch.data(), filled * sizeof(Pair));
+      filled = 0;
+    }
+  });
+  writer.append(batch.data(), filled * sizeof(Pair));
+  writer.finish(SerialKind::SortedPairs, sizeof(Pair), sizeof(Key), sizeof(Value));
+}
+
+// Saves the pairs of a tree in key order
+template <typename Key, typename Value, typename Stats, typename Compare>
+void save(const AVLTree<Key, Value, Stats, Compare>& tree, const std::string& path) {
+  static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "Only trees of trivially copyable keys and values can be serialized");
+  static_assert(std::is_same<Compare, ThreeWayCompare<Key>>::value, "MappedTree searches with operator<, so only trees in that order can be serialized");
+
+  write_serial_pairs<Key, Value>(tree.get_root(), path);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void save(const BST<Key, Value, Stats, Compare>& tree, const std::string& path) {
+  static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "Only trees of trivially copyable keys and values can be serialized");
+  static_assert(std::is_same<Compare, ThreeWayCompare<Key>>::value, "MappedTree searches with operator<, so only trees in that order can be serialized");
+
+  write_serial_pairs<Key, Value>(tree.get_root(), path);
+}
+
+// Class representing a read-only vector used in place from a mapped file
+template <typename T>
+class MappedVector {
+  static_assert(std::is_trivially_copyable<T>::value, "Only vectors of trivially copyable elements can be mapped");
+private:
+  MappedFile file;                    // Mapping holding the elements
+  const T* elements;                  // First element, inside the mapping
+  size_t length;                      // Number of elements
+public:
+  // Constructor
+  MappedVector() : elements(nullptr), length(0) {}                                  // Default constructor
+  explicit MappedVector(const std::string&, bool verify = true);                     // Maps a file written by save(Vector)
+
+  // Accessors
+  const T& operator[](int) const;                                                   // Overloaded const subscript operator
+  const size_t size() const { return length; }                                      // Returns the number of elements
+  const bool empty() const { return length == 0; }                                  // Returns if there are no elements
+  const T* data() const { return elements; }                                        // Returns the first element
+  const uint64_t tag() const;                                                       // Returns the tag given to save, 0 if nothing is mapped
+  const MemoryUsage memory_usage() const;                                           // Returns the bytes mapped, broken down
+
+  // Iterator functions
+  typename Vector<T>::ConstIterator begin() const { return typename Vector<T>::ConstIterator(elements); }            // Returns an iterator pointing to the first element
+  typename Vector<T>::ConstIterator end() const { return typename Vector<T>::ConstIterator(elements + length); }    // Returns an iterator pointing to the end
+
+  // Utility
+  Vector<T> to_vector() const;                                                      // Copies the elements into a mutable Vector
+};
+
+// Class representing a read-only sorted map used in place from a mapped file
+// Lookups binary search the pair records, so opening costs nothing beyond the optional checksum
+template <typename Key, typename Value>
+class MappedTree {
+  static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value, "Only trees of trivially copyable keys and values can be mapped");
+private:
+  MappedFile file;                                  // Mapping holding the pairs
+  const SerializedPair<Key, Value>* pairs;          // First pair, inside the mapping
+  size_t length;                                    // Number of pairs
+
+  // Private helper function returning the first pair whose key is not less than the given key
+  const SerializedPair<Key, Value>* lower_bound(const Key&) const;
+public:
+  // Constructor
+  MappedTree() : pairs(nullptr), length(0) {}                                       // Default constructor
+  explicit MappedTree(const std::string&, bool verify = true);                       // Maps a file written by save(AVLTree) or save(BST)
+
+  // Accessors
+  const Value* find(const Key&) const;                                              // Returns the value associated with the given key, or nullptr if it is absent
+  const Value& search(const Key&) const;                                            // Returns the value associated with the given key
+  const bool contains(const Key&) const;                                            // Returns if the given key exists
+  const size_t size() const { return length; }                                      // Returns the number of pairs
+  const bool empty() const { return length == 0; }                                  // Returns if there are no pairs
+  const SerializedPair<Key, Value>* data() const { return pairs; }                  // Returns the first pair
+  const MemoryUsage memory_usage() const;                                           // Returns the bytes mapped, broken down
+
+  // Utility
+  AVLTree<Key, Value> to_avl_tree() const;                                          // Builds a mutable AVLTree in O(n)
+  BST<Key, Value> to_bst() const;                                                   // Builds a mutable, balanced BST in O(n)
+
+  // Iterator
+  class Iterator {
+  private:
+    const SerializedPair<Key, Value>* current;      // Pointer to the current pair in the iteration
+  public:
+    // Constructors
+    Iterator() : current(nullptr) {}
+    Iterator(const SerializedPair<Key, Value>* current) : current(current) {}
+
+    // Dereference operator
+    const Value& operator*() const { return current->second; }
+
+    // Get the current key
+    const Key& get_key() const { return current->first; }
+
+    // Get the current value
+    const Value& get_value() const { return current->second; }
+
+    // Increment operator
+    Iterator& operator++() { ++current; return *this; }
+
+    // Inequality operator
+    bool operator!=(const Iterator& other) const { return current != other.current; }
+  };
+
+  // Iterator methods
+  Iterator begin() const { return Iterator(pairs); }                    // Returns an iterator pointing to the smallest key
+  Iterator end() const { return Iterator(pairs + length); }             // Returns an iterator pointing to the end
+};
+
+// Loaders building mutable containers from a file
+template <typename T>
+Vector<T> load_vector(const std::string& path, bool verify = true) {
+  return MappedVector<T>(path, verify).to_vector();
+}
+
+template <typename Key, typename Value>
+AVLTree<Key, Value> load_avl_tree(const std::string& path, bool verify = true) {
+  return MappedTree<Key, Value>(path, verify).to_avl_tree();
+}
+
+template <typename Key, typename Value>
+BST<Key, Value> load_bst(const std::string& path, bool verify = true) {
+  return MappedTree<Key, Value>(path, verify).to_bst();
+}
+
+// Function definitions
+template <typename T>
+MappedVector<T>::MappedVector(const std::string& path, bool verify) : file(path), elements(nullptr), length(0) {
+  const SerialHeader& header = validate_serial_file(file, SerialKind::Array, sizeof(T), sizeof(T), 0, verify);
+  elements = reinterpret_cast<const T*>(file.data() + sizeof(SerialHeader));
+  length = header.count;
+}
+
+template <typename T>
+const T& MappedVector<T>::operator[](int index) const {
+  if (index < 0 || size_t(index) >= length) throw std::out_of_range("Index out of range");
+
+  return elements[index];
+}
+
+template <typename T>
+const uint64_t MappedVector<T>::tag() const {
+  if (file.empty()) return 0;
+  return reinterpret_cast<const SerialHeader*>(file.data())->tag;
+}
+
+template <typename T>
+const MemoryUsage MappedVector<T>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = length * sizeof(T);
+  usage.overhead = sizeof(*this) + file.size() - usage.payload;
+  usage.mapped = file.size();
+  return usage;
+}
+
+template <typename T>
+Vector<T> MappedVector<T>::to_vector() const {
+  // Keep later growth proportional to the loaded size, as the step is added on every resize
+  Vector<T> vector(length, length / 2 + 10);
+  for (size_t i = 0; i < length; i++) {
+    vector.push_back(elements[i]);
+  }
+  return vector;
+}
+
+template <typename Key, typename Value>
+MappedTree<Key, Value>::MappedTree(const std::string& path, bool verify) : file(path), pairs(nullptr), length(0) {
+  const SerialHeader& header = validate_serial_file(file, SerialKind::SortedPairs, sizeof(SerializedPair<Key, Value>), sizeof(Key), sizeof(Value), verify);
+  pairs = reinterpret_cast<const SerializedPair<Key, Value>*>(file.data() + sizeof(SerialHeader));
+  length = header.count;
+}
+
+template <typename Key, typename Value>
+const SerializedPair<Key, Value>* MappedTree<Key, Value>::lower_bound(const Key& key) const {
+  size_t low = 0;
+  size_t high = length;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (pairs[middle].first < key) low = middle + 1;
+    else high = middle;
+  }
+  return pairs + low;
+}
+
+template <typename Key, typename Value>
+const Value* MappedTree<Key, Value>::find(const Key& key) const {
+  const SerializedPair<Key, Value>* pair = lower_bound(key);
+  if (pair == pairs + length || key < pair->first) return nullptr;
+  return &pair->second;
+}
+
+template <typename Key, typename Value>
+const Value& MappedTree<Key, Value>::search(const Key& key) const {
+  const Value* value = find(key);
+  if (value == nullptr) throw std::out_of_range("Key not found!");
+  return *value;
+}
+
+template <typename Key, typename Value>
+const bool MappedTree<Key, Value>::contains(const Key& key) const {
+  return find(key) != nullptr;
+}
+
+template <typename Key, typename Value>
+const MemoryUsage MappedTree<Key, Value>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = length * (sizeof(Key) + sizeof(Value));
+  usage.overhead = sizeof(*this) + file.size() - usage.payload;
+  usage.mapped = file.size();
+  return usage;
+}
+
+template <typename Key, typename Value>
+AVLTree<Key, Value> MappedTree<Key, Value>::to_avl_tree() const {
+  AVLTree<Key, Value> tree;
+  tree.assign_sorted(pairs, pairs + length);
+  return tree;
+}
+
+template <typename Key, typename Value>
+BST<Key, Value> MappedTree<Key, Value>::to_bst() const {
+  BST<Key, Value> tree;
+  tree.assign_sorted(pairs, pairs + length);
+  return tree;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// ContiguousEdits.hpp
+#ifndef CONTIGUOUSEDITS_H
+#define CONTIGUOUSEDITS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ScanKernels.hpp"
+
+// Element-moving routines over a contiguous run of elements, shared by Vector and SmallVector
+// Trivially copyable elements are moved with memcpy/memmove, other types are moved one by one
+
+// Moves length elements into uninitialized storage, ending the lifetime of the originals
+template <typename T>
+void contiguous_relocate(T* from, size_t length, T* to) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (length > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), length * sizeof(T));
+  } else {
+    for (size_t i = 0; i < length; i++) {
+      new (to + i) T(std::move_if_noexcept(from[i]));
+      from[i].~T();
+    }
+  }
+}
+
+// Inserts count elements read from first before index, shifting the tail back; the storage must have room for them
+template <typename T, typename It>
+void contiguous_insert(T* array, size_t length, size_t index, It first, size_t count) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    std::memmove(static_cast<void*>(array + index + count), static_cast<const void*>(array + index), (length - index) * sizeof(T));
+    for (size_t i = index; i < index + count; i++, ++first) {
+      new (array + i) T(*first);
+    }
+  } else {
+    // Shift the tail back by count, constructing the slots past the old end and assigning the others
+    for (size_t i = length; i-- > index;) {
+      if (i + count >= length) {
+        new (array + i + count) T(std::move(array[i]));
+      } else {
+        array[i + count] = std::move(array[i]);
+      }
+    }
+    for (size_t i = index; i < index + count; i++, ++first) {
+      if (i < length) {
+        array[i] = *first;
+      } else {
+        new (array + i) T(*first);
+      }
+    }
+  }
+}
+
+// Removes the elements [from, to), shifting the tail forward and destroying the vacated slots
+template <typename T>
+void contiguous_erase(T* array, size_t length, size_t from, size_t to) {
+  if (from == to) return;
+
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    std::memmove(static_cast<void*>(array + from), static_cast<const void*>(array + to), (length - to) * sizeof(T));
+  } else {
+    std::move(array + to, array + length, array + from);
+    for (size_t i = length - (to - from); i < length; i++) {
+      array[i].~T();
+    }
+  }
+}
+
+// Removes every element for which pred holds in one pass, keeping the order, and returns the new length
+template <typename T, typename Pred>
+size_t contiguous_erase_if(T* array, size_t length, Pred& pred) {
+  // Keepers are compacted toward the front as they are found, so every element moves at most once
+  size_t kept = 0;
+  for (size_t i = 0; i < length; i++) {
+    if (pred(array[i])) continue;
+
+    if (kept != i) array[kept] = std::move(array[i]);
+    kept++;
+  }
+
+  for (size_t i = kept; i < length; i++) {
+    array[i].~T();
+  }
+  return kept;
+}
+
+// Copies the elements for which pred holds, in order, to uninitialized storage with room for all of them, returning how many
+template <typename T, typename Pred>
+size_t contiguous_filter(const T* array, size_t length, T* out, Pred& pred) {
+  if constexpr (ScanVectorizable<T>::value) {
+    return scan_filter(array, length, out, pred);
+  } else {
+    size_t count = 0;
+    for (size_t i = 0; i < length; i++) {
+      if (pred(array[i])) new (out + count++) T(array[i]);
+    }
+    return count;
+  }
+}
+
+#endif
@@ -0,0 +1,416 @@
+// Deque.hpp
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Number of elements per block, sized so a block spans roughly 512 bytes
+template <typename T>
+constexpr size_t deque_block_size() {
+  return sizeof(T) < 32 ? 512 / sizeof(T) : 16;
+}
+
+// Class representing a double-ended queue stored in a map of fixed-size blocks
+template <typename T>
+class Deque {
+private:
+  static constexpr size_t block_size = deque_block_size<T>();
+
+  T** map;              // Array of pointers to the blocks holding the elements
+  size_t map_size;      // Number of block pointers in the map
+  size_t start;         // Position of the first element counted from the beginning of the first map slot
+  size_t length;        // Number of elements in the deque
+
+  // Private helper function returning the slot of the element at a position
+  T* slot(size_t position) const { return map[position / block_size] + position % block_size; }
+
+  // Private helper function to grow the map, leaving free block slots on the requested side
+  void grow_map(bool at_front);
+
+  // Private helper function to allocate the block holding a position if missing
+  void ensure_block(size_t position);
+
+  // Private helper function to free the block holding a position
+  void release_block(size_t position);
+public:
+  // Constructors and Destructor
+  Deque();                                                  // Default constructor
+  Deque(const Deque<T>&);                                   // Copy constructor
+  Deque(Deque<T>&&) noexcept;                               // Move constructor
+  ~Deque();                                                 // Destructor
+
+  // Assignment
+  Deque<T>& operator=(const Deque<T>&);                     // Copy assignment operator
+  Deque<T>& operator=(Deque<T>&&) noexcept;                 // Move assignment operator
+
+  // Accessors
+  T& operator[](int);                                       // Overloaded subscript operator
+  const T& operator[](int) const;                           // Overloaded const subscript operator
+  T* try_get(int);                                          // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T* try_get(int) const;                              // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
+  T& front();                                               // Returns value at the front of the deque
+  const T& front() const;                                   // Returns value at the front of the deque (const)
+  T& back();                                                // Returns value at the back of the deque
+  const T& back() const;                                    // Returns value at the back of the deque (const)
+  const size_t size() const;                                // Returns the number of elements in the deque
+  const MemoryUsage memory_usage() const;                   // Returns the bytes held by the deque, broken down
+  const bool empty() const;                                 // Checks if the deque is empty
+
+  // Mutators
+  void push_front(const T&);                                // Adds a new element at the front of the deque
+  void push_front(T&&);                                     // Moves a new element to the front of the deque
+  void push_back(const T&);                                 // Adds a new element at the back of the deque
+  void push_back(T&&);                                      // Moves a new element to the back of the deque
+  template <typename... Args>
+  T& emplace_front(Args&&...);                              // Constructs a new element in place at the front of the deque
+  template <typename... Args>
+  T& emplace_back(Args&&...);                               // Constructs a new element in place at the back of the deque
+  void pop_front();                                         // Removes the element at the front of the deque
+  void pop_back();                                          // Removes the element at the back of the deque
+  void clear();                                             // Removes all elements from the deque
+
+  // Utility
+  void print();                                             // Prints all elements in the deque
+
+  // Random-access iterator addressing elements by index, usable with <algorithm> and the parallel algorithms
+  template <typename U>
+  class BasicIterator {
+  private:
+    const Deque<T>* deque;                                  // Pointer to the deque being iterated
+    size_t index;                                           // Index of the current element
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<U>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = U*;
+    using reference = U&;
+
+    // Constructors
+    BasicIterator() : deque(nullptr), index(0) {}
+    BasicIterator(const Deque<T>* deque, size_t index) : deque(deque), index(index) {}
+
+    // Conversion from a mutable to a const iterator
+    operator BasicIterator<const U>() const { return BasicIterator<const U>(deque, index); }
+
+    // Increment and decrement operators
+    BasicIterator& operator++() { ++index; return *this; }
+    BasicIterator operator++(int) { BasicIterator temp = *this; ++index; return temp; }
+    BasicIterator& operator--() { --index; return *this; }
+    BasicIterator operator--(int) { BasicIterator temp = *this; --index; return temp; }
+
+    // Arithmetic operators
+    BasicIterator& operator+=(difference_type n) { index += n; return *this; }
+    BasicIterator& operator-=(difference_type n) { index -= n; return *this; }
+    BasicIterator operator+(difference_type n) const { return BasicIterator(deque, index + n); }
+    BasicIterator operator-(difference_type n) const { return BasicIterator(deque, index - n); }
+    friend BasicIterator operator+(difference_type n, const BasicIterator& it) { return it + n; }
+    friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) { return difference_type(a.index) - difference_type(b.index); }
+
+    // Comparison operators, non-member friends so an Iterator converts when compared with a ConstIterator
+    friend bool operator==(const BasicIterator& a, const BasicIterator& b) { return a.index == b.index; }
+    friend bool operator!=(const BasicIterator& a, const BasicIterator& b) { return a.index != b.index; }
+    friend bool operator<(const BasicIterator& a, const BasicIterator& b) { return a.index < b.index; }
+    friend bool operator>(const BasicIterator& a, const BasicIterator& b) { return a.index > b.index; }
+    friend bool operator<=(const BasicIterator& a, const BasicIterator& b) { return a.index <= b.index; }
+    friend bool operator>=(const BasicIterator& a, const BasicIterator& b) { return a.index >= b.index; }
+
+    // Dereference operators
+    U& operator*() const { return *deque->slot(deque->start + index); }
+    U* operator->() const { return deque->slot(deque->start + index); }
+    U& operator[](difference_type n) const { return *deque->slot(deque->start + index + n); }
+  };
+
+  using Iterator = BasicIterator<T>;
+  using ConstIterator = BasicIterator<const T>;
+
+  // Iterator functions
+  Iterator begin() { return Iterator(this, 0); }                        // Returns an iterator pointing to the first element
+  Iterator end() { return Iterator(this, length); }                     // Returns an iterator pointing to the end (one past last element)
+  ConstIterator begin() const { return ConstIterator(this, 0); }        // Returns a const iterator pointing to the first element
+  ConstIterator end() const { return ConstIterator(this, length); }     // Returns a const iterator pointing to the end (one past last element)
+};
+
+// Function definitions
+template <typename T>
+void Deque<T>::grow_map(bool at_front) {
+  size_t used_first = start / block_size;
+  size_t used_last = length == 0 ? used_first : (start + length - 1) / block_size;
+  size_t used = used_last - used_first + 1;
+
+  // A deque used as a queue drifts towards the back, so the map only doubles when the used blocks fill more than half of it
+  // Otherwise the used blocks are centred in place, leaving both ends room again
+  size_t new_size = map_size < 4 ? 8 : (2 * used > map_size ? map_size * 2 : map_size);
+  size_t offset = (new_size - used) / 2;
+  if (at_front && offset == 0) offset = 1;
+
+  if (new_size == map_size) {
+    for (size_t i = 0; i < map_size; i++) {
+      if (map[i] != nullptr && (i < used_first || i > used_last)) release_block(i * block_size);
+    }
+
+    // Moving towards the front walks forwards and towards the back walks backwards, so no block is overwritten
+    for (size_t k = 0; k < used; k++) {
+      size_t i = offset < used_first ? k : used - 1 - k;
+      T* block = map[used_first + i];
+      map[used_first + i] = nullptr;
+      map[offset + i] = block;
+    }
+  } else {
+    T** new_map = new T*[new_size]();
+    for (size_t i = 0; i < map_size; i++) {
+      if (map[i] == nullptr) continue;
+
+      if (i >= used_first && i <= used_last) {
+        new_map[offset + i - used_first] = map[i];
+      } else {
+        std::allocator<T>().deallocate(map[i], block_size);
+      }
+    }
+
+    delete[] map;
+    map = new_map;
+    map_size = new_size;
+  }
+
+  start = offset * block_size + start % block_size;
+}
+
+template <typename T>
+void Deque<T>::ensure_block(size_t position) {
+  T*& block = map[position / block_size];
+  if (block == nullptr) {
+    block = std::allocator<T>().allocate(block_size);
+  }
+}
+
+template <typename T>
+void Deque<T>::release_block(size_t position) {
+  T*& block = map[position / block_size];
+  std::allocator<T>().deallocate(block, block_size);
+  block = nullptr;
+}
+
+template <typename T>
+Deque<T>::Deque() : map(nullptr), map_size(0), start(0), length(0) {}
+
+template <typename T>
+Deque<T>::Deque(const Deque<T>& other) : map(nullptr), map_size(0), start(0), length(0) {
+  for (auto element = other.begin(); element != other.end(); ++element) {
+    push_back(*element);
+  }
+}
+
+template <typename T>
+Deque<T>::Deque(Deque<T>&& other) noexcept : map(other.map), map_size(other.map_size), start(other.start), length(other.length) {
+  other.map = nullptr;
+  other.map_size = 0;
+  other.start = 0;
+  other.length = 0;
+}
+
+template <typename T>
+Deque<T>::~Deque() {
+  clear();
+  for (size_t i = 0; i < map_size; i++) {
+    if (map[i] != nullptr) std::allocator<T>().deallocate(map[i], block_size);
+  }
+  delete[] map;
+}
+
+template <typename T>
+Deque<T>& Deque<T>::operator=(const Deque<T>& other) {
+  if (this != &other) {
+    Deque<T> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+Deque<T>& Deque<T>::operator=(Deque<T>&& other) noexcept {
+  if (this != &other) {
+    std::swap(map, other.map);
+    std::swap(map_size, other.map_size);
+    std::swap(start, other.start);
+    std::swap(length, other.length);
+  }
+  return *this;
+}
+
+template <typename T>
+T& Deque<T>::operator[](int index) {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  return *slot(start + index);
+}
+
+template <typename T>
+const T& Deque<T>::operator[](int index) const {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  return *slot(start + index);
+}
+
+template <typename T>
+T* Deque<T>::try_get(int index) {
+  if (index < 0 || index >= length) return nullptr;
+
+  return slot(start + index);
+}
+
+template <typename T>
+const T* Deque<T>::try_get(int index) const {
+  if (index < 0 || index >= length) return nullptr;
+
+  return slot(start + index);
+}
+
+template <typename T>
+T& Deque<T>::front() {
+  if (length == 0) throw std::out_of_range("Deque is empty");
+
+  return *slot(start);
+}
+
+template <typename T>
+const T& Deque<T>::front() const {
+  if (length == 0) throw std::out_of_range("Deque is empty");
+
+  return *slot(start);
+}
+
+template <typename T>
+T& Deque<T>::back() {
+  if (length == 0) throw std::out_of_range("Deque is empty");
+
+  return *slot(start + length - 1);
+}
+
+template <typename T>
+const T& Deque<T>::back() const {
+  if (length == 0) throw std::out_of_range("Deque is empty");
+
+  return *slot(start + length - 1);
+}
+
+template <typename T>
+const size_t Deque<T>::size() const {
+  return length;
+}
+
+template <typename T>
+const MemoryUsage Deque<T>::memory_usage() const {
+  size_t blocks = 0;
+  for (size_t i = 0; i < map_size; i++) {
+    if (map[i] != nullptr) blocks++;
+  }
+
+  // Unfilled slots of the allocated blocks are slack, the map is bookkeeping
+  MemoryUsage usage;
+  usage.payload = length * sizeof(T);
+  usage.slack = blocks * block_size * sizeof(T) - usage.payload;
+  usage.overhead = sizeof(*this) + map_size * sizeof(T*);
+  usage.allocations = blocks + (map != nullptr ? 1 : 0);
+  return usage;
+}
+
+template <typename T>
+const bool Deque<T>::empty() const {
+  return length == 0;
+}
+
+template <typename T>
+void Deque<T>::push_front(const T& element) {
+  emplace_front(element);
+}
+
+template <typename T>
+void Deque<T>::push_front(T&& element) {
+  emplace_front(std::move(element));
+}
+
+template <typename T>
+void Deque<T>::push_back(const T& element) {
+  emplace_back(element);
+}
+
+template <typename T>
+void Deque<T>::push_back(T&& element) {
+  emplace_back(std::move(element));
+}
+
+template <typename T>
+template <typename... Args>
+T& Deque<T>::emplace_front(Args&&... args) {
+  if (start == 0) grow_map(true);
+
+  ensure_block(start - 1);
+  T* element = new (slot(start - 1)) T(std::forward<Args>(args)...);
+
+  start--;
+  length++;
+  return *element;
+}
+
+template <typename T>
+template <typename... Args>
+T& Deque<T>::emplace_back(Args&&... args) {
+  if (start + length == map_size * block_size) grow_map(false);
+
+  ensure_block(start + length);
+  T* element = new (slot(start + length)) T(std::forward<Args>(args)...);
+
+  length++;
+  return *element;
+}
+
+template <typename T>
+void Deque<T>::pop_front() {
+  if (length == 0) return;
+
+  slot(start)->~T();
+  start++;
+  length--;
+
+  // Release the front block once its last element is gone
+  if (start % block_size == 0 || length == 0) release_block(start - 1);
+  if (length == 0) start = map_size / 2 * block_size;
+}
+
+template <typename T>
+void Deque<T>::pop_back() {
+  if (length == 0) return;
+
+  size_t position = start + length - 1;
+  slot(position)->~T();
+  length--;
+
+  // Release the back block once its last element is gone
+  if (position % block_size == 0 || length == 0) release_block(position);
+  if (length == 0) start = map_size / 2 * block_size;
+}
+
+template <typename T>
+void Deque<T>::clear() {
+  while (length > 0) {
+    pop_back();
+  }
+}
+
+template <typename T>
+void Deque<T>::print() {
+  for (size_t i = 0; i < length; i++) {
+    std::cout << *slot(start + i) << " ";
+  }
+  std::cout << std::endl;
+}
+
+#endif
@@ -3,58 +3,84 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
 
 // Struct defining a node in doubly linked list
 template <typename T>
-struct ListNode {
-  T value;          // Value stored in the node
-  ListNode* next;   // Pointer to the next node in the list
-  ListNode* prev;   // Pointer to the previous node in the list
+struct DoublyListNode {
+  T value;                // Value stored in the node
+  DoublyListNode* next;   // Pointer to the next node in the list
+  DoublyListNode* prev;   // Pointer to the previous node in the list
   
   T& operator*() { return this->value; }
   const T& operator*() const { return this->value; }
 
-  // Constructor to initialize the node with a value
-  ListNode(T value) : value(value), next(nullptr), prev(nullptr) {}
+  // Constructor to initialize the node by forwarding arguments to the value
+  template <typename... Args>
+  explicit DoublyListNode(Args&&... args) : value(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
 };
 
 // Class representing a doubly linked list
 template <typename T>
 class DoublyLinkedList {
 private:
-  ListNode<T>* head;
-  ListNode<T>* tail;
+  DoublyListNode<T>* head;
+  DoublyListNode<T>* tail;
   size_t list_size;
 
   // Private helper function to get node at a specific index
-  ListNode<T>* get_node_at(int);
-  const ListNode<T>* get_node_at(int) const;
+  DoublyListNode<T>* get_node_at(int);
+  const DoublyListNode<T>* get_node_at(int) const;
 public:
   // Constructors and Destructor
   DoublyLinkedList() : head(nullptr), tail(nullptr), list_size(0) {}
   DoublyLinkedList(const DoublyLinkedList<T>&);
+  DoublyLinkedList(DoublyLinkedList<T>&&) noexcept;
   ~DoublyLinkedList();
 
+  // Assignment
+  DoublyLinkedList<T>& operator=(const DoublyLinkedList<T>&);
+  DoublyLinkedList<T>& operator=(DoublyLinkedList<T>&&) noexcept;
+
   // Accessors
   T& operator[](int);
   const T& operator[](int) const;
+  T* try_get(int);
+  const T* try_get(int) const;
   T& front();
   const T& front() const;
   T& back();
   const T& back() const;
   const size_t size() const;
   const bool empty() const;
+  const MemoryUsage memory_usage() const;
 
   // Mutators
   void push_front(const T&);
+  void push_front(T&&);
   void push_back(const T&);
+  void push_back(T&&);
   void insert(int, const T&);
+  void insert(int, T&&);
+  template <typename... Args>
+  T& emplace_front(Args&&...);
+  template <typename... Args>
+  T& emplace_back(Args&&...);
+  template <typename... Args>
+  T& emplace(int, Args&&...);
   void remove_all(const T&);
   void remove_at(int);
   void pop_front();
   void pop_back();
   void clear();
 
+  // Node-level operations, O(1), for owners that keep pointers to the nodes (e.g. timer buckets)
+  void link_back(DoublyListNode<T>*);               // Appends a detached node, the list taking ownership
+  DoublyListNode<T>* unlink(DoublyListNode<T>*);    // Detaches a node of this list, ownership passing to the caller
+  void splice_back(DoublyLinkedList<T>&);           // Moves every node of another list to the end of this one
+
   // Utility
   const int find(const T&) const;
   const bool contains(const T&) const;
@@ -63,16 +89,16 @@ public:
 
   class Iterator {
   private:
-    ListNode<T>* current;
+    DoublyListNode<T>* current;
   public:
     // Constructor
-    Iterator(ListNode<T>* node) : current(node) { }
+    Iterator(DoublyListNode<T>* node) : current(node) { }
 
     // Dereference operator
     T& operator*() const { return current->value; }
 
     // Get the current node
-    ListNode<T>* get_node() { return current; }
+    DoublyListNode<T>* get_node() { return current; }
 
     // Increment operator
     Iterator& operator++() { current = current->next; return *this; }
@@ -95,12 +121,13 @@ public:
 
 // Function Definitions
 template <typename T>
-ListNode<T>* DoublyLinkedList<T>::get_node_at(int index) {
-  if (index < 0 || index >= list_size) {
+DoublyListNode<T>* DoublyLinkedList<T>::get_node_at(int index) {
+  if (index < 0 || size_t(index) >= list_size) {
     throw std::out_of_range("Index out of range");
   }
 
-  if (list_size - index < list_size/2) {
+  // Walk from whichever end is closer
+  if (size_t(index) < list_size/2) {
     int count = 0;
     for (auto node = begin_head(); node != end(); ++node, ++count) {
       if (count == index)
@@ -118,12 +145,13 @@ ListNode<T>* DoublyLinkedList<T>::get_node_at(int index) {
 }
 
 template <typename T>
-const ListNode<T>* DoublyLinkedList<T>::get_node_at(int index) const {
-  if (index < 0 || index >= list_size) {
+const DoublyListNode<T>* DoublyLinkedList<T>::get_node_at(int index) const {
+  if (index < 0 || size_t(index) >= list_size) {
     throw std::out_of_range("Index out of range");
   }
 
-  if (list_size - index < list_size/2) {
+  // Walk from whichever end is closer
+  if (size_t(index) < list_size/2) {
     int count = 0;
     for (auto node = begin_head(); node != end(); ++node, ++count) {
       if (count == index)
@@ -141,23 +169,17 @@ const ListNode<T>* DoublyLinkedList<T>::get_node_at(int index) const {
 }
 
 template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList<T>& other) : head(nullptr), tail(nullptr) {
-  if (other.head == nullptr) {
-    return;
-  }
-
-  this->head = new ListNode<T>(other.head->value);
-  ListNode<T>* current = this->head;
-  ListNode<T>* temp = other.head->next;
-
-  while (temp != nullptr) {
-    current->next = new ListNode<T>(temp->value);
-    current = current->next;
-    temp = temp->next;
+DoublyLinkedList<T>::DoublyLinkedList(const DoublyLinkedList<T>& other) : head(nullptr), tail(nullptr), list_size(0) {
+  for (auto element = other.begin_head(); element != other.end(); ++element) {
+    push_back(*element);
   }
+}
 
-  this->tail = current;
-  this->size = other.size;
+template <typename T>
+DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList<T>&& other) noexcept : head(other.head), tail(other.tail), list_size(other.list_size) {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.list_size = 0;
 }
 
 template <typename T>
@@ -165,6 +187,26 @@ DoublyLinkedList<T>::~DoublyLinkedList() {
   clear();
 }
 
+template <typename T>
+DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(const DoublyLinkedList<T>& other) {
+  if (this != &other) {
+    DoublyLinkedList<T> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+DoublyLinkedList<T>& DoublyLinkedList<T>::operator=(DoublyLinkedList<T>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(list_size, other.list_size);
+  }
+  return *this;
+}
+
 template <typename T>
 T& DoublyLinkedList<T>::operator[](int index) {
   return this->get_node_at(index)->value; 
@@ -175,6 +217,20 @@ const T& DoublyLinkedList<T>::operator[](int index) const {
   return this->get_node_at(index)->value;
 }
 
+template <typename T>
+T* DoublyLinkedList<T>::try_get(int index) {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  return &this->get_node_at(index)->value;
+}
+
+template <typename T>
+const T* DoublyLinkedList<T>::try_get(int index) const {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  return &this->get_node_at(index)->value;
+}
+
 template <typename T>
 T& DoublyLinkedList<T>::front() {
   // I know the custom dereference operator is a bit confusing 
@@ -202,6 +258,15 @@ const size_t DoublyLinkedList<T>::size() const {
   return list_size;
 }
 
+template <typename T>
+const MemoryUsage DoublyLinkedList<T>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = list_size * sizeof(T);
+  usage.overhead = sizeof(*this) + list_size * (sizeof(DoublyListNode<T>) - sizeof(T));
+  usage.allocations = list_size;
+  return usage;
+}
+
 template <typename T>
 const bool DoublyLinkedList<T>::empty() const {
   return head == nullptr;
@@ -209,66 +274,96 @@ const bool DoublyLinkedList<T>::empty() const {
 
 template <typename T>
 void DoublyLinkedList<T>::push_front(const T& value) {
+  emplace_front(value);
+}
+
+template <typename T>
+void DoublyLinkedList<T>::push_front(T&& value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T>
+void DoublyLinkedList<T>::push_back(const T& value) {
+  emplace_back(value);
+}
+
+template <typename T>
+void DoublyLinkedList<T>::push_back(T&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+void DoublyLinkedList<T>::insert(int index, const T& value) {
+  emplace(index, value);
+}
+
+template <typename T>
+void DoublyLinkedList<T>::insert(int index, T&& value) {
+  emplace(index, std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+T& DoublyLinkedList<T>::emplace_front(Args&&... args) {
+  DoublyListNode<T>* node = new DoublyListNode<T>(std::forward<Args>(args)...);
   list_size++;
-  ListNode<T>* node = new ListNode<T>(value);
 
   if (this->head == nullptr) {
     this->head = node;
     this->tail = node;
-    return;
+    return node->value;
   }
 
   this->head->prev = node;
   node->next = this->head;
   this->head = node;
+  return node->value;
 }
 
 template <typename T>
-void DoublyLinkedList<T>::push_back(const T& value) {
+template <typename... Args>
+T& DoublyLinkedList<T>::emplace_back(Args&&... args) {
+  DoublyListNode<T>* node = new DoublyListNode<T>(std::forward<Args>(args)...);
   list_size++;
-  ListNode<T>* node = new ListNode<T>(value);
 
   if (this->head == nullptr) {
     this->head = node;
     this->tail = node;
-    return;
+    return node->value;
   }
   
   node->prev = this->tail;
   this->tail->next = node;
   this->tail = node;
+  return node->value;
 }
 
 template <typename T>
-void DoublyLinkedList<T>::insert(int index, const T& value) {
-  if (index < 0) {
+template <typename... Args>
+T& DoublyLinkedList<T>::emplace(int index, Args&&... args) {
+  if (index < 0 || index > list_size) {
     throw std::out_of_range("Index out of range");
   }
 
-  list_size++;
-  if (index == 0) {
-    this->push_front(value);
-    return;
-  }
-
-  ListNode<T>* current = get_node_at(index);
-  ListNode<T>* node = new ListNode<T>(value);
-
-  node->next = current->next;
-  node->next->prev = node;
+  if (index == 0) return this->emplace_front(std::forward<Args>(args)...);
+  if (index == list_size) return this->emplace_back(std::forward<Args>(args)...);
 
-  current->next = node;
-  node->prev = current;
+  // Link the new node in front of the node currently at the index
+  DoublyListNode<T>* current = get_node_at(index);
+  DoublyListNode<T>* node = new DoublyListNode<T>(std::forward<Args>(args)...);
+  list_size++;
 
-  if (node->next == nullptr) {
-    this->tail = node;
-  }
+  node->prev = current->prev;
+  node->next = current;
+  current->prev->next = node;
+  current->prev = node;
+  return node->value;
 }
 
 template <typename T>
 void DoublyLinkedList<T>::remove_all(const T& value) {
-  ListNode<T>* current = this->head;
-  ListNode<T>* prev = nullptr;
+  DoublyListNode<T>* current = this->head;
+  DoublyListNode<T>* prev = nullptr;
 
   while (current != nullptr) {
     if (current->value != value) {
@@ -288,8 +383,9 @@ void DoublyLinkedList<T>::remove_all(const T& value) {
     }
 
     if (prev != nullptr) prev->next = current->next;
+    if (current->next != nullptr) current->next->prev = prev;
 
-    ListNode<T>* delete_me = current;
+    DoublyListNode<T>* delete_me = current;
     current = current->next;
     delete delete_me;
 
@@ -310,7 +406,7 @@ void DoublyLinkedList<T>::remove_at(int index) {
     return;
   }
 
-  ListNode<T>* temp = get_node_at(index);
+  DoublyListNode<T>* temp = get_node_at(index);
 
   if (temp == this->tail) {
     pop_back();
@@ -320,17 +416,19 @@ void DoublyLinkedList<T>::remove_at(int index) {
   temp->prev->next = temp->next;
   temp->next->prev = temp->prev;
   delete temp;
+  this->list_size--;
 }
 
 template <typename T>
 void DoublyLinkedList<T>::pop_front() {
   if (this->head == nullptr) return;
 
-  ListNode<T>* temp = this->head;
+  DoublyListNode<T>* temp = this->head;
 
   this->head = this->head->next;
 
   if (this->head == nullptr) this->tail = nullptr;
+  else this->head->prev = nullptr;
 
   if (temp != nullptr) {
     delete temp;
@@ -342,12 +440,12 @@ template <typename T>
 void DoublyLinkedList<T>::pop_back() {
   if (this->tail == nullptr) return;
 
-  ListNode<T>* temp = this->tail;
+  DoublyListNode<T>* temp = this->tail;
 
   this->tail = this->tail->prev;
-  this->tail->next = nullptr;
 
   if (this->tail == nullptr) this->head = nullptr;
+  else this->tail->next = nullptr;
 
   if (temp != nullptr) {
     delete temp;
@@ -357,9 +455,9 @@ void DoublyLinkedList<T>::pop_back() {
 
 template <typename T>
 void DoublyLinkedList<T>::clear() {
-  ListNode<T>* current = this->head;
+  DoublyListNode<T>* current = this->head;
   while (current != nullptr) {
-    ListNode<T>* next = current->next;
+    DoublyListNode<T>* next = current->next;
     delete current;
     current = next;
   }
@@ -369,6 +467,52 @@ void DoublyLinkedList<T>::clear() {
   list_size = 0;
 }
 
+template <typename T>
+void DoublyLinkedList<T>::link_back(DoublyListNode<T>* node) {
+  node->next = nullptr;
+  node->prev = this->tail;
+
+  if (this->tail == nullptr) {
+    this->head = node;
+  } else {
+    this->tail->next = node;
+  }
+  this->tail = node;
+  list_size++;
+}
+
+template <typename T>
+DoublyListNode<T>* DoublyLinkedList<T>::unlink(DoublyListNode<T>* node) {
+  if (node->prev == nullptr) this->head = node->next;
+  else node->prev->next = node->next;
+
+  if (node->next == nullptr) this->tail = node->prev;
+  else node->next->prev = node->prev;
+
+  node->next = nullptr;
+  node->prev = nullptr;
+  list_size--;
+  return node;
+}
+
+template <typename T>
+void DoublyLinkedList<T>::splice_back(DoublyLinkedList<T>& other) {
+  if (this == &other || other.head == nullptr) return;
+
+  if (this->tail == nullptr) {
+    this->head = other.head;
+  } else {
+    this->tail->next = other.head;
+    other.head->prev = this->tail;
+  }
+  this->tail = other.tail;
+  list_size += other.list_size;
+
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.list_size = 0;
+}
+
 template <typename T>
 const int DoublyLinkedList<T>::find(const T& value) const {
   int count = 0;
@@ -4,6 +4,9 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
 
 // Struct defining a node in linked list
 template <typename T>
@@ -11,8 +14,9 @@ struct ListNode {
   T value;          // Value stored in the node
   ListNode* next;   // Pointer to the next node in the list
   
-  // Constructor to initialize the node with a value
-  ListNode(T value) : value(value), next(nullptr) {}
+  // Constructor to initialize the node by forwarding arguments to the value
+  template <typename... Args>
+  explicit ListNode(Args&&... args) : value(std::forward<Args>(args)...), next(nullptr) {}
 };
 
 // Class representing singly linked list
@@ -30,22 +34,39 @@ public:
   // Constructors and Destructor           
   LinkedList() : head(nullptr), tail(nullptr), list_size(0) {}  // Default constructor
   LinkedList(const LinkedList<T>&);                             // Copy constructor
+  LinkedList(LinkedList<T>&&) noexcept;                         // Move constructor
   ~LinkedList();                                                // Destructor
+
+  // Assignment
+  LinkedList<T>& operator=(const LinkedList<T>&);               // Copy assignment operator
+  LinkedList<T>& operator=(LinkedList<T>&&) noexcept;           // Move assignment operator
    
   // Accessors
   T& operator[](int);                                           // Overloaded subscript operator
   const T& operator[](int) const;                               // Overloaded const subscript operator
+  T* try_get(int);                                              // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T* try_get(int) const;                                  // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
   T& front();                                                   // Returns value at the front of the list
   const T& front() const;                                       // Returns value at the front of the list (const)
   T& back();                                                    // Returns value at the back of the list
   const T& back() const;                                        // Returns value at the back of the list (const)
   const size_t size() const;                                    // Returns the number of elements in the list
+  const MemoryUsage memory_usage() const;                       // Returns the bytes held by the list, broken down
   const bool empty() const;                                     // Checks if the list empty
 
   // Mutators
   void push_front(const T&);                                    // Adds a new element at the front of the list
+  void push_front(T&&);                                         // Moves a new element to the front of the list
   void push_back(const T&);                                     // Adds a new element at the back of the list
+  void push_back(T&&);                                          // Moves a new element to the back of the list
   void insert(int, const T&);                                   // Adds a new element at the specified index
+  void insert(int, T&&);                                        // Moves a new element to the specified index
+  template <typename... Args>
+  T& emplace_front(Args&&...);                                  // Constructs a new element in place at the front of the list
+  template <typename... Args>
+  T& emplace_back(Args&&...);                                   // Constructs a new element in place at the back of the list
+  template <typename... Args>
+  T& emplace(int, Args&&...);                                   // Constructs a new element in place at the specified index
   void remove_all(const T&);                                    // Removes all occurances of a value from the list
   void remove_at(int);                                          // Removes the element at specified index
   void pop_front();                                             // Removes the element at the front of the list
@@ -88,7 +109,7 @@ public:
 // Function Definitions
 template <typename T>
 const ListNode<T>* LinkedList<T>::get_node_at(int index) const {
-  if (index < 0) {
+  if (index < 0 || size_t(index) >= list_size) {
     throw std::out_of_range("Index out of range");
   }
   
@@ -104,7 +125,7 @@ const ListNode<T>* LinkedList<T>::get_node_at(int index) const {
 
 template <typename T>
 ListNode<T>* LinkedList<T>::get_node_at(int index){
-  if (index < 0) {
+  if (index < 0 || size_t(index) >= list_size) {
     throw std::out_of_range("Index out of range");
   }
   
@@ -119,7 +140,7 @@ ListNode<T>* LinkedList<T>::get_node_at(int index){
 }
 
 template <typename T>
-LinkedList<T>::LinkedList(const LinkedList<T>& other) : head(nullptr), tail(nullptr) {
+LinkedList<T>::LinkedList(const LinkedList<T>& other) : head(nullptr), tail(nullptr), list_size(0) {
   if (other.head == nullptr) {
     return;
   }
@@ -138,11 +159,38 @@ LinkedList<T>::LinkedList(const LinkedList<T>& other) : head(nullptr), tail(null
   this->list_size = other.list_size;
 }
 
+template <typename T>
+LinkedList<T>::LinkedList(LinkedList<T>&& other) noexcept : head(other.head), tail(other.tail), list_size(other.list_size) {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.list_size = 0;
+}
+
 template <typename T>
 LinkedList<T>::~LinkedList() {
   clear();
 } 
 
+template <typename T>
+LinkedList<T>& LinkedList<T>::operator=(const LinkedList<T>& other) {
+  if (this != &other) {
+    LinkedList<T> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+LinkedList<T>& LinkedList<T>::operator=(LinkedList<T>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(list_size, other.list_size);
+  }
+  return *this;
+}
+
 template <typename T>
 T& LinkedList<T>::operator[](int index) {
   return get_node_at(index)->value;
@@ -153,6 +201,20 @@ const T& LinkedList<T>::operator[](int index) const {
   return get_node_at(index)->value;
 }
 
+template <typename T>
+T* LinkedList<T>::try_get(int index) {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  return &get_node_at(index)->value;
+}
+
+template <typename T>
+const T* LinkedList<T>::try_get(int index) const {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  return &get_node_at(index)->value;
+}
+
 template <typename T>
 T& LinkedList<T>::front() {
   if (this->head == nullptr) {
@@ -194,6 +256,15 @@ const size_t LinkedList<T>::size() const {
   return list_size;
 }
 
+template <typename T>
+const MemoryUsage LinkedList<T>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = list_size * sizeof(T);
+  usage.overhead = sizeof(*this) + list_size * (sizeof(ListNode<T>) - sizeof(T));
+  usage.allocations = list_size;
+  return usage;
+}
+
 template <typename T>
 const bool LinkedList<T>::empty() const {
   return this->head == nullptr;
@@ -201,49 +272,83 @@ const bool LinkedList<T>::empty() const {
 
 template <typename T>
 void LinkedList<T>::push_front(const T& value) {
+  emplace_front(value);
+}
+
+template <typename T>
+void LinkedList<T>::push_front(T&& value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T>
+void LinkedList<T>::push_back(const T& value) {
+  emplace_back(value);
+}
+
+template <typename T>
+void LinkedList<T>::push_back(T&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+void LinkedList<T>::insert(int index, const T& value) {
+  emplace(index, value);
+}
+
+template <typename T>
+void LinkedList<T>::insert(int index, T&& value) {
+  emplace(index, std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+T& LinkedList<T>::emplace_front(Args&&... args) {
+  ListNode<T>* node = new ListNode<T>(std::forward<Args>(args)...);
   list_size++;
-  ListNode<T>* node = new ListNode<T>(value);
   
   if (this->head == nullptr) {
     this->head = node;
     this->tail = node;
-    return;
+    return node->value;
   }
   
   node->next = this->head;
   this->head = node;
+  return node->value;
 }
 
 template <typename T>
-void LinkedList<T>::push_back(const T& value) {
+template <typename... Args>
+T& LinkedList<T>::emplace_back(Args&&... args) {
+  ListNode<T>* node = new ListNode<T>(std::forward<Args>(args)...);
   list_size++;
-  ListNode<T>* node = new ListNode<T>(value);
   
   if (this->head == nullptr) {
     this->head = node;
     this->tail = node;
-    return;
+    return node->value;
   }
   
   this->tail->next = node;
   this->tail = node;
+  return node->value;
 }
 
 template <typename T>
-void LinkedList<T>::insert(int index, const T& value) {
+template <typename... Args>
+T& LinkedList<T>::emplace(int index, Args&&... args) {
   if (index < 0) {
     throw std::out_of_range("Index out of range");
   }
 
-  list_size++;
   if (index == 0) {
-    this->push_front(value);
-    return;
+    return this->emplace_front(std::forward<Args>(args)...);
   }
 
   ListNode<T>* current = get_node_at(index - 1);
   
-  ListNode<T>* node = new ListNode<T>(value);
+  ListNode<T>* node = new ListNode<T>(std::forward<Args>(args)...);
+  list_size++;
 
   node->next = current->next;
   current->next = node;
@@ -251,6 +356,7 @@ void LinkedList<T>::insert(int index, const T& value) {
   if (node->next == nullptr) {
     this->tail = node;
   }
+  return node->value;
 }
 
 template <typename T>
@@ -1,74 +1,115 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-// Include LinkedList header for queue implementation
-#include "LinkedList.hpp"
+// Include Deque header for the default queue implementation
+#include "Deque.hpp"
 
-template <typename T>
+// Container may be any sequence offering push_back/pop_front/front, e.g. Deque or LinkedList
+template <typename T, typename Container = Deque<T>>
 class Queue {
 private:
-  LinkedList<T> list;
+  Container container;
 public:
   // Constructor and Destructor
-  Queue();                      // Default constructor
-  ~Queue();                     // Destructor
+  Queue();                                      // Default constructor
+  Queue(const Queue&) = default;                // Copy constructor
+  Queue(Queue&&) noexcept = default;            // Move constructor
+  ~Queue();                                     // Destructor
+
+  // Assignment
+  Queue& operator=(const Queue&) = default;     // Copy assignment operator
+  Queue& operator=(Queue&&) noexcept = default; // Move assignment operator
 
   // Accessors
   T& front();                   // Access the front item of the queue
   const T& front() const;       // Access the front item of the queue (const)
+  T* try_front();               // Access the front item of the queue, or nullptr if it is empty
+  const T* try_front() const;   // Access the front item of the queue, or nullptr if it is empty (const)
   const bool empty() const;     // Check if the queue is empty
   const int size() const;       // Get the size of the queue
+  const MemoryUsage memory_usage() const;  // Get the bytes held by the queue, broken down
 
   // Mutators
   void push(const T& value);    // Push an item to the back of the queue
+  void push(T&& value);         // Move an item to the back of the queue
+  template <typename... Args>
+  T& emplace(Args&&... args);   // Construct an item in place at the back of the queue
   void pop();                   // Remove the item from the front of the queue
   void clear();                 // Clears the queue
 };
 
 // Function definitions
-template <typename T>
-Queue<T>::Queue() {
+template <typename T, typename Container>
+Queue<T, Container>::Queue() {
 
 }
 
-template <typename T>
-Queue<T>::~Queue() {
+template <typename T, typename Container>
+Queue<T, Container>::~Queue() {
   clear();
 }
 
-template <typename T>
-const T& Queue<T>::front() const {
-  return list.front();
+template <typename T, typename Container>
+const T& Queue<T, Container>::front() const {
+  return container.front();
+}
+
+template <typename T, typename Container>
+T& Queue<T, Container>::front() {
+  return container.front();
+}
+
+template <typename T, typename Container>
+T* Queue<T, Container>::try_front() {
+  return container.empty() ? nullptr : &container.front();
+}
+
+template <typename T, typename Container>
+const T* Queue<T, Container>::try_front() const {
+  return container.empty() ? nullptr : &container.front();
+}
+
+template <typename T, typename Container>
+const bool Queue<T, Container>::empty() const {
+  return container.empty();
+}
+
+template <typename T, typename Container>
+const int Queue<T, Container>::size() const {
+  return container.size();
 }
 
-template <typename T>
-T& Queue<T>::front() {
-  return list.front();
+template <typename T, typename Container>
+const MemoryUsage Queue<T, Container>::memory_usage() const {
+  MemoryUsage usage = container.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(container);
+  return usage;
 }
 
-template <typename T>
-const bool Queue<T>::empty() const {
-  return list.empty();
+template <typename T, typename Container>
+void Queue<T, Container>::push(const T& value) {
+  container.push_back(value);
 }
 
-template <typename T>
-const int Queue<T>::size() const {
-  return list.size();
+template <typename T, typename Container>
+void Queue<T, Container>::push(T&& value) {
+  container.push_back(std::move(value));
 }
 
-template <typename T>
-void Queue<T>::push(const T& value) {
-  list.push_back(value);
+template <typename T, typename Container>
+template <typename... Args>
+T& Queue<T, Container>::emplace(Args&&... args) {
+  return container.emplace_back(std::forward<Args>(args)...);
 }
 
-template <typename T>
-void Queue<T>::pop() {
-  list.pop_front();
+template <typename T, typename Container>
+void Queue<T, Container>::pop() {
+  container.pop_front();
 }
 
-template <typename T>
-void Queue<T>::clear() {
-  list.clear();
+template <typename T, typename Container>
+void Queue<T, Container>::clear() {
+  container.clear();
 }
 
 #endif
@@ -0,0 +1,329 @@
+// ScanKernels.hpp
+#ifndef SCANKERNELS_H
+#define SCANKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Search and aggregate kernels over a contiguous run of elements, shared by Vector and UnrolledLinkedList
+//
+// The vector kernels use GCC/Clang vector extensions on 32-byte blocks, which compile to AVX2 where the CPU has it and to
+// pairs of SSE2 (or NEON) operations otherwise. On x86 builds without -mavx2 every kernel is compiled a second time for
+// AVX2 and picked at runtime; other compilers, and element types the blocks cannot hold, take the scalar loops.
+#if defined(__GNUC__)
+#define SCAN_KERNELS_VECTOR 1
+#define SCAN_KERNELS_INLINE inline __attribute__((always_inline))
+#endif
+
+#if defined(SCAN_KERNELS_VECTOR) && (defined(__x86_64__) || defined(__i386__)) && !defined(__AVX2__)
+#define SCAN_KERNELS_DISPATCH 1
+#define SCAN_KERNELS_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Element types the vector kernels handle
+template <typename T>
+struct ScanVectorizable : std::integral_constant<bool,
+  (std::is_integral<T>::value && !std::is_same<T, bool>::value) || std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+// Type a sum accumulates into: 64 bits for integers, so summing 32-bit values does not overflow, and the type itself otherwise
+template <typename T, typename = void>
+struct ScanSumType { using type = T; };
+
+template <typename T>
+struct ScanSumType<T, std::enable_if_t<std::is_integral<T>::value>> {
+  using type = std::conditional_t<std::is_signed<T>::value, int64_t, uint64_t>;
+};
+
+template <typename T>
+using ScanSum = typename ScanSumType<T>::type;
+
+// Returns whether the CPU running the program has AVX2
+inline bool scan_has_avx2() {
+#if defined(SCAN_KERNELS_DISPATCH)
+  static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+  return avx2;
+#else
+  return false;
+#endif
+}
+
+#if defined(SCAN_KERNELS_VECTOR)
+// Bytes per block; every kernel works on whole blocks and finishes the tail with scalar code
+constexpr size_t scan_block_bytes = 32;
+
+// Struct naming the block types of an element type
+template <typename T>
+struct ScanBlock {
+  typedef T type __attribute__((vector_size(scan_block_bytes)));          // Block of elements
+  typedef T unaligned __attribute__((vector_size(scan_block_bytes), aligned(alignof(T)), may_alias));  // Block read from any element
+  typedef uint64_t bits __attribute__((vector_size(scan_block_bytes)));   // The same bytes as four words, to test a mask
+  static constexpr size_t lanes = scan_block_bytes / sizeof(T);           // Elements per block
+};
+
+// Reads a block of the given unaligned type starting at any element
+#define SCAN_LOAD(Unaligned, pointer) (*reinterpret_cast<const Unaligned*>(pointer))
+
+// Copies a block out to an array of its lanes; reducing through a copy keeps the running block itself in a register
+#define SCAN_STORE(pointer, block) do { auto copy = (block); std::memcpy((pointer), &copy, sizeof(copy)); } while (0)
+
+template <typename T>
+SCAN_KERNELS_INLINE size_t scan_find_kernel(const T* data, size_t n, T value) {
+  typedef typename ScanBlock<T>::type Block;
+  typedef typename ScanBlock<T>::unaligned Unaligned;
+  typedef typename ScanBlock<T>::bits Bits;
+  constexpr size_t lanes = ScanBlock<T>::lanes;
+
+  // Four blocks are compared per step; the step holding the first match is then searched element by element
+  size_t i = 0;
+  for (; i + 4 * lanes <= n; i += 4 * lanes) {
+    Block a = SCAN_LOAD(Unaligned, data + i);
+    Block b = SCAN_LOAD(Unaligned, data + i + lanes);
+    Block c = SCAN_LOAD(Unaligned, data + i + 2 * lanes);
+    Block d = SCAN_LOAD(Unaligned, data + i + 3 * lanes);
+
+    Bits hits = (Bits)((a == value) | (b == value) | (c == value) | (d == value));
+    if ((hits[0] | hits[1] | hits[2] | hits[3]) != 0) break;
+  }
+
+  for (; i < n; i++) {
+    if (data[i] == value) return i;
+  }
+  return n;
+}
+
+template <typename T>
+SCAN_KERNELS_INLINE size_t scan_count_kernel(const T* data, size_t n, T value) {
+  typedef typename ScanBlock<T>::type Block;
+  typedef typename ScanBlock<T>::unaligned Unaligned;
+  typedef decltype(Block() == Block()) Mask;
+  constexpr size_t lanes = ScanBlock<T>::lanes;
+
+  // A match sets its mask lane to -1, so the lane counters run down by one per match; they are folded into the
+  // total every 127 blocks, before an 8-bit lane could wrap
+  size_t total = 0;
+  size_t i = 0;
+  while (i + lanes <= n) {
+    size_t blocks = (n - i) / lanes < 127 ? (n - i) / lanes : 127;
+    Mask counts = {};
+    for (size_t block = 0; block < blocks; block++, i += lanes) {
+      Block a = SCAN_LOAD(Unaligned, data + i);
+      counts += a == value;
+    }
+
+    std::remove_reference_t<decltype(counts[0])> lane_counts[lanes];
+    SCAN_STORE(lane_counts, counts);
+    for (size_t lane = 0; lane < lanes; lane++) {
+      total += size_t(-int64_t(lane_counts[lane]));
+    }
+  }
+
+  for (; i < n; i++) {
+    total += data[i] == value;
+  }
+  return total;
+}
+
+// Returns the smallest (or with Largest the largest) element of a non-empty run
+template <typename T, bool Largest>
+SCAN_KERNELS_INLINE T scan_extreme_kernel(const T* data, size_t n) {
+  typedef typename ScanBlock<T>::type Block;
+  typedef typename ScanBlock<T>::unaligned Unaligned;
+  constexpr size_t lanes = ScanBlock<T>::lanes;
+
+  // Two running blocks, so consecutive blocks do not wait on each other
+  T best = data[0];
+  size_t i = 0;
+  if (n >= lanes) {
+    Block first = SCAN_LOAD(Unaligned, data);
+    Block second = first;
+    for (i = lanes; i + 2 * lanes <= n; i += 2 * lanes) {
+      Block a = SCAN_LOAD(Unaligned, data + i);
+      Block b = SCAN_LOAD(Unaligned, data + i + lanes);
+      if constexpr (Largest) {
+        first = a > first ? a : first;
+        second = b > second ? b : second;
+      } else {
+        first = a < first ? a : first;
+        second = b < second ? b : second;
+      }
+    }
+    if constexpr (Largest) {
+      first = second > first ? second : first;
+    } else {
+      first = second < first ? second : first;
+    }
+
+    T lane_best[lanes];
+    SCAN_STORE(lane_best, first);
+    best = lane_best[0];
+    for (size_t lane = 1; lane < lanes; lane++) {
+      if (Largest ? lane_best[lane] > best : lane_best[lane] < best) best = lane_best[lane];
+    }
+  }
+
+  for (; i < n; i++) {
+    if (Largest ? data[i] > best : data[i] < best) best = data[i];
+  }
+  return best;
+}
+
+template <typename T>
+SCAN_KERNELS_INLINE ScanSum<T> scan_sum_kernel(const T* data, size_t n) {
+  // Each block of elements is widened to a block of accumulators; two accumulators hide the latency of the adds
+  typedef ScanSum<T> Sum;
+  typedef Sum Sums __attribute__((vector_size(scan_block_bytes)));
+  constexpr size_t lanes = scan_block_bytes / sizeof(Sum);
+  typedef T Narrow __attribute__((vector_size(lanes * sizeof(T)), aligned(alignof(T)), may_alias));
+
+  Sums first = {};
+  Sums second = {};
+  size_t i = 0;
+  for (; i + 2 * lanes <= n; i += 2 * lanes) {
+    first += __builtin_convertvector(SCAN_LOAD(Narrow, data + i), Sums);
+    second += __builtin_convertvector(SCAN_LOAD(Narrow, data + i + lanes), Sums);
+  }
+
+  first += second;
+  Sum lane_sums[lanes];
+  SCAN_STORE(lane_sums, first);
+  Sum total = 0;
+  for (size_t lane = 0; lane < lanes; lane++) {
+    total += lane_sums[lane];
+  }
+  for (; i < n; i++) {
+    total += data[i];
+  }
+  return total;
+}
+
+#undef SCAN_LOAD
+#undef SCAN_STORE
+
+#if defined(SCAN_KERNELS_DISPATCH)
+// The same kernels compiled for AVX2
+template <typename T>
+SCAN_KERNELS_AVX2 size_t scan_find_avx2(const T* data, size_t n, T value) { return scan_find_kernel(data, n, value); }
+
+template <typename T>
+SCAN_KERNELS_AVX2 size_t scan_count_avx2(const T* data, size_t n, T value) { return scan_count_kernel(data, n, value); }
+
+template <typename T, bool Largest>
+SCAN_KERNELS_AVX2 T scan_extreme_avx2(const T* data, size_t n) { return scan_extreme_kernel<T, Largest>(data, n); }
+
+template <typename T>
+SCAN_KERNELS_AVX2 ScanSum<T> scan_sum_avx2(const T* data, size_t n) { return scan_sum_kernel(data, n); }
+#endif
+#endif
+
+// Returns the index of the first element equal to value, or n if there is none
+template <typename T>
+size_t scan_find(const T* data, size_t n, const T& value) {
+#if defined(SCAN_KERNELS_VECTOR)
+  if constexpr (ScanVectorizable<T>::value) {
+#if defined(SCAN_KERNELS_DISPATCH)
+    if (scan_has_avx2()) return scan_find_avx2(data, n, value);
+#endif
+    return scan_find_kernel(data, n, value);
+  }
+#endif
+
+  for (size_t i = 0; i < n; i++) {
+    if (data[i] == value) return i;
+  }
+  return n;
+}
+
+// Returns how many elements equal value
+template <typename T>
+size_t scan_count(const T* data, size_t n, const T& value) {
+#if defined(SCAN_KERNELS_VECTOR)
+  if constexpr (ScanVectorizable<T>::value) {
+#if defined(SCAN_KERNELS_DISPATCH)
+    if (scan_has_avx2()) return scan_count_avx2(data, n, value);
+#endif
+    return scan_count_kernel(data, n, value);
+  }
+#endif
+
+  size_t total = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (data[i] == value) total++;
+  }
+  return total;
+}
+
+// Returns the smallest element of a non-empty run (unspecified if it holds a NaN)
+template <typename T>
+T scan_min(const T* data, size_t n) {
+#if defined(SCAN_KERNELS_VECTOR)
+  if constexpr (ScanVectorizable<T>::value) {
+#if defined(SCAN_KERNELS_DISPATCH)
+    if (scan_has_avx2()) return scan_extreme_avx2<T, false>(data, n);
+#endif
+    return scan_extreme_kernel<T, false>(data, n);
+  }
+#endif
+
+  const T* best = data;
+  for (size_t i = 1; i < n; i++) {
+    if (data[i] < *best) best = data + i;
+  }
+  return *best;
+}
+
+// Returns the largest element of a non-empty run (unspecified if it holds a NaN)
+template <typename T>
+T scan_max(const T* data, size_t n) {
+#if defined(SCAN_KERNELS_VECTOR)
+  if constexpr (ScanVectorizable<T>::value) {
+#if defined(SCAN_KERNELS_DISPATCH)
+    if (scan_has_avx2()) return scan_extreme_avx2<T, true>(data, n);
+#endif
+    return scan_extreme_kernel<T, true>(data, n);
+  }
+#endif
+
+  const T* best = data;
+  for (size_t i = 1; i < n; i++) {
+    if (*best < data[i]) best = data + i;
+  }
+  return *best;
+}
+
+// Returns the sum of every element; floating point sums are added in blocks, so rounding can differ from a left-to-right loop
+template <typename T>
+ScanSum<T> scan_sum(const T* data, size_t n) {
+#if defined(SCAN_KERNELS_VECTOR)
+  if constexpr (ScanVectorizable<T>::value) {
+#if defined(SCAN_KERNELS_DISPATCH)
+    if (scan_has_avx2()) return scan_sum_avx2(data, n);
+#endif
+    return scan_sum_kernel(data, n);
+  }
+#endif
+
+  ScanSum<T> total = ScanSum<T>();
+  for (size_t i = 0; i < n; i++) {
+    total += data[i];
+  }
+  return total;
+}
+
+// Copies the elements for which pred holds to out, which must have room for n, and returns how many were copied
+// Every element is written and the output index advanced by the predicate, so the loop has no branch to mispredict
+template <typename T, typename Pred>
+size_t scan_filter(const T* data, size_t n, T* out, Pred pred) {
+  static_assert(ScanVectorizable<T>::value, "scan_filter writes to raw storage, so it takes arithmetic types only");
+
+  size_t kept = 0;
+  for (size_t i = 0; i < n; i++) {
+    T value = data[i];
+    out[kept] = value;
+    kept += pred(value) ? 1 : 0;
+  }
+  return kept;
+}
+
+#endif
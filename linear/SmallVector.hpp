@@ -0,0 +1,430 @@
+// SmallVector.hpp
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <stdexcept>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+#include "ContiguousEdits.hpp"
+#include "ScanKernels.hpp"
+#include "Vector.hpp"
+
+// Class representing a dynamic array that keeps up to N elements inline before spilling to the heap
+// It offers the interface of Vector, sharing its iterators and the element-moving routines of ContiguousEdits.hpp
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+private:
+  alignas(T) unsigned char buffer[N * sizeof(T)];  // Inline storage used until the vector outgrows N elements
+  T* array;             // Pointer to the active storage, either the inline buffer or a heap block
+  size_t length;        // Number of elements in the vector
+  size_t capacity;      // Capacity of the active storage
+
+  // Private helper functions for the inline buffer
+  T* inline_data() { return reinterpret_cast<T*>(buffer); }
+  const bool is_inline() const { return array == reinterpret_cast<const T*>(buffer); }
+
+  // Private helper function to move the elements into a heap block of at least the given capacity
+  void grow(size_t);
+
+  // Private helper function to move the elements back inline, or into a heap block just large enough
+  void shrink();
+
+  // Private helper function to destroy all elements and release any heap block
+  void release();
+
+  // Private helper function to take over the elements of another vector
+  void steal(SmallVector<T, N>&);
+public:
+  // Constructors and Destructor
+  SmallVector();                                            // Default constructor
+  SmallVector(const SmallVector<T, N>&);                    // Copy constructor
+  SmallVector(SmallVector<T, N>&&) noexcept;                // Move constructor
+  ~SmallVector();                                           // Destructor
+
+  // Assignment
+  SmallVector<T, N>& operator=(const SmallVector<T, N>&);       // Copy assignment operator
+  SmallVector<T, N>& operator=(SmallVector<T, N>&&) noexcept;   // Move assignment operator
+
+  // Accessors
+  T& operator[](int);                                       // Overloaded subscript operator
+  const T& operator[](int) const;                           // Overloaded const subscript operator
+  T* try_get(int);                                          // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T* try_get(int) const;                              // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
+  const size_t size() const;                                // Returns the number of elements in the vector
+  const size_t current_capacity() const;                    // Returns the current capacity of the vector
+  const MemoryUsage memory_usage() const;                   // Returns the bytes held by the vector, broken down
+  const bool on_heap() const;                               // Returns if the elements have spilled to the heap
+
+  // Mutators
+  void push_back(const T&);                                 // Adds a new element at the end of the vector
+  void push_back(T&&);                                      // Moves a new element to the end of the vector
+  template <typename... Args>
+  T& emplace_back(Args&&...);                               // Constructs a new element in place at the end of the vector
+  void pop_back();                                          // Removes the last element of the vector
+  void insert(int, const T&);                               // Inserts a new element at the specified index
+  void insert(int, T&&);                                    // Moves a new element to the specified index
+  template <typename... Args>
+  T& emplace(int, Args&&...);                               // Constructs a new element in place at the specified index
+  void swap_remove(int);                                    // Removes the element at an index by moving the last element into its place (O(1), unordered)
+  template <typename Pred>
+  size_t erase_if(Pred);                                    // Removes every element for which pred holds in one pass, keeping the order, and returns how many
+
+  // Utility
+  const int find(const T&) const;                           // Finds the index of the first occurance of a value
+  const bool contains(const T&) const;                      // Checks if the vector contains a specific value
+  const size_t count(const T&) const;                       // Returns how many elements equal a value
+  const T min() const;                                      // Returns the smallest element
+  const T max() const;                                      // Returns the largest element
+  const ScanSum<T> sum() const;                             // Returns the sum of every element (64-bit for integers)
+  template <typename Pred>
+  SmallVector<T, N> filter(Pred) const;                     // Returns the elements for which pred holds, in order
+  void print();                                             // Prints all elements in the vector
+
+  // Random-access iterators, the same types as Vector's
+  using Iterator = typename Vector<T>::Iterator;
+  using ConstIterator = typename Vector<T>::ConstIterator;
+
+  // Iterator functions
+  Iterator begin() { return Iterator(array); }                      // Returns an iterator pointing to the first element
+  Iterator end() { return Iterator(array + length); }               // Returns an iterator pointing to the end (one past last element)
+  ConstIterator begin() const { return ConstIterator(array); }      // Returns a const iterator pointing to the first element
+  ConstIterator end() const { return ConstIterator(array + length); } // Returns a const iterator pointing to the end (one past last element)
+
+  // Raw access to the contiguous storage
+  T* data() { return array; }
+  const T* data() const { return array; }
+
+  // Iterator-based mutators, each shifting the tail once
+  Iterator erase(ConstIterator);                            // Removes an element, returning an iterator to the element after it
+  Iterator erase(ConstIterator, ConstIterator);             // Removes a range, returning an iterator to the element after it
+  template <typename It>
+  Iterator insert(ConstIterator, It, It);                   // Inserts a range (not from this vector) before an element, returning an iterator to the first inserted
+};
+
+// Function definitions
+template <typename T, size_t N>
+void SmallVector<T, N>::grow(size_t minimum) {
+  size_t new_capacity = capacity * 2;
+  if (new_capacity < minimum) new_capacity = minimum;
+
+  T* copy = std::allocator<T>().allocate(new_capacity);
+  contiguous_relocate(array, length, copy);
+
+  if (!is_inline()) std::allocator<T>().deallocate(array, capacity);
+  array = copy;
+  capacity = new_capacity;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::shrink() {
+  if (is_inline() || capacity == length) return;
+
+  T* target = length <= N ? inline_data() : std::allocator<T>().allocate(length);
+  contiguous_relocate(array, length, target);
+
+  std::allocator<T>().deallocate(array, capacity);
+  array = target;
+  capacity = length <= N ? N : length;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::release() {
+  for (size_t i = 0; i < length; i++) {
+    array[i].~T();
+  }
+  if (!is_inline()) std::allocator<T>().deallocate(array, capacity);
+
+  array = inline_data();
+  length = 0;
+  capacity = N;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::steal(SmallVector<T, N>& other) {
+  // Heap blocks change owner in O(1); inline elements have to be moved one by one
+  if (!other.is_inline()) {
+    array = other.array;
+    length = other.length;
+    capacity = other.capacity;
+    other.array = other.inline_data();
+    other.length = 0;
+    other.capacity = N;
+    return;
+  }
+
+  for (; length < other.length; length++) {
+    new (array + length) T(std::move(other.array[length]));
+  }
+  other.release();
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector() : array(inline_data()), length(0), capacity(N) {}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector<T, N>& other) : array(inline_data()), length(0), capacity(N) {
+  if (other.length > N) grow(other.length);
+  for (; length < other.length; length++) {
+    new (array + length) T(other.array[length]);
+  }
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector<T, N>&& other) noexcept : array(inline_data()), length(0), capacity(N) {
+  steal(other);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::~SmallVector() {
+  release();
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector<T, N>& other) {
+  if (this != &other) {
+    SmallVector<T, N> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector<T, N>&& other) noexcept {
+  if (this != &other) {
+    release();
+    steal(other);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+T& SmallVector<T, N>::operator[](int index) {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  return array[index];
+}
+
+template <typename T, size_t N>
+const T& SmallVector<T, N>::operator[](int index) const {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  return array[index];
+}
+
+template <typename T, size_t N>
+T* SmallVector<T, N>::try_get(int index) {
+  if (index < 0 || index >= length) return nullptr;
+
+  return &array[index];
+}
+
+template <typename T, size_t N>
+const T* SmallVector<T, N>::try_get(int index) const {
+  if (index < 0 || index >= length) return nullptr;
+
+  return &array[index];
+}
+
+template <typename T, size_t N>
+const size_t SmallVector<T, N>::size() const {
+  return length;
+}
+
+template <typename T, size_t N>
+const size_t SmallVector<T, N>::current_capacity() const {
+  return capacity;
+}
+
+template <typename T, size_t N>
+const MemoryUsage SmallVector<T, N>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = length * sizeof(T);
+  usage.overhead = sizeof(*this) - sizeof(buffer);
+
+  // Once on the heap, the whole inline buffer is slack
+  if (is_inline()) {
+    usage.slack = (N - length) * sizeof(T);
+  } else {
+    usage.slack = (capacity - length) * sizeof(T) + sizeof(buffer);
+    usage.allocations = 1;
+  }
+  return usage;
+}
+
+template <typename T, size_t N>
+const bool SmallVector<T, N>::on_heap() const {
+  return !is_inline();
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::push_back(const T& element) {
+  emplace_back(element);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::push_back(T&& element) {
+  emplace_back(std::move(element));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& SmallVector<T, N>::emplace_back(Args&&... args) {
+  if (length == capacity) {
+    // Build the element first so arguments referring into the array survive the spill
+    T element(std::forward<Args>(args)...);
+    grow(length + 1);
+    return *new (array + length++) T(std::move(element));
+  }
+
+  return *new (array + length++) T(std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::pop_back() {
+  if (length > 0) array[--length].~T();
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::insert(int index, const T& element) {
+  emplace(index, element);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::insert(int index, T&& element) {
+  emplace(index, std::move(element));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& SmallVector<T, N>::emplace(int index, Args&&... args) {
+  if (index < 0 || index > length) throw std::out_of_range("Index out of range");
+
+  if (index == length) return emplace_back(std::forward<Args>(args)...);
+
+  T element(std::forward<Args>(args)...);
+  if (length == capacity) grow(length + 1);
+
+  contiguous_insert(array, length, size_t(index), std::make_move_iterator(&element), 1);
+  ++length;
+  return array[index];
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::swap_remove(int index) {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  if (size_t(index) != length - 1) array[index] = std::move(array[length - 1]);
+  array[--length].~T();
+}
+
+template <typename T, size_t N>
+template <typename Pred>
+size_t SmallVector<T, N>::erase_if(Pred pred) {
+  size_t kept = contiguous_erase_if(array, length, pred);
+  size_t removed = length - kept;
+  length = kept;
+  return removed;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::Iterator SmallVector<T, N>::erase(ConstIterator position) {
+  return erase(position, position + 1);
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::Iterator SmallVector<T, N>::erase(ConstIterator first, ConstIterator last) {
+  size_t from = size_t(first - ConstIterator(array));
+  size_t to = size_t(last - ConstIterator(array));
+  if (from > to || to > length) throw std::out_of_range("Index out of range");
+
+  contiguous_erase(array, length, from, to);
+  length -= to - from;
+  return Iterator(array + from);
+}
+
+template <typename T, size_t N>
+template <typename It>
+typename SmallVector<T, N>::Iterator SmallVector<T, N>::insert(ConstIterator position, It first, It last) {
+  size_t index = size_t(position - ConstIterator(array));
+  if (index > length) throw std::out_of_range("Index out of range");
+
+  // A single-pass range has to be collected before its size is known
+  if constexpr (!std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value) {
+    SmallVector<T, N> items;
+    for (; first != last; ++first) {
+      items.push_back(*first);
+    }
+    return insert(ConstIterator(array + index), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+  } else {
+    size_t count = size_t(std::distance(first, last));
+    if (count == 0) return Iterator(array + index);
+
+    if (length + count > capacity) grow(length + count);
+    contiguous_insert(array, length, index, first, count);
+    length += count;
+    return Iterator(array + index);
+  }
+}
+
+// The scans below run the block kernels of ScanKernels.hpp for arithmetic types and plain loops otherwise
+template <typename T, size_t N>
+const int SmallVector<T, N>::find(const T& value) const {
+  size_t index = scan_find(array, length, value);
+  return index == length ? -1 : int(index);
+}
+
+template <typename T, size_t N>
+const bool SmallVector<T, N>::contains(const T& value) const {
+  return scan_find(array, length, value) != length;
+}
+
+template <typename T, size_t N>
+const size_t SmallVector<T, N>::count(const T& value) const {
+  return scan_count(array, length, value);
+}
+
+template <typename T, size_t N>
+const T SmallVector<T, N>::min() const {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  return scan_min(array, length);
+}
+
+template <typename T, size_t N>
+const T SmallVector<T, N>::max() const {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  return scan_max(array, length);
+}
+
+template <typename T, size_t N>
+const ScanSum<T> SmallVector<T, N>::sum() const {
+  return scan_sum(array, length);
+}
+
+template <typename T, size_t N>
+template <typename Pred>
+SmallVector<T, N> SmallVector<T, N>::filter(Pred pred) const {
+  // Room for every element up front, then give back what a selective filter left unused
+  SmallVector<T, N> result;
+  if (length > N) result.grow(length);
+  result.length = contiguous_filter(array, length, result.array, pred);
+  result.shrink();
+  return result;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::print() {
+  for (size_t i = 0; i < length; i++) {
+      std::cout << array[i] << " ";
+  }
+  std::cout << std::endl;
+}
+
+#endif
@@ -0,0 +1,372 @@
+// SnapshotVector.hpp
+#ifndef SNAPSHOTVECTOR_H
+#define SNAPSHOTVECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+#include "Vector.hpp"
+
+// Number of elements per chunk: the largest power of two fitting in 1 KB (at least 4), so an index splits with a shift and a mask
+template <typename T>
+constexpr size_t snapshot_chunk_capacity() {
+  size_t capacity = 4;
+  while (capacity * 2 * sizeof(T) <= 1024) capacity *= 2;
+  return capacity;
+}
+
+// Struct defining a fixed-size block of elements, shared by every snapshot that has not written to it
+template <typename T, size_t N>
+struct SnapshotChunk {
+  alignas(T) unsigned char storage[N * sizeof(T)];  // Raw storage for up to N elements
+  size_t count;                                     // Number of constructed elements in the chunk
+  std::atomic<size_t> references;                   // Number of spines pointing at the chunk
+
+  SnapshotChunk() : count(0), references(1) {}
+  ~SnapshotChunk() { while (count > 0) data()[--count].~T(); }
+
+  T* data() { return reinterpret_cast<T*>(storage); }
+  const T* data() const { return reinterpret_cast<const T*>(storage); }
+};
+
+// Struct defining the array of chunk pointers, shared by every snapshot that has not changed its shape
+template <typename T, size_t N>
+struct SnapshotSpine {
+  Vector<SnapshotChunk<T, N>*> chunks;  // Chunks in index order, all full except the last
+  std::atomic<size_t> references;       // Number of vectors pointing at the spine
+
+  SnapshotSpine() : chunks(), references(1) {}
+};
+
+// Class representing a dynamic array whose copies are O(1) snapshots sharing its storage
+// Elements live in fixed-size chunks behind a spine of chunk pointers, both reference counted
+// A mutation first copies whatever it touches that is still shared (the spine and one chunk, O(N) at most), so writers never disturb readers
+// Distinct vectors may be used from different threads even while they share chunks; one vector needs a lock like any other container
+// References obtained from a vector stay valid until it is next mutated
+template <typename T, size_t N = snapshot_chunk_capacity<T>()>
+class SnapshotVector {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SnapshotVector needs a power of two elements per chunk");
+private:
+  using Chunk = SnapshotChunk<T, N>;
+  using Spine = SnapshotSpine<T, N>;
+
+  Spine* spine;         // Spine of this vector, nullptr while it is empty
+  size_t length;        // Number of elements in the vector
+
+  // Private helper functions
+  static void release(Chunk*);                              // Drops a reference to a chunk, deleting it with the last one
+  void release_spine();                                     // Drops this vector's reference to its spine, releasing its chunks with the last one
+  void own_spine();                                         // Gives this vector a spine of its own, copying a shared one
+  Chunk* own_chunk(size_t, Chunk*&);                        // Gives this vector a chunk of its own, copying a shared one (the old chunk is handed back to release)
+public:
+  // Constructors and Destructor
+  SnapshotVector() : spine(nullptr), length(0) {}          // Default constructor
+  SnapshotVector(const SnapshotVector<T, N>&);              // Copy constructor, O(1): the copy shares every chunk
+  SnapshotVector(SnapshotVector<T, N>&&) noexcept;          // Move constructor
+  ~SnapshotVector();                                        // Destructor
+
+  // Assignment
+  SnapshotVector<T, N>& operator=(const SnapshotVector<T, N>&);     // Copy assignment operator, O(1)
+  SnapshotVector<T, N>& operator=(SnapshotVector<T, N>&&) noexcept; // Move assignment operator
+
+  // Accessors
+  const T& operator[](int) const;                           // Overloaded const subscript operator
+  T& operator[](int);                                       // Overloaded subscript operator, copying the element's chunk if it is shared
+  const T* try_get(int) const;                              // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T& back() const;                                    // Returns the last element of the vector
+  const size_t size() const { return length; }              // Returns the number of elements in the vector
+  const bool empty() const { return length == 0; }          // Returns if the vector has no elements
+  const bool shares_storage_with(const SnapshotVector<T, N>& other) const { return spine != nullptr && spine == other.spine; }  // Returns if two vectors still share their spine
+  const MemoryUsage memory_usage() const;                   // Returns the bytes reachable from this vector, broken down (chunks shared with snapshots are counted in each)
+
+  // Mutators
+  void push_back(const T&);                                 // Adds a new element at the end of the vector
+  void push_back(T&&);                                      // Moves a new element to the end of the vector
+  template <typename... Args>
+  T& emplace_back(Args&&...);                               // Constructs a new element in place at the end of the vector
+  void pop_back();                                          // Removes the last element of the vector
+  void clear();                                             // Removes every element
+
+  // Utility
+  SnapshotVector<T, N> snapshot() const { return *this; }   // Returns a read-only copy of this vector in O(1)
+  template <typename Fn>
+  void for_each_chunk(Fn) const;                            // Calls fn(pointer, count) on every chunk in order, e.g. to run the scan kernels
+
+  // Const forward iterator, walking a chunk with a plain pointer before moving to the next
+  class ConstIterator {
+  private:
+    Chunk* const* chunk;
+    Chunk* const* last;
+    const T* item;
+    const T* stop;
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    ConstIterator() : chunk(nullptr), last(nullptr), item(nullptr), stop(nullptr) {}
+    ConstIterator(Chunk* const* chunk, Chunk* const* last, bool at_end)
+      : chunk(chunk), last(last), item((*chunk)->data()), stop(item + (*chunk)->count) {
+      if (at_end) item = stop;
+    }
+    reference operator*() const { return *item; }
+    pointer operator->() const { return item; }
+    ConstIterator& operator++() {
+      // The last chunk's end doubles as the end iterator, so the walk stops there
+      if (++item == stop && chunk + 1 != last) {
+        ++chunk;
+        item = (*chunk)->data();
+        stop = item + (*chunk)->count;
+      }
+      return *this;
+    }
+    ConstIterator operator++(int) { ConstIterator previous = *this; ++*this; return previous; }
+    bool operator==(const ConstIterator& other) const { return item == other.item; }
+    bool operator!=(const ConstIterator& other) const { return item != other.item; }
+  };
+
+  ConstIterator begin() const { return length == 0 ? ConstIterator() : ConstIterator(spine->chunks.data(), spine->chunks.data() + spine->chunks.size(), false); }
+  ConstIterator end() const { return length == 0 ? ConstIterator() : ConstIterator(spine->chunks.data() + spine->chunks.size() - 1, spine->chunks.data() + spine->chunks.size(), true); }
+};
+
+// Function definitions
+template <typename T, size_t N>
+void SnapshotVector<T, N>::release(Chunk* chunk) {
+  // The release half orders this owner's reads before the delete, the acquire half orders the delete after every other owner's
+  if (chunk != nullptr && chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete chunk;
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::release_spine() {
+  if (spine == nullptr) return;
+
+  if (spine->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Chunk** chunks = spine->chunks.data();
+    for (size_t i = 0; i < spine->chunks.size(); i++) {
+      release(chunks[i]);
+    }
+    delete spine;
+  }
+  spine = nullptr;
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::own_spine() {
+  if (spine == nullptr) {
+    spine = new Spine();
+    return;
+  }
+
+  // A count of one can only rise again through this vector, so the acquire load alone proves the spine is ours
+  if (spine->references.load(std::memory_order_acquire) == 1) return;
+
+  std::unique_ptr<Spine> copy(new Spine());
+  copy->chunks = spine->chunks;
+  Chunk** chunks = copy->chunks.data();
+  for (size_t i = 0; i < copy->chunks.size(); i++) {
+    chunks[i]->references.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  release_spine();
+  spine = copy.release();
+}
+
+template <typename T, size_t N>
+SnapshotChunk<T, N>* SnapshotVector<T, N>::own_chunk(size_t index, Chunk*& retired) {
+  own_spine();
+  Chunk*& chunk = spine->chunks.data()[index];
+  retired = nullptr;
+  if (chunk->references.load(std::memory_order_acquire) == 1) return chunk;
+
+  // A partly built copy destroys the elements it already holds
+  std::unique_ptr<Chunk> copy(new Chunk());
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    std::memcpy(static_cast<void*>(copy->data()), static_cast<const void*>(chunk->data()), chunk->count * sizeof(T));
+    copy->count = chunk->count;
+  } else {
+    for (; copy->count < chunk->count; copy->count++) {
+      new (copy->data() + copy->count) T(chunk->data()[copy->count]);
+    }
+  }
+
+  // The old chunk is only released by the caller, as an argument may still point into it
+  retired = chunk;
+  chunk = copy.release();
+  return chunk;
+}
+
+template <typename T, size_t N>
+SnapshotVector<T, N>::SnapshotVector(const SnapshotVector<T, N>& other) : spine(other.spine), length(other.length) {
+  if (spine != nullptr) spine->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T, size_t N>
+SnapshotVector<T, N>::SnapshotVector(SnapshotVector<T, N>&& other) noexcept : spine(other.spine), length(other.length) {
+  other.spine = nullptr;
+  other.length = 0;
+}
+
+template <typename T, size_t N>
+SnapshotVector<T, N>::~SnapshotVector() {
+  release_spine();
+}
+
+template <typename T, size_t N>
+SnapshotVector<T, N>& SnapshotVector<T, N>::operator=(const SnapshotVector<T, N>& other) {
+  if (this != &other) {
+    SnapshotVector<T, N> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+SnapshotVector<T, N>& SnapshotVector<T, N>::operator=(SnapshotVector<T, N>&& other) noexcept {
+  if (this != &other) {
+    release_spine();
+    spine = other.spine;
+    length = other.length;
+    other.spine = nullptr;
+    other.length = 0;
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+const T& SnapshotVector<T, N>::operator[](int index) const {
+  if (index < 0 || size_t(index) >= length) throw std::out_of_range("Index out of range");
+
+  return spine->chunks.data()[index / N]->data()[index % N];
+}
+
+template <typename T, size_t N>
+T& SnapshotVector<T, N>::operator[](int index) {
+  if (index < 0 || size_t(index) >= length) throw std::out_of_range("Index out of range");
+
+  Chunk* retired;
+  Chunk* chunk = own_chunk(index / N, retired);
+  release(retired);
+  return chunk->data()[index % N];
+}
+
+template <typename T, size_t N>
+const T* SnapshotVector<T, N>::try_get(int index) const {
+  if (index < 0 || size_t(index) >= length) return nullptr;
+
+  return spine->chunks.data()[index / N]->data() + index % N;
+}
+
+template <typename T, size_t N>
+const T& SnapshotVector<T, N>::back() const {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  return (*this)[int(length - 1)];
+}
+
+template <typename T, size_t N>
+const MemoryUsage SnapshotVector<T, N>::memory_usage() const {
+  MemoryUsage usage;
+  usage.overhead = sizeof(*this);
+  if (spine == nullptr) return usage;
+
+  size_t chunks = spine->chunks.size();
+  usage.payload = length * sizeof(T);
+  usage.slack = (chunks * N - length) * sizeof(T);
+  usage.overhead += chunks * (sizeof(Chunk) - N * sizeof(T)) + sizeof(Spine) - sizeof(spine->chunks);
+  usage.allocations = chunks + 1;
+
+  // The chunk pointers are bookkeeping, whatever the pointer array calls them
+  MemoryUsage pointers = spine->chunks.memory_usage();
+  usage.overhead += pointers.total();
+  usage.allocations += pointers.allocations;
+  return usage;
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::push_back(const T& value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::push_back(T&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& SnapshotVector<T, N>::emplace_back(Args&&... args) {
+  if (length % N == 0) {
+    own_spine();
+    std::unique_ptr<Chunk> chunk(new Chunk());
+    T* slot = new (chunk->data()) T(std::forward<Args>(args)...);
+    chunk->count = 1;
+    spine->chunks.push_back(chunk.get());
+    chunk.release();
+    length++;
+    return *slot;
+  }
+
+  Chunk* retired;
+  Chunk* chunk = own_chunk(length / N, retired);
+  try {
+    new (chunk->data() + chunk->count) T(std::forward<Args>(args)...);
+  } catch (...) {
+    release(retired);
+    throw;
+  }
+  release(retired);
+
+  length++;
+  return chunk->data()[chunk->count++];
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::pop_back() {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  size_t last = (length - 1) / N;
+  if ((length - 1) % N == 0) {
+    // The last chunk only held this element, so it is dropped rather than copied
+    own_spine();
+    release(spine->chunks.data()[last]);
+    spine->chunks.pop_back();
+  } else {
+    Chunk* retired;
+    Chunk* chunk = own_chunk(last, retired);
+    release(retired);
+    chunk->data()[--chunk->count].~T();
+  }
+
+  length--;
+  if (length == 0) release_spine();
+}
+
+template <typename T, size_t N>
+void SnapshotVector<T, N>::clear() {
+  release_spine();
+  length = 0;
+}
+
+template <typename T, size_t N>
+template <typename Fn>
+void SnapshotVector<T, N>::for_each_chunk(Fn fn) const {
+  if (spine == nullptr) return;
+
+  Chunk* const* chunks = spine->chunks.data();
+  for (size_t i = 0; i < spine->chunks.size(); i++) {
+    const Chunk* chunk = chunks[i];
+    fn(chunk->data(), chunk->count);
+  }
+}
+
+#endif
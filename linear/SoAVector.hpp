@@ -0,0 +1,428 @@
+// SoAVector.hpp
+#ifndef SOAVECTOR_H
+#define SOAVECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Struct viewing one contiguous column, e.g. to scan a single field with a plain (auto-vectorisable) loop
+template <typename T>
+struct ColumnSpan {
+  T* items;                           // First element of the column
+  size_t length;                      // Number of elements
+
+  T* data() const { return items; }
+  const size_t size() const { return length; }
+  const bool empty() const { return length == 0; }
+  T& operator[](size_t index) const { return items[index]; }    // Unchecked, to keep scans tight
+  T* begin() const { return items; }
+  T* end() const { return items + length; }
+};
+
+// Class representing a dynamic array of rows stored column by column (structure of arrays)
+// Each field lives in its own contiguous array, so a scan over one field reads only that field's bytes;
+// rows are reached through proxies, since no row exists as a single object in memory
+template <typename... Fields>
+class SoAVector {
+  static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+public:
+  using Row = std::tuple<Fields...>;
+  template <size_t I>
+  using Field = std::tuple_element_t<I, Row>;
+
+private:
+  using Indices = std::index_sequence_for<Fields...>;
+
+  std::tuple<Fields*...> columns;     // One array per field
+  size_t length;                      // Number of rows in the vector
+  size_t capacity;                    // Rows every array has room for
+
+  // Private helper functions
+  template <size_t... I>
+  void reallocate(size_t, std::index_sequence<I...>);                 // Moves every column into arrays of a new capacity
+  template <size_t... I, typename... Args>
+  void construct(size_t, std::index_sequence<I...>, Args&&...);      // Constructs the fields of a row, one argument per field
+  template <size_t... I>
+  void copy_row(const SoAVector<Fields...>&, size_t, std::index_sequence<I...>);  // Copy-constructs a row of another vector at the same index
+  template <size_t... I>
+  void destroy(size_t, std::index_sequence<I...>);                    // Destroys the fields of a row
+  template <size_t... I>
+  void deallocate(std::index_sequence<I...>);                         // Releases every column
+  template <size_t... I>
+  Row row(size_t, std::index_sequence<I...>) const;                   // Copies a row out
+  void grow();                                                        // Doubles the capacity
+  void release();                                                     // Destroys every row and releases the columns
+public:
+  // Proxy for one row, reading and writing through to the columns
+  template <typename V>
+  class BasicReference {
+  private:
+    V* vector;                        // Vector holding the row
+    size_t index;                     // Index of the row
+  public:
+    BasicReference(V* vector, size_t index) : vector(vector), index(index) {}
+
+    // Access a field of the row
+    template <size_t I>
+    decltype(auto) get() const {
+      if constexpr (std::is_const<V>::value) {
+        return static_cast<const Field<I>&>(std::get<I>(vector->columns)[index]);
+      } else {
+        return static_cast<Field<I>&>(std::get<I>(vector->columns)[index]);
+      }
+    }
+
+    // Copy the row out
+    operator Row() const { return vector->row(index, Indices()); }
+
+    // Overwrite every field of the row
+    template <typename W = V, typename = std::enable_if_t<!std::is_const<W>::value>>
+    const BasicReference& operator=(const Row& values) const {
+      assign(values, Indices());
+      return *this;
+    }
+
+  private:
+    template <size_t... I>
+    void assign(const Row& values, std::index_sequence<I...>) const {
+      ((std::get<I>(vector->columns)[index] = std::get<I>(values)), ...);
+    }
+  };
+
+  using Reference = BasicReference<SoAVector<Fields...>>;
+  using ConstReference = BasicReference<const SoAVector<Fields...>>;
+
+  // Constructors and Destructor
+  SoAVector();                                                      // Default constructor
+  explicit SoAVector(size_t);                                       // Constructor reserving room for a number of rows
+  SoAVector(const SoAVector<Fields...>&);                           // Copy constructor
+  SoAVector(SoAVector<Fields...>&&) noexcept;                       // Move constructor
+  ~SoAVector();                                                     // Destructor
+
+  // Assignment
+  SoAVector<Fields...>& operator=(const SoAVector<Fields...>&);     // Copy assignment operator
+  SoAVector<Fields...>& operator=(SoAVector<Fields...>&&) noexcept; // Move assignment operator
+
+  // Accessors
+  Reference operator[](int);                                        // Returns a proxy for the row at an index
+  ConstReference operator[](int) const;                             // Returns a const proxy for the row at an index
+  template <size_t I>
+  ColumnSpan<Field<I>> column();                                    // Returns the array of one field
+  template <size_t I>
+  ColumnSpan<const Field<I>> column() const;                        // Returns the array of one field (const)
+  const size_t size() const;                                        // Returns the number of rows in the vector
+  const size_t current_capacity() const;                            // Returns the number of rows the columns have room for
+  const bool empty() const;                                         // Returns if the vector has no rows
+  const MemoryUsage memory_usage() const;                           // Returns the bytes held by the vector, broken down
+
+  // Mutators
+  void push_back(const Row&);                                       // Adds a new row at the end of the vector
+  template <typename... Args>
+  Reference emplace_back(Args&&...);                                // Constructs a new row at the end, one argument per field
+  void pop_back();                                                  // Removes the last row of the vector
+  void reserve(size_t);                                             // Makes room for a number of rows
+  void clear();                                                     // Removes every row, keeping the capacity
+
+  // Utility
+  void print();                                                     // Prints all rows in the vector
+
+  // Random-access traversal over rows; dereferencing yields a proxy, so the iterator is tagged as an input iterator
+  template <typename V, typename R>
+  class BasicIterator {
+  private:
+    V* vector;                                              // Vector being iterated
+    size_t index;                                           // Index of the current row
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Row;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = R;
+
+    // Constructor
+    BasicIterator(V* vector, size_t index) : vector(vector), index(index) {}
+
+    // Dereference operators
+    R operator*() const { return R(vector, index); }
+    R operator[](difference_type n) const { return R(vector, index + n); }
+
+    // Increment and decrement operators
+    BasicIterator& operator++() { ++index; return *this; }
+    BasicIterator operator++(int) { BasicIterator temp = *this; ++index; return temp; }
+    BasicIterator& operator--() { --index; return *this; }
+    BasicIterator operator--(int) { BasicIterator temp = *this; --index; return temp; }
+
+    // Arithmetic operators
+    BasicIterator& operator+=(difference_type n) { index += n; return *this; }
+    BasicIterator& operator-=(difference_type n) { index -= n; return *this; }
+    BasicIterator operator+(difference_type n) const { return BasicIterator(vector, index + n); }
+    BasicIterator operator-(difference_type n) const { return BasicIterator(vector, index - n); }
+    difference_type operator-(const BasicIterator& other) const { return difference_type(index) - difference_type(other.index); }
+
+    // Comparison operators
+    bool operator==(const BasicIterator& other) const { return index == other.index; }
+    bool operator!=(const BasicIterator& other) const { return index != other.index; }
+    bool operator<(const BasicIterator& other) const { return index < other.index; }
+  };
+
+  using Iterator = BasicIterator<SoAVector<Fields...>, Reference>;
+  using ConstIterator = BasicIterator<const SoAVector<Fields...>, ConstReference>;
+
+  // Iterator functions
+  Iterator begin() { return Iterator(this, 0); }                        // Returns an iterator pointing to the first row
+  Iterator end() { return Iterator(this, length); }                     // Returns an iterator pointing to the end (one past last row)
+  ConstIterator begin() const { return ConstIterator(this, 0); }        // Returns a const iterator pointing to the first row
+  ConstIterator end() const { return ConstIterator(this, length); }     // Returns a const iterator pointing to the end (one past last row)
+};
+
+// Function definitions
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::reallocate(size_t new_capacity, std::index_sequence<I...>) {
+  // Allocate every new column before touching the old ones, so a failed allocation leaves the vector intact
+  std::tuple<Fields*...> moved;
+  size_t allocated = 0;
+  try {
+    ((std::get<I>(moved) = std::allocator<Fields>().allocate(new_capacity), allocated++), ...);
+  } catch (...) {
+    ((I < allocated ? std::allocator<Fields>().deallocate(std::get<I>(moved), new_capacity) : void()), ...);
+    throw;
+  }
+
+  auto move_column = [this](auto* from, auto* to) {
+    using T = std::remove_pointer_t<decltype(from)>;
+    if (from == nullptr) return;
+
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      if (length > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), length * sizeof(T));
+    } else {
+      for (size_t i = 0; i < length; i++) {
+        new (to + i) T(std::move_if_noexcept(from[i]));
+        from[i].~T();
+      }
+    }
+    std::allocator<T>().deallocate(from, capacity);
+  };
+  (move_column(std::get<I>(columns), std::get<I>(moved)), ...);
+
+  columns = moved;
+  capacity = new_capacity;
+}
+
+template <typename... Fields>
+template <size_t... I, typename... Args>
+void SoAVector<Fields...>::construct(size_t index, std::index_sequence<I...>, Args&&... args) {
+  size_t built = 0;
+  try {
+    ((new (std::get<I>(columns) + index) Fields(std::forward<Args>(args)), built++), ...);
+  } catch (...) {
+    ((I < built ? std::get<I>(columns)[index].~Fields() : void()), ...);
+    throw;
+  }
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::copy_row(const SoAVector<Fields...>& other, size_t index, std::index_sequence<I...> indices) {
+  construct(index, indices, std::get<I>(other.columns)[index]...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::destroy(size_t index, std::index_sequence<I...>) {
+  (std::get<I>(columns)[index].~Fields(), ...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+void SoAVector<Fields...>::deallocate(std::index_sequence<I...>) {
+  ((std::get<I>(columns) != nullptr ? std::allocator<Fields>().deallocate(std::get<I>(columns), capacity) : void()), ...);
+  ((std::get<I>(columns) = nullptr), ...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+typename SoAVector<Fields...>::Row SoAVector<Fields...>::row(size_t index, std::index_sequence<I...>) const {
+  return Row(std::get<I>(columns)[index]...);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::grow() {
+  reallocate(capacity == 0 ? 8 : 2 * capacity, Indices());
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::release() {
+  clear();
+  deallocate(Indices());
+  capacity = 0;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector() : columns(), length(0), capacity(0) {}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(size_t reserved) : columns(), length(0), capacity(0) {
+  reserve(reserved);
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(const SoAVector<Fields...>& other) : columns(), length(0), capacity(0) {
+  reserve(other.length);
+  try {
+    for (; length < other.length; length++) {
+      copy_row(other, length, Indices());
+    }
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::SoAVector(SoAVector<Fields...>&& other) noexcept : columns(other.columns), length(other.length), capacity(other.capacity) {
+  other.columns = std::tuple<Fields*...>();
+  other.length = 0;
+  other.capacity = 0;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>::~SoAVector() {
+  release();
+}
+
+template <typename... Fields>
+SoAVector<Fields...>& SoAVector<Fields...>::operator=(const SoAVector<Fields...>& other) {
+  if (this != &other) {
+    SoAVector<Fields...> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename... Fields>
+SoAVector<Fields...>& SoAVector<Fields...>::operator=(SoAVector<Fields...>&& other) noexcept {
+  if (this != &other) {
+    release();
+    std::swap(columns, other.columns);
+    std::swap(length, other.length);
+    std::swap(capacity, other.capacity);
+  }
+  return *this;
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::Reference SoAVector<Fields...>::operator[](int index) {
+  if (index < 0 || size_t(index) >= length) throw std::out_of_range("Index out of range");
+
+  return Reference(this, size_t(index));
+}
+
+template <typename... Fields>
+typename SoAVector<Fields...>::ConstReference SoAVector<Fields...>::operator[](int index) const {
+  if (index < 0 || size_t(index) >= length) throw std::out_of_range("Index out of range");
+
+  return ConstReference(this, size_t(index));
+}
+
+template <typename... Fields>
+template <size_t I>
+ColumnSpan<typename SoAVector<Fields...>::template Field<I>> SoAVector<Fields...>::column() {
+  return ColumnSpan<Field<I>>{std::get<I>(columns), length};
+}
+
+template <typename... Fields>
+template <size_t I>
+ColumnSpan<const typename SoAVector<Fields...>::template Field<I>> SoAVector<Fields...>::column() const {
+  return ColumnSpan<const Field<I>>{std::get<I>(columns), length};
+}
+
+template <typename... Fields>
+const size_t SoAVector<Fields...>::size() const {
+  return length;
+}
+
+template <typename... Fields>
+const size_t SoAVector<Fields...>::current_capacity() const {
+  return capacity;
+}
+
+template <typename... Fields>
+const bool SoAVector<Fields...>::empty() const {
+  return length == 0;
+}
+
+template <typename... Fields>
+const MemoryUsage SoAVector<Fields...>::memory_usage() const {
+  constexpr size_t row_bytes = (sizeof(Fields) + ...);
+
+  MemoryUsage usage;
+  usage.payload = length * row_bytes;
+  usage.slack = (capacity - length) * row_bytes;
+  usage.overhead = sizeof(*this);
+  usage.allocations = capacity > 0 ? sizeof...(Fields) : 0;
+  return usage;
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::push_back(const Row& values) {
+  std::apply([this](const Fields&... fields) { emplace_back(fields...); }, values);
+}
+
+template <typename... Fields>
+template <typename... Args>
+typename SoAVector<Fields...>::Reference SoAVector<Fields...>::emplace_back(Args&&... args) {
+  static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back takes one argument per field");
+
+  if (length == capacity) {
+    // Build the fields first so arguments referring into the columns survive the reallocation
+    Row values(std::forward<Args>(args)...);
+    grow();
+    std::apply([this](Fields&... fields) { construct(length, Indices(), std::move(fields)...); }, values);
+  } else {
+    construct(length, Indices(), std::forward<Args>(args)...);
+  }
+
+  return Reference(this, length++);
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::pop_back() {
+  if (length > 0) destroy(--length, Indices());
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::reserve(size_t rows) {
+  if (rows > capacity) reallocate(rows, Indices());
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::clear() {
+  while (length > 0) {
+    destroy(--length, Indices());
+  }
+}
+
+template <typename... Fields>
+void SoAVector<Fields...>::print() {
+  for (size_t i = 0; i < length; i++) {
+    std::cout << "(";
+    std::apply([](const Fields&... fields) {
+      size_t field = 0;
+      ((std::cout << (field++ == 0 ? "" : ", ") << fields), ...);
+    }, row(i, Indices()));
+    std::cout << ") ";
+  }
+  std::cout << std::endl;
+}
+
+#endif
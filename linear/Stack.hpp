@@ -2,72 +2,113 @@
 #ifndef STACK_H
 #define STACK_H
 
-// Include LinkedList header for stack implementation
-#include "LinkedList.hpp"
+// Include Deque header for the default stack implementation
+#include "Deque.hpp"
 
-template <typename T>
+// Container may be any sequence offering push_front/pop_front/front, e.g. Deque or LinkedList
+template <typename T, typename Container = Deque<T>>
 class Stack {
 private:
-  // Internal LinkedList for storing stack elements
-  LinkedList<T> list;
+  // Internal sequence for storing stack elements
+  Container container;
 
 public:
   // Constructor and Destructor
   Stack();
+  Stack(const Stack&) = default;
+  Stack(Stack&&) noexcept = default;
   ~Stack();
 
+  // Assignment
+  Stack& operator=(const Stack&) = default;
+  Stack& operator=(Stack&&) noexcept = default;
+
   // Public Functions
   void push(const T& item);         // Push an item on top of the stack
+  void push(T&& item);              // Move an item on top of the stack
+  template <typename... Args>
+  T& emplace(Args&&... args);       // Construct an item in place on top of the stack
   void pop();                       // Remove the top item of the stack
   const T& peek() const;            // Peek at the top item of the stack (const)
   T& top();                         // Access the top item of the stack
+  T* try_top();                     // Access the top item of the stack, or nullptr if it is empty
+  const T* try_top() const;         // Access the top item of the stack, or nullptr if it is empty (const)
   const bool empty() const;         // Check if the stack is empty
   const int size() const;           // Get the number of elements in the stack
+  const MemoryUsage memory_usage() const;  // Get the bytes held by the stack, broken down
   void clear();                     // Clear all elements from the stack
 };
 
-template <typename T>
-Stack<T>::Stack() {
+template <typename T, typename Container>
+Stack<T, Container>::Stack() {
+
+}
+
+template <typename T, typename Container>
+Stack<T, Container>::~Stack() {
+  container.clear();
+}
+
+template <typename T, typename Container>
+void Stack<T, Container>::push(const T& item) {
+  container.push_front(item);
+}
+
+template <typename T, typename Container>
+void Stack<T, Container>::push(T&& item) {
+  container.push_front(std::move(item));
+}
+
+template <typename T, typename Container>
+template <typename... Args>
+T& Stack<T, Container>::emplace(Args&&... args) {
+  return container.emplace_front(std::forward<Args>(args)...);
+}
 
+template <typename T, typename Container>
+void Stack<T, Container>::pop() {
+  container.pop_front();
 }
 
-template <typename T>
-Stack<T>::~Stack() {
-  list.clear();
+template <typename T, typename Container>
+T& Stack<T, Container>::top() {
+  return container.front();
 }
 
-template <typename T>
-void Stack<T>::push(const T& item) {
-  list.push_front(item);
+template <typename T, typename Container>
+const T& Stack<T, Container>::peek() const {
+  return container.front();
 }
 
-template <typename T>
-void Stack<T>::pop() {
-  list.pop_front();
+template <typename T, typename Container>
+T* Stack<T, Container>::try_top() {
+  return container.empty() ? nullptr : &container.front();
 }
 
-template <typename T>
-T& Stack<T>::top() {
-  return list.front();
+template <typename T, typename Container>
+const T* Stack<T, Container>::try_top() const {
+  return container.empty() ? nullptr : &container.front();
 }
 
-template <typename T>
-const T& Stack<T>::peek() const {
-  return list.front();
+template <typename T, typename Container>
+const bool Stack<T, Container>::empty() const {
+  return container.empty();
 }
 
-template <typename T>
-const bool Stack<T>::empty() const {
-  return list.empty();
+template <typename T, typename Container>
+const int Stack<T, Container>::size() const {
+  return container.size();
 }
 
-template <typename T>
-const int Stack<T>::size() const {
-  return list.size();
+template <typename T, typename Container>
+const MemoryUsage Stack<T, Container>::memory_usage() const {
+  MemoryUsage usage = container.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(container);
+  return usage;
 }
 
-template <typename T>
-void Stack<T>::clear() {
-  list.clear();
+template <typename T, typename Container>
+void Stack<T, Container>::clear() {
+  container.clear();
 }
 #endif
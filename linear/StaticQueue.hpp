@@ -0,0 +1,121 @@
+// StaticQueue.hpp
+#ifndef STATICQUEUE_H
+#define STATICQUEUE_H
+
+#include <stdexcept>
+#include <utility>
+
+#include "StaticStorage.hpp"
+#include "../memory/MemoryUsage.hpp"
+
+// Class representing a queue of up to N elements stored inline, with the interface of Queue
+// Elements sit in a ring of N slots, so push and pop never move other elements
+// Pushing onto a full queue is handled by the Overflow policy; push and emplace return false only when ReportOverflow refuses an item
+template <typename T, size_t N, typename Overflow = ThrowOnOverflow>
+class StaticQueue : private StaticStorage<T, N> {
+  static_assert(N > 0, "StaticQueue needs a capacity of at least one element");
+public:
+  // Constructor
+  constexpr StaticQueue() = default;            // Default constructor
+
+  // Accessors
+  constexpr T& front();                         // Access the front item of the queue
+  constexpr const T& front() const;             // Access the front item of the queue (const)
+  constexpr T* try_front();                     // Access the front item of the queue, or nullptr if it is empty
+  constexpr const T* try_front() const;         // Access the front item of the queue, or nullptr if it is empty (const)
+  constexpr const bool empty() const;           // Check if the queue is empty
+  constexpr const bool full() const;            // Check if the queue holds N items
+  constexpr const int size() const;             // Get the size of the queue
+  const MemoryUsage memory_usage() const;       // Get the bytes held by the queue, broken down
+
+  // Mutators
+  constexpr bool push(const T& value);          // Push an item to the back of the queue
+  constexpr bool push(T&& value);               // Move an item to the back of the queue
+  template <typename... Args>
+  constexpr bool emplace(Args&&... args);       // Construct an item in place at the back of the queue
+  constexpr void pop();                         // Remove the item from the front of the queue
+  constexpr void clear();                       // Clears the queue
+};
+
+// Function definitions
+template <typename T, size_t N, typename Overflow>
+constexpr T& StaticQueue<T, N, Overflow>::front() {
+  if (this->length == 0) throw std::out_of_range("Queue is empty");
+  return this->slots()[this->head];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T& StaticQueue<T, N, Overflow>::front() const {
+  if (this->length == 0) throw std::out_of_range("Queue is empty");
+  return this->slots()[this->head];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T* StaticQueue<T, N, Overflow>::try_front() {
+  return this->length == 0 ? nullptr : &this->slots()[this->head];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T* StaticQueue<T, N, Overflow>::try_front() const {
+  return this->length == 0 ? nullptr : &this->slots()[this->head];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticQueue<T, N, Overflow>::empty() const {
+  return this->length == 0;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticQueue<T, N, Overflow>::full() const {
+  return this->length == N;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const int StaticQueue<T, N, Overflow>::size() const {
+  return this->length;
+}
+
+template <typename T, size_t N, typename Overflow>
+const MemoryUsage StaticQueue<T, N, Overflow>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = this->length * sizeof(T);
+  usage.slack = (N - this->length) * sizeof(T);
+  usage.overhead = sizeof(*this) - N * sizeof(T);
+  return usage;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticQueue<T, N, Overflow>::push(const T& value) {
+  return emplace(value);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticQueue<T, N, Overflow>::push(T&& value) {
+  return emplace(std::move(value));
+}
+
+template <typename T, size_t N, typename Overflow>
+template <typename... Args>
+constexpr bool StaticQueue<T, N, Overflow>::emplace(Args&&... args) {
+  if (!Overflow::admit(this->length < N)) return false;
+
+  this->construct((this->head + this->length) % N, std::forward<Args>(args)...);
+  this->length++;
+  return true;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticQueue<T, N, Overflow>::pop() {
+  if (this->length == 0) throw std::out_of_range("Queue is empty");
+
+  this->destroy(this->head);
+  this->head = (this->head + 1) % N;
+  this->length--;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticQueue<T, N, Overflow>::clear() {
+  this->destroy_all();
+}
+
+#endif
@@ -0,0 +1,107 @@
+// StaticStack.hpp
+#ifndef STATICSTACK_H
+#define STATICSTACK_H
+
+#include "StaticVector.hpp"
+
+// Class representing a stack of up to N elements stored inline, with the interface of Stack
+// The top of the stack is the back of a StaticVector, so push and pop never move other elements
+// Pushing onto a full stack is handled by the Overflow policy; push and emplace return false only when ReportOverflow refuses an item
+template <typename T, size_t N, typename Overflow = ThrowOnOverflow>
+class StaticStack {
+private:
+  // Internal vector for storing stack elements, the top being its last element
+  StaticVector<T, N, Overflow> container;
+
+public:
+  // Constructor
+  constexpr StaticStack() = default;
+
+  // Public Functions
+  constexpr bool push(const T& item);         // Push an item on top of the stack
+  constexpr bool push(T&& item);              // Move an item on top of the stack
+  template <typename... Args>
+  constexpr bool emplace(Args&&... args);     // Construct an item in place on top of the stack
+  constexpr void pop();                       // Remove the top item of the stack
+  constexpr const T& peek() const;            // Peek at the top item of the stack (const)
+  constexpr T& top();                         // Access the top item of the stack
+  constexpr T* try_top();                     // Access the top item of the stack, or nullptr if it is empty
+  constexpr const T* try_top() const;         // Access the top item of the stack, or nullptr if it is empty (const)
+  constexpr const bool empty() const;         // Check if the stack is empty
+  constexpr const bool full() const;          // Check if the stack holds N items
+  constexpr const int size() const;           // Get the number of elements in the stack
+  const MemoryUsage memory_usage() const;     // Get the bytes held by the stack, broken down
+  constexpr void clear();                     // Clear all elements from the stack
+};
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticStack<T, N, Overflow>::push(const T& item) {
+  return container.push_back(item);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticStack<T, N, Overflow>::push(T&& item) {
+  return container.push_back(std::move(item));
+}
+
+template <typename T, size_t N, typename Overflow>
+template <typename... Args>
+constexpr bool StaticStack<T, N, Overflow>::emplace(Args&&... args) {
+  return container.emplace_back(std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticStack<T, N, Overflow>::pop() {
+  if (container.empty()) throw std::out_of_range("Stack is empty");
+  container.pop_back();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T& StaticStack<T, N, Overflow>::top() {
+  if (container.empty()) throw std::out_of_range("Stack is empty");
+  return container.back();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T& StaticStack<T, N, Overflow>::peek() const {
+  if (container.empty()) throw std::out_of_range("Stack is empty");
+  return container.back();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T* StaticStack<T, N, Overflow>::try_top() {
+  return container.empty() ? nullptr : &container.back();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T* StaticStack<T, N, Overflow>::try_top() const {
+  return container.empty() ? nullptr : &container.back();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticStack<T, N, Overflow>::empty() const {
+  return container.empty();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticStack<T, N, Overflow>::full() const {
+  return container.full();
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const int StaticStack<T, N, Overflow>::size() const {
+  return container.size();
+}
+
+template <typename T, size_t N, typename Overflow>
+const MemoryUsage StaticStack<T, N, Overflow>::memory_usage() const {
+  MemoryUsage usage = container.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(container);
+  return usage;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticStack<T, N, Overflow>::clear() {
+  container.clear();
+}
+#endif
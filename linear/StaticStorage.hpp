@@ -0,0 +1,137 @@
+// StaticStorage.hpp
+#ifndef STATICSTORAGE_H
+#define STATICSTORAGE_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Overflow policies of StaticVector, StaticStack and StaticQueue
+// admit() is asked before an element is added and returns if it may be; a refused element is never constructed
+
+// Overflow policy that throws std::length_error, the default
+// Overflowing during constant evaluation fails the compilation
+struct ThrowOnOverflow {
+  static constexpr bool admit(bool fits) {
+    if (!fits) throw std::length_error("Static capacity exceeded");
+    return true;
+  }
+};
+
+// Overflow policy that asserts the element fits
+// Release builds do not check at all, so overflowing is undefined behavior there
+struct AssertOnOverflow {
+  static constexpr bool admit(bool fits) {
+    assert(fits && "Static capacity exceeded");
+    (void)fits;
+    return true;
+  }
+};
+
+// Overflow policy that refuses the element, the mutator returning false instead
+struct ReportOverflow {
+  static constexpr bool admit(bool fits) {
+    return fits;
+  }
+};
+
+// Returns if a type can live in a plain array, which keeps the containers usable in constant expressions
+// Such types are default constructed up front and assigned to when added, and never need destroying
+template <typename T>
+constexpr bool static_storage_is_literal() {
+  return std::is_trivially_destructible<T>::value && std::is_default_constructible<T>::value && std::is_move_assignable<T>::value;
+}
+
+// Class holding up to N elements inline, as a ring of slots starting at head
+// The containers derive from it so their destructor stays trivial, and hence constexpr-friendly, whenever T allows it
+template <typename T, size_t N, bool Literal = static_storage_is_literal<T>()>
+class StaticStorage;
+
+// Storage for types living in a plain array
+template <typename T, size_t N>
+class StaticStorage<T, N, true> {
+protected:
+  T items[N] = {};                    // Every slot, live or not
+  size_t head = 0;                    // Slot of the first element
+  size_t length = 0;                  // Number of live elements
+
+  constexpr T* slots() { return items; }
+  constexpr const T* slots() const { return items; }
+
+  template <typename... Args>
+  constexpr void construct(size_t slot, Args&&... args) { items[slot] = T(std::forward<Args>(args)...); }
+  constexpr void destroy(size_t) {}
+  constexpr void destroy_all() { head = 0; length = 0; }
+};
+
+// Storage for every other type, constructing elements in place in raw memory
+template <typename T, size_t N>
+class StaticStorage<T, N, false> {
+protected:
+  alignas(T) unsigned char buffer[N * sizeof(T)];  // Raw slots
+  size_t head;                        // Slot of the first element
+  size_t length;                      // Number of live elements
+
+  T* slots() { return reinterpret_cast<T*>(buffer); }
+  const T* slots() const { return reinterpret_cast<const T*>(buffer); }
+
+  template <typename... Args>
+  void construct(size_t slot, Args&&... args) { new (slots() + slot) T(std::forward<Args>(args)...); }
+  void destroy(size_t slot) { slots()[slot].~T(); }
+
+  void destroy_all() {
+    for (size_t i = 0; i < length; i++) {
+      destroy((head + i) % N);
+    }
+    head = 0;
+    length = 0;
+  }
+
+  // Copies the elements of another storage into the same slots; this storage must be empty
+  void take(const StaticStorage& other) {
+    head = other.head;
+    for (; length < other.length; length++) {
+      size_t slot = (head + length) % N;
+      construct(slot, other.slots()[slot]);
+    }
+  }
+
+  // Moves the elements of another storage into the same slots; this storage must be empty
+  void take(StaticStorage&& other) {
+    head = other.head;
+    for (; length < other.length; length++) {
+      size_t slot = (head + length) % N;
+      construct(slot, std::move(other.slots()[slot]));
+    }
+  }
+
+  StaticStorage() : head(0), length(0) {}
+  StaticStorage(const StaticStorage& other) : head(0), length(0) { take(other); }
+  StaticStorage(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : head(0), length(0) {
+    take(std::move(other));
+    other.destroy_all();
+  }
+  ~StaticStorage() { destroy_all(); }
+
+  StaticStorage& operator=(const StaticStorage& other) {
+    if (this != &other) {
+      destroy_all();
+      take(other);
+    }
+    return *this;
+  }
+
+  StaticStorage& operator=(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      destroy_all();
+      take(std::move(other));
+      other.destroy_all();
+    }
+    return *this;
+  }
+};
+
+#endif
@@ -0,0 +1,218 @@
+// StaticVector.hpp
+#ifndef STATICVECTOR_H
+#define STATICVECTOR_H
+
+#include <stdexcept>
+#include <iostream>
+#include <initializer_list>
+#include <utility>
+
+#include "StaticStorage.hpp"
+#include "../memory/MemoryUsage.hpp"
+
+// Class representing an array of up to N elements stored inline, never touching the heap
+// For trivially destructible types every operation is constexpr, so lookup tables can be built at compile time
+// Adding to a full vector is handled by the Overflow policy; mutators return false only when ReportOverflow refuses an element
+template <typename T, size_t N, typename Overflow = ThrowOnOverflow>
+class StaticVector : private StaticStorage<T, N> {
+  static_assert(N > 0, "StaticVector needs a capacity of at least one element");
+public:
+  using Iterator = T*;
+  using ConstIterator = const T*;
+
+  // Constructors
+  constexpr StaticVector() = default;                       // Default constructor
+  constexpr StaticVector(std::initializer_list<T>);         // Initializer list constructor
+
+  // Accessors
+  constexpr T& operator[](int);                             // Overloaded subscript operator
+  constexpr const T& operator[](int) const;                 // Overloaded const subscript operator
+  constexpr T* try_get(int);                                // Returns a pointer to the element at an index, or nullptr if it is out of range
+  constexpr const T* try_get(int) const;                    // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
+  constexpr T& back();                                      // Returns the last element of the vector
+  constexpr const T& back() const;                          // Returns the last element of the vector (const)
+  constexpr const size_t size() const;                      // Returns the number of elements in the vector
+  constexpr const size_t current_capacity() const;          // Returns the capacity of the vector, always N
+  constexpr const bool empty() const;                       // Returns if the vector has no elements
+  constexpr const bool full() const;                        // Returns if the vector holds N elements
+  const MemoryUsage memory_usage() const;                   // Returns the bytes held by the vector, broken down
+
+  // Mutators
+  constexpr bool push_back(const T&);                       // Adds a new element at the end of the vector
+  constexpr bool push_back(T&&);                            // Moves a new element to the end of the vector
+  template <typename... Args>
+  constexpr bool emplace_back(Args&&...);                   // Constructs a new element in place at the end of the vector
+  constexpr void pop_back();                                // Removes the last element of the vector
+  constexpr bool insert(int, const T&);                     // Inserts a new element at the specified index
+  constexpr bool insert(int, T&&);                          // Moves a new element to the specified index
+  template <typename... Args>
+  constexpr bool emplace(int, Args&&...);                   // Constructs a new element in place at the specified index
+  constexpr void clear();                                   // Removes every element of the vector
+
+  // Utility
+  void print();                                             // Prints all elements in the vector
+
+  // Iterator functions
+  constexpr Iterator begin() { return this->slots(); }                          // Returns an iterator pointing to the first element
+  constexpr Iterator end() { return this->slots() + this->length; }             // Returns an iterator pointing to the end (one past last element)
+  constexpr ConstIterator begin() const { return this->slots(); }               // Returns a const iterator pointing to the first element
+  constexpr ConstIterator end() const { return this->slots() + this->length; }  // Returns a const iterator pointing to the end (one past last element)
+
+  // Raw access to the contiguous storage
+  constexpr T* data() { return this->slots(); }
+  constexpr const T* data() const { return this->slots(); }
+};
+
+// Function definitions
+template <typename T, size_t N, typename Overflow>
+constexpr StaticVector<T, N, Overflow>::StaticVector(std::initializer_list<T> elements) {
+  for (const T& element : elements) {
+    if (!push_back(element)) break;
+  }
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T& StaticVector<T, N, Overflow>::operator[](int index) {
+  if (index < 0 || size_t(index) >= this->length) throw std::out_of_range("Index out of range");
+
+  return this->slots()[index];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T& StaticVector<T, N, Overflow>::operator[](int index) const {
+  if (index < 0 || size_t(index) >= this->length) throw std::out_of_range("Index out of range");
+
+  return this->slots()[index];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T* StaticVector<T, N, Overflow>::try_get(int index) {
+  if (index < 0 || size_t(index) >= this->length) return nullptr;
+
+  return &this->slots()[index];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T* StaticVector<T, N, Overflow>::try_get(int index) const {
+  if (index < 0 || size_t(index) >= this->length) return nullptr;
+
+  return &this->slots()[index];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr T& StaticVector<T, N, Overflow>::back() {
+  if (this->length == 0) throw std::out_of_range("Vector is empty");
+
+  return this->slots()[this->length - 1];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const T& StaticVector<T, N, Overflow>::back() const {
+  if (this->length == 0) throw std::out_of_range("Vector is empty");
+
+  return this->slots()[this->length - 1];
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const size_t StaticVector<T, N, Overflow>::size() const {
+  return this->length;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const size_t StaticVector<T, N, Overflow>::current_capacity() const {
+  return N;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticVector<T, N, Overflow>::empty() const {
+  return this->length == 0;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr const bool StaticVector<T, N, Overflow>::full() const {
+  return this->length == N;
+}
+
+template <typename T, size_t N, typename Overflow>
+const MemoryUsage StaticVector<T, N, Overflow>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = this->length * sizeof(T);
+  usage.slack = (N - this->length) * sizeof(T);
+  usage.overhead = sizeof(*this) - N * sizeof(T);
+  return usage;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticVector<T, N, Overflow>::push_back(const T& element) {
+  return emplace_back(element);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticVector<T, N, Overflow>::push_back(T&& element) {
+  return emplace_back(std::move(element));
+}
+
+template <typename T, size_t N, typename Overflow>
+template <typename... Args>
+constexpr bool StaticVector<T, N, Overflow>::emplace_back(Args&&... args) {
+  if (!Overflow::admit(this->length < N)) return false;
+
+  this->construct(this->length, std::forward<Args>(args)...);
+  this->length++;
+  return true;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticVector<T, N, Overflow>::pop_back() {
+  if (this->length > 0) this->destroy(--this->length);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticVector<T, N, Overflow>::insert(int index, const T& element) {
+  return emplace(index, element);
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr bool StaticVector<T, N, Overflow>::insert(int index, T&& element) {
+  return emplace(index, std::move(element));
+}
+
+template <typename T, size_t N, typename Overflow>
+template <typename... Args>
+constexpr bool StaticVector<T, N, Overflow>::emplace(int index, Args&&... args) {
+  if (index < 0 || size_t(index) > this->length) throw std::out_of_range("Index out of range");
+
+  if (size_t(index) == this->length) return emplace_back(std::forward<Args>(args)...);
+  if (!Overflow::admit(this->length < N)) return false;
+
+  // Build the element first so arguments referring into the vector survive the shift
+  T element = T(std::forward<Args>(args)...);
+  T* items = this->slots();
+
+  this->construct(this->length, std::move(items[this->length - 1]));
+  for (size_t i = this->length - 1; i > size_t(index); i--) {
+    items[i] = std::move(items[i - 1]);
+  }
+
+  items[index] = std::move(element);
+
+  this->length++;
+  return true;
+}
+
+template <typename T, size_t N, typename Overflow>
+constexpr void StaticVector<T, N, Overflow>::clear() {
+  while (this->length > 0) {
+    this->destroy(--this->length);
+  }
+}
+
+template <typename T, size_t N, typename Overflow>
+void StaticVector<T, N, Overflow>::print() {
+  for (size_t i = 0; i < this->length; i++) {
+      std::cout << this->slots()[i] << " ";
+  }
+  std::cout << std::endl;
+}
+
+#endif
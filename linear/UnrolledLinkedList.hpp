@@ -0,0 +1,666 @@
+// UnrolledLinkedList.hpp
+#ifndef UNROLLEDLINKEDLIST_H
+#define UNROLLEDLINKEDLIST_H
+
+#include <stdexcept>
+#include <iostream>
+#include <new>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+#include "ScanKernels.hpp"
+
+// Number of elements stored per node, sized so a node spans roughly two cache lines
+template <typename T>
+constexpr size_t unrolled_node_capacity() {
+  return sizeof(T) >= 64 ? 2 : (128 / sizeof(T) < 2 ? 2 : 128 / sizeof(T));
+}
+
+// Struct defining a node in the unrolled linked list
+template <typename T, size_t N>
+struct UnrolledNode {
+  alignas(T) unsigned char storage[N * sizeof(T)];  // Raw storage for up to N elements
+  size_t count;                                     // Number of constructed elements in the node
+  UnrolledNode* next;                               // Pointer to the next node in the list
+  UnrolledNode* prev;                               // Pointer to the previous node in the list
+
+  UnrolledNode() : count(0), next(nullptr), prev(nullptr) {}
+  ~UnrolledNode() { while (count > 0) data()[--count].~T(); }
+
+  T* data() { return reinterpret_cast<T*>(storage); }
+  const T* data() const { return reinterpret_cast<const T*>(storage); }
+  const bool full() const { return count == N; }
+
+  // Constructs a value at the given slot, shifting the tail of the node right by one
+  template <typename... Args>
+  T& emplace_at(size_t slot, Args&&... args) {
+    if (slot == count) {
+      new (data() + count) T(std::forward<Args>(args)...);
+    } else {
+      T value(std::forward<Args>(args)...);
+      new (data() + count) T(std::move(data()[count - 1]));
+      for (size_t i = count - 1; i > slot; i--) {
+        data()[i] = std::move(data()[i - 1]);
+      }
+      data()[slot] = std::move(value);
+    }
+    count++;
+    return data()[slot];
+  }
+
+  // Removes the value at the given slot, shifting the tail of the node left by one
+  void erase_at(size_t slot) {
+    for (size_t i = slot; i + 1 < count; i++) {
+      data()[i] = std::move(data()[i + 1]);
+    }
+    data()[--count].~T();
+  }
+};
+
+// Class representing a linked list that stores a small array of elements per node
+template <typename T, size_t N = unrolled_node_capacity<T>()>
+class UnrolledLinkedList {
+  static_assert(N >= 2, "UnrolledLinkedList needs at least two elements per node");
+private:
+  UnrolledNode<T, N>* head;       // Pointer to the first node in the list
+  UnrolledNode<T, N>* tail;       // Pointer to the last node in the list
+  size_t list_size;               // Number of elements in the list
+
+  // Private helper functions
+  UnrolledNode<T, N>* locate(size_t, size_t&) const;              // Finds the node and slot holding an index
+  UnrolledNode<T, N>* append_node(UnrolledNode<T, N>*);           // Links a new empty node after the given node
+  void split(UnrolledNode<T, N>*);                                // Moves the upper half of a full node into a new node
+  void unlink(UnrolledNode<T, N>*);                               // Unlinks and deletes the given node
+  void merge_if_sparse(UnrolledNode<T, N>*);                      // Merges an underfilled node with its successor
+public:
+  // Constructors and Destructor
+  UnrolledLinkedList() : head(nullptr), tail(nullptr), list_size(0) {}  // Default constructor
+  UnrolledLinkedList(const UnrolledLinkedList<T, N>&);                  // Copy constructor
+  UnrolledLinkedList(UnrolledLinkedList<T, N>&&) noexcept;              // Move constructor
+  ~UnrolledLinkedList();                                                // Destructor
+
+  // Assignment
+  UnrolledLinkedList<T, N>& operator=(const UnrolledLinkedList<T, N>&);       // Copy assignment operator
+  UnrolledLinkedList<T, N>& operator=(UnrolledLinkedList<T, N>&&) noexcept;   // Move assignment operator
+
+  // Accessors
+  T& operator[](int);                                           // Overloaded subscript operator
+  const T& operator[](int) const;                               // Overloaded const subscript operator
+  T* try_get(int);                                              // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T* try_get(int) const;                                  // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
+  T& front();                                                   // Returns value at the front of the list
+  const T& front() const;                                       // Returns value at the front of the list (const)
+  T& back();                                                    // Returns value at the back of the list
+  const T& back() const;                                        // Returns value at the back of the list (const)
+  const size_t size() const;                                    // Returns the number of elements in the list
+  const MemoryUsage memory_usage() const;                       // Returns the bytes held by the list, broken down
+  const bool empty() const;                                     // Checks if the list empty
+
+  // Mutators
+  void push_front(const T&);                                    // Adds a new element at the front of the list
+  void push_front(T&&);                                         // Moves a new element to the front of the list
+  void push_back(const T&);                                     // Adds a new element at the back of the list
+  void push_back(T&&);                                          // Moves a new element to the back of the list
+  void insert(int, const T&);                                   // Adds a new element at the specified index
+  void insert(int, T&&);                                        // Moves a new element to the specified index
+  template <typename... Args>
+  T& emplace_front(Args&&...);                                  // Constructs a new element in place at the front of the list
+  template <typename... Args>
+  T& emplace_back(Args&&...);                                   // Constructs a new element in place at the back of the list
+  template <typename... Args>
+  T& emplace(int, Args&&...);                                   // Constructs a new element in place at the specified index
+  void remove_all(const T&);                                    // Removes all occurances of a value from the list
+  void remove_at(int);                                          // Removes the element at specified index
+  void pop_front();                                             // Removes the element at the front of the list
+  void pop_back();                                              // Removes the element at the back of the list
+  void clear();                                                 // Removes all elements from the list
+
+  // Utility
+  const int find(const T&) const;                               // Finds the index of the first occurance of a value
+  const bool contains(const T&) const;                          // Checks if the list contains a specific value
+  const size_t count(const T&) const;                           // Returns how many elements equal a value
+  const T min() const;                                          // Returns the smallest element
+  const T max() const;                                          // Returns the largest element
+  const ScanSum<T> sum() const;                                 // Returns the sum of every element (64-bit for integers)
+  template <typename Pred>
+  UnrolledLinkedList<T, N> filter(Pred) const;                  // Returns the elements for which pred holds, in order
+  void print();                                                 // Prints all elements in the list
+
+  // Iterator
+  class Iterator {
+  private:
+    UnrolledNode<T, N>* current;    // Pointer to the current node in the iteration
+    size_t slot;                    // Index of the current element within the node
+  public:
+    // Constructor
+    Iterator(UnrolledNode<T, N>* node, size_t slot = 0) : current(node), slot(slot) { }
+
+    // Dereference operator
+    T& operator*() const { return current->data()[slot]; }
+
+    // Get the current node
+    UnrolledNode<T, N>* get_node() { return current; }
+
+    // Increment operator
+    Iterator& operator++() {
+      if (++slot == current->count) {
+        current = current->next;
+        slot = 0;
+      }
+      return *this;
+    }
+
+    // Inequality operator
+    bool operator!=(const Iterator& other) const { return current != other.current || slot != other.slot; }
+  };
+
+  // Iterator methods
+  Iterator begin() { return Iterator(head); }                 // Returns an iterator pointing to the first element
+  Iterator end() { return Iterator(nullptr); }                // Returns an iterator pointing to the end (nullptr)
+  const Iterator begin() const { return Iterator(head); }     // Returns a const iterator pointing to the first element
+  const Iterator end() const { return Iterator(nullptr); }    // Returns a const iterator pointing to the end (nullptr)
+};
+
+// Function Definitions
+template <typename T, size_t N>
+UnrolledNode<T, N>* UnrolledLinkedList<T, N>::locate(size_t index, size_t& slot) const {
+  if (index >= list_size) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  // Skip whole nodes, walking from whichever end is closer
+  if (index < list_size / 2) {
+    UnrolledNode<T, N>* node = head;
+    while (index >= node->count) {
+      index -= node->count;
+      node = node->next;
+    }
+    slot = index;
+    return node;
+  }
+
+  size_t remaining = list_size - 1 - index;
+  UnrolledNode<T, N>* node = tail;
+  while (remaining >= node->count) {
+    remaining -= node->count;
+    node = node->prev;
+  }
+  slot = node->count - 1 - remaining;
+  return node;
+}
+
+template <typename T, size_t N>
+UnrolledNode<T, N>* UnrolledLinkedList<T, N>::append_node(UnrolledNode<T, N>* after) {
+  UnrolledNode<T, N>* node = new UnrolledNode<T, N>();
+
+  if (after == nullptr) {
+    node->next = head;
+    if (head != nullptr) head->prev = node;
+    head = node;
+    if (tail == nullptr) tail = node;
+    return node;
+  }
+
+  node->prev = after;
+  node->next = after->next;
+  if (after->next != nullptr) after->next->prev = node;
+  after->next = node;
+  if (after == tail) tail = node;
+  return node;
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::split(UnrolledNode<T, N>* node) {
+  UnrolledNode<T, N>* upper = append_node(node);
+  size_t half = node->count / 2;
+
+  for (size_t i = half; i < node->count; i++) {
+    new (upper->data() + upper->count++) T(std::move(node->data()[i]));
+  }
+  while (node->count > half) {
+    node->data()[--node->count].~T();
+  }
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::unlink(UnrolledNode<T, N>* node) {
+  if (node->prev != nullptr) node->prev->next = node->next;
+  else head = node->next;
+
+  if (node->next != nullptr) node->next->prev = node->prev;
+  else tail = node->prev;
+
+  delete node;
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::merge_if_sparse(UnrolledNode<T, N>* node) {
+  if (node->count == 0) {
+    unlink(node);
+    return;
+  }
+
+  UnrolledNode<T, N>* next = node->next;
+  if (node->count >= N / 2 || next == nullptr || node->count + next->count > N) {
+    return;
+  }
+
+  for (size_t i = 0; i < next->count; i++) {
+    new (node->data() + node->count++) T(std::move(next->data()[i]));
+  }
+  unlink(next);
+}
+
+template <typename T, size_t N>
+UnrolledLinkedList<T, N>::UnrolledLinkedList(const UnrolledLinkedList<T, N>& other) : head(nullptr), tail(nullptr), list_size(0) {
+  for (auto element = other.begin(); element != other.end(); ++element) {
+    push_back(*element);
+  }
+}
+
+template <typename T, size_t N>
+UnrolledLinkedList<T, N>::UnrolledLinkedList(UnrolledLinkedList<T, N>&& other) noexcept : head(other.head), tail(other.tail), list_size(other.list_size) {
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.list_size = 0;
+}
+
+template <typename T, size_t N>
+UnrolledLinkedList<T, N>::~UnrolledLinkedList() {
+  clear();
+}
+
+template <typename T, size_t N>
+UnrolledLinkedList<T, N>& UnrolledLinkedList<T, N>::operator=(const UnrolledLinkedList<T, N>& other) {
+  if (this != &other) {
+    UnrolledLinkedList<T, N> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+UnrolledLinkedList<T, N>& UnrolledLinkedList<T, N>::operator=(UnrolledLinkedList<T, N>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(list_size, other.list_size);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+T& UnrolledLinkedList<T, N>::operator[](int index) {
+  if (index < 0) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  size_t slot;
+  UnrolledNode<T, N>* node = locate(index, slot);
+  return node->data()[slot];
+}
+
+template <typename T, size_t N>
+const T& UnrolledLinkedList<T, N>::operator[](int index) const {
+  if (index < 0) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  size_t slot;
+  const UnrolledNode<T, N>* node = locate(index, slot);
+  return node->data()[slot];
+}
+
+template <typename T, size_t N>
+T* UnrolledLinkedList<T, N>::try_get(int index) {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  size_t slot;
+  UnrolledNode<T, N>* node = locate(index, slot);
+  return node->data() + slot;
+}
+
+template <typename T, size_t N>
+const T* UnrolledLinkedList<T, N>::try_get(int index) const {
+  if (index < 0 || size_t(index) >= list_size) return nullptr;
+
+  size_t slot;
+  const UnrolledNode<T, N>* node = locate(index, slot);
+  return node->data() + slot;
+}
+
+template <typename T, size_t N>
+T& UnrolledLinkedList<T, N>::front() {
+  if (this->head == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  return this->head->data()[0];
+}
+
+template <typename T, size_t N>
+const T& UnrolledLinkedList<T, N>::front() const {
+  if (this->head == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  return this->head->data()[0];
+}
+
+template <typename T, size_t N>
+T& UnrolledLinkedList<T, N>::back() {
+  if (this->tail == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  return this->tail->data()[this->tail->count - 1];
+}
+
+template <typename T, size_t N>
+const T& UnrolledLinkedList<T, N>::back() const {
+  if (this->tail == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  return this->tail->data()[this->tail->count - 1];
+}
+
+template <typename T, size_t N>
+const size_t UnrolledLinkedList<T, N>::size() const {
+  return list_size;
+}
+
+template <typename T, size_t N>
+const MemoryUsage UnrolledLinkedList<T, N>::memory_usage() const {
+  size_t nodes = 0;
+  for (const UnrolledNode<T, N>* node = this->head; node != nullptr; node = node->next) {
+    nodes++;
+  }
+
+  // Unfilled slots of the nodes are slack
+  MemoryUsage usage;
+  usage.payload = list_size * sizeof(T);
+  usage.slack = nodes * N * sizeof(T) - usage.payload;
+  usage.overhead = sizeof(*this) + nodes * (sizeof(UnrolledNode<T, N>) - N * sizeof(T));
+  usage.allocations = nodes;
+  return usage;
+}
+
+template <typename T, size_t N>
+const bool UnrolledLinkedList<T, N>::empty() const {
+  return this->head == nullptr;
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::push_front(const T& value) {
+  emplace_front(value);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::push_front(T&& value) {
+  emplace_front(std::move(value));
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::push_back(const T& value) {
+  emplace_back(value);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::push_back(T&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::insert(int index, const T& value) {
+  emplace(index, value);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::insert(int index, T&& value) {
+  emplace(index, std::move(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& UnrolledLinkedList<T, N>::emplace_front(Args&&... args) {
+  if (this->head == nullptr || this->head->full()) {
+    append_node(nullptr);
+  }
+
+  list_size++;
+  return this->head->emplace_at(0, std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& UnrolledLinkedList<T, N>::emplace_back(Args&&... args) {
+  if (this->tail == nullptr || this->tail->full()) {
+    append_node(this->tail);
+  }
+
+  list_size++;
+  return this->tail->emplace_at(this->tail->count, std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T& UnrolledLinkedList<T, N>::emplace(int index, Args&&... args) {
+  if (index < 0 || index > list_size) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  if (index == list_size) {
+    return emplace_back(std::forward<Args>(args)...);
+  }
+
+  size_t slot;
+  UnrolledNode<T, N>* node = locate(index, slot);
+
+  if (node->full()) {
+    split(node);
+    if (slot >= node->count) {
+      slot -= node->count;
+      node = node->next;
+    }
+  }
+
+  list_size++;
+  return node->emplace_at(slot, std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::remove_all(const T& value) {
+  UnrolledNode<T, N>* node = this->head;
+  size_t from = 0;                    // Leading elements of node already known not to hold the value
+
+  while (node != nullptr) {
+    // Find the first copy of the value, then compact the survivors of the rest in place
+    size_t kept = from + scan_find(node->data() + from, node->count - from, value);
+    for (size_t i = kept + 1; i < node->count; i++) {
+      if (node->data()[i] == value) continue;
+      if (kept != i) node->data()[kept] = std::move(node->data()[i]);
+      kept++;
+    }
+
+    this->list_size -= node->count - kept;
+    while (node->count > kept) {
+      node->data()[--node->count].~T();
+    }
+
+    if (node->count == 0) {
+      UnrolledNode<T, N>* next = node->next;
+      unlink(node);
+      node = next;
+      from = 0;
+      continue;
+    }
+
+    // An underfilled node takes in its successor as in remove_at; the elements it took still have to be scanned
+    size_t scanned = node->count;
+    merge_if_sparse(node);
+    if (node->count > scanned) {
+      from = scanned;
+      continue;
+    }
+
+    node = node->next;
+    from = 0;
+  }
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::remove_at(int index) {
+  if (index < 0 || index >= this->size()) {
+    throw std::out_of_range("Index out of range");
+  }
+
+  size_t slot;
+  UnrolledNode<T, N>* node = locate(index, slot);
+
+  node->erase_at(slot);
+  list_size--;
+  merge_if_sparse(node);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::pop_front() {
+  if (this->head == nullptr) {
+    return;
+  }
+
+  this->head->erase_at(0);
+  list_size--;
+
+  if (this->head->count == 0) unlink(this->head);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::pop_back() {
+  if (this->tail == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  this->tail->data()[--this->tail->count].~T();
+  list_size--;
+
+  if (this->tail->count == 0) unlink(this->tail);
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::clear() {
+  UnrolledNode<T, N>* current = this->head;
+  while (current != nullptr) {
+    UnrolledNode<T, N>* next = current->next;
+    delete current;
+    current = next;
+  }
+
+  this->head = nullptr;
+  this->tail = nullptr;
+  this->list_size = 0;
+}
+
+template <typename T, size_t N>
+const int UnrolledLinkedList<T, N>::find(const T& value) const {
+  // Each node's elements are contiguous, so every node is searched with the block kernels
+  size_t count = 0;
+  for (const UnrolledNode<T, N>* node = head; node != nullptr; node = node->next) {
+    size_t slot = scan_find(node->data(), node->count, value);
+    if (slot != node->count) {
+      return int(count + slot);
+    }
+    count += node->count;
+  }
+
+  return -1;
+}
+
+template <typename T, size_t N>
+const bool UnrolledLinkedList<T, N>::contains(const T& value) const {
+  return find(value) != -1;
+}
+
+template <typename T, size_t N>
+const size_t UnrolledLinkedList<T, N>::count(const T& value) const {
+  size_t total = 0;
+  for (const UnrolledNode<T, N>* node = head; node != nullptr; node = node->next) {
+    total += scan_count(node->data(), node->count, value);
+  }
+  return total;
+}
+
+template <typename T, size_t N>
+const T UnrolledLinkedList<T, N>::min() const {
+  if (this->head == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  T best = scan_min(head->data(), head->count);
+  for (const UnrolledNode<T, N>* node = head->next; node != nullptr; node = node->next) {
+    T candidate = scan_min(node->data(), node->count);
+    if (candidate < best) best = candidate;
+  }
+  return best;
+}
+
+template <typename T, size_t N>
+const T UnrolledLinkedList<T, N>::max() const {
+  if (this->head == nullptr) {
+    throw std::out_of_range("List is empty");
+  }
+
+  T best = scan_max(head->data(), head->count);
+  for (const UnrolledNode<T, N>* node = head->next; node != nullptr; node = node->next) {
+    T candidate = scan_max(node->data(), node->count);
+    if (best < candidate) best = candidate;
+  }
+  return best;
+}
+
+template <typename T, size_t N>
+const ScanSum<T> UnrolledLinkedList<T, N>::sum() const {
+  ScanSum<T> total = ScanSum<T>();
+  for (const UnrolledNode<T, N>* node = head; node != nullptr; node = node->next) {
+    total += scan_sum(node->data(), node->count);
+  }
+  return total;
+}
+
+template <typename T, size_t N>
+template <typename Pred>
+UnrolledLinkedList<T, N> UnrolledLinkedList<T, N>::filter(Pred pred) const {
+  UnrolledLinkedList<T, N> result;
+  for (const UnrolledNode<T, N>* node = head; node != nullptr; node = node->next) {
+    if constexpr (ScanVectorizable<T>::value) {
+      // Filter a whole node into a buffer, then append the survivors
+      T kept[N];
+      size_t count = scan_filter(node->data(), node->count, kept, pred);
+      for (size_t i = 0; i < count; i++) {
+        result.push_back(kept[i]);
+      }
+    } else {
+      for (size_t i = 0; i < node->count; i++) {
+        if (pred(node->data()[i])) result.push_back(node->data()[i]);
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T, size_t N>
+void UnrolledLinkedList<T, N>::print() {
+  if (this->head == nullptr) {
+    std::cout << "Ø" << std::endl;
+    return;
+  }
+
+  for (auto element = begin(); element != end(); ++element) {
+    std::cout << *element << " ";
+  }
+
+  std::cout << std::endl;
+}
+
+#endif
@@ -4,6 +4,16 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/MemoryUsage.hpp"
+#include "ContiguousEdits.hpp"
+#include "ScanKernels.hpp"
 
 // Class representing a dynamic array
 template <typename T>
@@ -17,90 +27,217 @@ private:
   // Private helper function to resize the array when the capacity is reached
   void resize();
 
+  // Private helper function to move the elements into a new array of the given capacity
+  void reallocate(size_t);
+
   // Private helper function to reserve a certain extra capacity
   void reserve(size_t);
+
+  // Private helper function to destroy all elements and release the array
+  void release();
 public:
   // Constructors and Destructor
   Vector();                                                 // Default constructor
   Vector(size_t, size_t);                                   // Parameter constructor with capacity and step
+  Vector(const Vector<T>&);                                 // Copy constructor
+  Vector(Vector<T>&&) noexcept;                             // Move constructor
   ~Vector();                                                // Destructor
 
+  // Assignment
+  Vector<T>& operator=(const Vector<T>&);                   // Copy assignment operator
+  Vector<T>& operator=(Vector<T>&&) noexcept;               // Move assignment operator
+
   // Accessors
   T& operator[](int);                                       // Overloaded subscript operator
   const T& operator[](int) const;                           // Overloaded const subscript operator
+  T* try_get(int);                                          // Returns a pointer to the element at an index, or nullptr if it is out of range
+  const T* try_get(int) const;                              // Returns a pointer to the element at an index, or nullptr if it is out of range (const)
   const size_t size() const;                                // Returns the number of elements in the vector
   const size_t current_capacity() const;                    // Returns the current capacity of the vector
+  const MemoryUsage memory_usage() const;                   // Returns the bytes held by the vector, broken down
 
   // Mutators
   void push_back(const T&);                                 // Adds a new element at the end of the vector
+  void push_back(T&&);                                      // Moves a new element to the end of the vector
+  template <typename... Args>
+  T& emplace_back(Args&&...);                               // Constructs a new element in place at the end of the vector
   void pop_back();                                          // Removes the last element of the vector
   void insert(int, const T&);                               // Inserts a new element at the specified index
+  void insert(int, T&&);                                    // Moves a new element to the specified index
+  template <typename... Args>
+  T& emplace(int, Args&&...);                               // Constructs a new element in place at the specified index
+  void swap_remove(int);                                    // Removes the element at an index by moving the last element into its place (O(1), unordered)
+  template <typename Pred>
+  size_t erase_if(Pred);                                    // Removes every element for which pred holds in one pass, keeping the order, and returns how many
 
   // Utility
+  const int find(const T&) const;                           // Finds the index of the first occurance of a value
+  const bool contains(const T&) const;                      // Checks if the vector contains a specific value
+  const size_t count(const T&) const;                       // Returns how many elements equal a value
+  const T min() const;                                      // Returns the smallest element
+  const T max() const;                                      // Returns the largest element
+  const ScanSum<T> sum() const;                             // Returns the sum of every element (64-bit for integers)
+  template <typename Pred>
+  Vector<T> filter(Pred) const;                             // Returns the elements for which pred holds, in order
   void print();                                             // Prints all elements in the vector
 
-  // Iterator
-  class Iterator {
+  // Random-access iterator, usable with <algorithm> and the parallel algorithms
+  template <typename U>
+  class BasicIterator {
   private:
-    T* ptr;                                                 // Pointer to the current element in the iteration
+    U* ptr;                                                 // Pointer to the current element in the iteration
   public:
-    // Constructor
-    Iterator(T* ptr) : ptr(ptr) {}
-
-    // Pre-increment operator
-    Iterator& operator++() { ++ptr; return *this; }
-
-    // Post-increment operator
-    Iterator operator++(int) { Iterator temp = *this; ++ptr; return temp; }
-
-    // Equality operator
-    bool operator==(const Iterator& other) const { return ptr == other.ptr; }
-
-    // Inequality operator
-    bool operator!=(const Iterator& other) const { return ptr != other.ptr; } 
-
-    // Dereference operator
-    T& operator*() { return *ptr; }
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<U>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = U*;
+    using reference = U&;
+
+    // Constructors
+    BasicIterator() : ptr(nullptr) {}
+    BasicIterator(U* ptr) : ptr(ptr) {}
+
+    // Conversion from a mutable to a const iterator
+    operator BasicIterator<const U>() const { return BasicIterator<const U>(ptr); }
+
+    // Increment and decrement operators
+    BasicIterator& operator++() { ++ptr; return *this; }
+    BasicIterator operator++(int) { BasicIterator temp = *this; ++ptr; return temp; }
+    BasicIterator& operator--() { --ptr; return *this; }
+    BasicIterator operator--(int) { BasicIterator temp = *this; --ptr; return temp; }
+
+    // Arithmetic operators
+    BasicIterator& operator+=(difference_type n) { ptr += n; return *this; }
+    BasicIterator& operator-=(difference_type n) { ptr -= n; return *this; }
+    BasicIterator operator+(difference_type n) const { return BasicIterator(ptr + n); }
+    BasicIterator operator-(difference_type n) const { return BasicIterator(ptr - n); }
+    friend BasicIterator operator+(difference_type n, const BasicIterator& it) { return it + n; }
+    friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) { return a.ptr - b.ptr; }
+
+    // Comparison operators, non-member friends so an Iterator converts when compared with a ConstIterator
+    friend bool operator==(const BasicIterator& a, const BasicIterator& b) { return a.ptr == b.ptr; }
+    friend bool operator!=(const BasicIterator& a, const BasicIterator& b) { return a.ptr != b.ptr; }
+    friend bool operator<(const BasicIterator& a, const BasicIterator& b) { return a.ptr < b.ptr; }
+    friend bool operator>(const BasicIterator& a, const BasicIterator& b) { return a.ptr > b.ptr; }
+    friend bool operator<=(const BasicIterator& a, const BasicIterator& b) { return a.ptr <= b.ptr; }
+    friend bool operator>=(const BasicIterator& a, const BasicIterator& b) { return a.ptr >= b.ptr; }
+
+    // Dereference operators
+    U& operator*() const { return *ptr; }
+    U* operator->() const { return ptr; }
+    U& operator[](difference_type n) const { return ptr[n]; }
   };
 
+  using Iterator = BasicIterator<T>;
+  using ConstIterator = BasicIterator<const T>;
+
   // Iterator functions
-  Iterator begin() { return Iterator(array); }                // Returns an iterator pointing to the first element
-  Iterator end() { return Iterator(array + length); }         // Returns an iterator pointing to the end (one past last element)
+  Iterator begin() { return Iterator(array); }                      // Returns an iterator pointing to the first element
+  Iterator end() { return Iterator(array + length); }               // Returns an iterator pointing to the end (one past last element)
+  ConstIterator begin() const { return ConstIterator(array); }      // Returns a const iterator pointing to the first element
+  ConstIterator end() const { return ConstIterator(array + length); } // Returns a const iterator pointing to the end (one past last element)
+
+  // Raw access to the contiguous storage
+  T* data() { return array; }
+  const T* data() const { return array; }
+
+  // Iterator-based mutators, each shifting the tail once
+  Iterator erase(ConstIterator);                            // Removes an element, returning an iterator to the element after it
+  Iterator erase(ConstIterator, ConstIterator);             // Removes a range, returning an iterator to the element after it
+  template <typename It>
+  Iterator insert(ConstIterator, It, It);                   // Inserts a range (not from this vector) before an element, returning an iterator to the first inserted
 };
 
 // Function definitions
 template <typename T>
 void Vector<T>::resize() {
-  T* copy = new T[capacity += step];
-  for (int i = 0; i < length; i++) {
-    copy[i] = array[i];
-  }
+  reallocate(capacity + step);
+}
 
-  delete[] array;
+template <typename T>
+void Vector<T>::reallocate(size_t new_capacity) {
+  std::allocator<T> allocator;
+  T* copy = allocator.allocate(new_capacity);
+  contiguous_relocate(array, length, copy);
+
+  allocator.deallocate(array, capacity);
+  capacity = new_capacity;
   array = copy;
 }
 
 template <typename T>
 void Vector<T>::reserve(size_t reserve_size)
 {
-  while (capacity - length < reserve_size) {
-    resize();
+  // Grow by whole steps, but in a single reallocation
+  if (capacity - length >= reserve_size) return;
+
+  size_t missing = reserve_size - (capacity - length);
+  reallocate(capacity + (missing + step - 1) / step * step);
+}
+
+template <typename T>
+void Vector<T>::release() {
+  if (array == nullptr) return;
+
+  for (size_t i = 0; i < length; i++) {
+    array[i].~T();
   }
+  std::allocator<T>().deallocate(array, capacity);
+
+  array = nullptr;
+  length = 0;
+  capacity = 0;
 }
 
 template <typename T>
 Vector<T>::Vector() : length(0), capacity(10), step(10) {
-  array = new T[capacity];
+  array = std::allocator<T>().allocate(capacity);
 }
 
 template <typename T>
 Vector<T>::Vector(size_t capacity, size_t step) : length(0), capacity(capacity), step(step) {
-  array = new T[capacity];
+  array = std::allocator<T>().allocate(capacity);
+}
+
+template <typename T>
+Vector<T>::Vector(const Vector<T>& other) : length(0), capacity(other.capacity), step(other.step) {
+  array = std::allocator<T>().allocate(capacity);
+  for (; length < other.length; length++) {
+    new (array + length) T(other.array[length]);
+  }
+}
+
+template <typename T>
+Vector<T>::Vector(Vector<T>&& other) noexcept : array(other.array), length(other.length), capacity(other.capacity), step(other.step) {
+  other.array = nullptr;
+  other.length = 0;
+  other.capacity = 0;
 }
 
 template <typename T>
 Vector<T>::~Vector() {
-  delete[] array;
+  release();
+}
+
+template <typename T>
+Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
+  if (this != &other) {
+    Vector<T> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T>
+Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept {
+  if (this != &other) {
+    release();
+    std::swap(array, other.array);
+    std::swap(length, other.length);
+    std::swap(capacity, other.capacity);
+    step = other.step;
+  }
+  return *this;
 }
 
 template <typename T>
@@ -117,6 +254,20 @@ const T& Vector<T>::operator[](int index) const {
   return array[index];
 }
 
+template <typename T>
+T* Vector<T>::try_get(int index) {
+  if (index < 0 || index >= length) return nullptr;
+
+  return &array[index];
+}
+
+template <typename T>
+const T* Vector<T>::try_get(int index) const {
+  if (index < 0 || index >= length) return nullptr;
+
+  return &array[index];
+}
+
 template <typename T>
 const size_t Vector<T>::size() const {
   return length;
@@ -128,32 +279,178 @@ const size_t Vector<T>::current_capacity() const
     return capacity;
 }
 
+template <typename T>
+const MemoryUsage Vector<T>::memory_usage() const {
+  MemoryUsage usage;
+  usage.payload = length * sizeof(T);
+  usage.slack = (capacity - length) * sizeof(T);
+  usage.overhead = sizeof(*this);
+  usage.allocations = array != nullptr ? 1 : 0;
+  return usage;
+}
+
 template <typename T>
 void Vector<T>::push_back(const T& element) {
+  emplace_back(element);
+}
+
+template <typename T>
+void Vector<T>::push_back(T&& element) {
+  emplace_back(std::move(element));
+}
+
+template <typename T>
+template <typename... Args>
+T& Vector<T>::emplace_back(Args&&... args) {
   if (length == capacity) {
+    // Build the element first so arguments referring into the array survive the resize
+    T element(std::forward<Args>(args)...);
+    if (step == 0) step = 10;
     resize();
+    return *new (array + length++) T(std::move(element));
   }
 
-  array[length++] = element;
+  return *new (array + length++) T(std::forward<Args>(args)...);
 }
 
 template <typename T>
 void Vector<T>::pop_back() {
-  if (length > 0) length--;
+  if (length > 0) array[--length].~T();
 }
 
 template <typename T>
 void Vector<T>::insert(int index, const T &element)
 {
-  reserve(length + 1);
+  emplace(index, element);
+}
 
-  for (size_t i = length; i > index; i--) {
-    array[i] = array[i - 1];
-  }
+template <typename T>
+void Vector<T>::insert(int index, T&& element)
+{
+  emplace(index, std::move(element));
+}
 
-  array[index] = element;
+template <typename T>
+template <typename... Args>
+T& Vector<T>::emplace(int index, Args&&... args)
+{
+  if (index < 0 || index > length) throw std::out_of_range("Index out of range");
+
+  if (index == length) return emplace_back(std::forward<Args>(args)...);
+
+  T element(std::forward<Args>(args)...);
+  if (step == 0) step = 10;
+  reserve(1);
 
+  contiguous_insert(array, length, size_t(index), std::make_move_iterator(&element), 1);
   ++length;
+  return array[index];
+}
+
+template <typename T>
+void Vector<T>::swap_remove(int index) {
+  if (index < 0 || index >= length) throw std::out_of_range("Index out of range");
+
+  if (size_t(index) != length - 1) array[index] = std::move(array[length - 1]);
+  array[--length].~T();
+}
+
+template <typename T>
+template <typename Pred>
+size_t Vector<T>::erase_if(Pred pred) {
+  size_t kept = contiguous_erase_if(array, length, pred);
+  size_t removed = length - kept;
+  length = kept;
+  return removed;
+}
+
+template <typename T>
+typename Vector<T>::Iterator Vector<T>::erase(ConstIterator position) {
+  return erase(position, position + 1);
+}
+
+template <typename T>
+typename Vector<T>::Iterator Vector<T>::erase(ConstIterator first, ConstIterator last) {
+  size_t from = size_t(first - ConstIterator(array));
+  size_t to = size_t(last - ConstIterator(array));
+  if (from > to || to > length) throw std::out_of_range("Index out of range");
+  contiguous_erase(array, length, from, to);
+  length -= to - from;
+  return Iterator(array + from);
+}
+
+template <typename T>
+template <typename It>
+typename Vector<T>::Iterator Vector<T>::insert(ConstIterator position, It first, It last) {
+  size_t index = size_t(position - ConstIterator(array));
+  if (index > length) throw std::out_of_range("Index out of range");
+
+  // A single-pass range has to be collected before its size is known
+  if constexpr (!std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value) {
+    Vector<T> items;
+    for (; first != last; ++first) {
+      items.push_back(*first);
+    }
+    return insert(ConstIterator(array + index), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+  } else {
+    size_t count = size_t(std::distance(first, last));
+    if (count == 0) return Iterator(array + index);
+
+    if (step == 0) step = 10;
+    reserve(count);
+
+    contiguous_insert(array, length, index, first, count);
+    length += count;
+    return Iterator(array + index);
+  }
+}
+
+// The scans below run the block kernels of ScanKernels.hpp for arithmetic types and plain loops otherwise
+template <typename T>
+const int Vector<T>::find(const T& value) const {
+  size_t index = scan_find(array, length, value);
+  return index == length ? -1 : int(index);
+}
+
+template <typename T>
+const bool Vector<T>::contains(const T& value) const {
+  return scan_find(array, length, value) != length;
+}
+
+template <typename T>
+const size_t Vector<T>::count(const T& value) const {
+  return scan_count(array, length, value);
+}
+
+template <typename T>
+const T Vector<T>::min() const {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  return scan_min(array, length);
+}
+
+template <typename T>
+const T Vector<T>::max() const {
+  if (length == 0) throw std::out_of_range("Vector is empty");
+
+  return scan_max(array, length);
+}
+
+template <typename T>
+const ScanSum<T> Vector<T>::sum() const {
+  return scan_sum(array, length);
+}
+
+template <typename T>
+template <typename Pred>
+Vector<T> Vector<T>::filter(Pred pred) const {
+  // Room for every element up front, so the result is filled without growing
+  Vector<T> result(length, step);
+  result.length = contiguous_filter(array, length, result.array, pred);
+
+  // Give back the room a selective filter left unused
+  if (result.capacity - result.length > step) result.reallocate(result.length);
+  return result;
 }
 
 template <typename T>
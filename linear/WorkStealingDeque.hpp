@@ -0,0 +1,170 @@
+// WorkStealingDeque.hpp
+#ifndef WORKSTEALINGDEQUE_H
+#define WORKSTEALINGDEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Class representing a Chase-Lev work-stealing deque
+// The owning thread pushes and pops at the bottom; any other thread may steal from the top
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque elements must be trivially copyable (e.g. task pointers)");
+private:
+  // Circular array of atomic slots, replaced by a larger one when full
+  struct Buffer {
+    int64_t capacity;                 // Number of slots, always a power of two
+    std::atomic<T>* slots;            // Slots indexed modulo the capacity
+
+    Buffer(int64_t capacity) : capacity(capacity), slots(new std::atomic<T>[capacity]) {}
+    ~Buffer() { delete[] slots; }
+
+    T get(int64_t index) const { return slots[index & (capacity - 1)].load(std::memory_order_relaxed); }
+    void put(int64_t index, T value) { slots[index & (capacity - 1)].store(value, std::memory_order_relaxed); }
+  };
+
+  std::atomic<int64_t> top;           // Index thieves steal from
+  std::atomic<int64_t> bottom;        // Index the owner pushes to and pops from
+  std::atomic<Buffer*> buffer;        // Current circular array
+  std::vector<Buffer*> retired;       // Outgrown arrays, kept alive while thieves may still read them
+
+  // Private helper function to double the circular array
+  Buffer* grow(Buffer*, int64_t, int64_t);
+public:
+  // Constructor and Destructor
+  WorkStealingDeque(int64_t capacity = 256);                // Constructor with initial capacity (rounded up to a power of two)
+  WorkStealingDeque(const WorkStealingDeque<T>&) = delete;
+  WorkStealingDeque<T>& operator=(const WorkStealingDeque<T>&) = delete;
+  ~WorkStealingDeque();                                     // Destructor
+
+  // Owner operations
+  void push(T);                                             // Pushes an element at the bottom
+  bool pop(T&);                                             // Pops the bottom element, returns false if empty
+
+  // Thief operations
+  bool steal(T&);                                           // Steals the top element, returns false if empty or contended
+
+  // Utility
+  const bool empty() const;                                 // Returns if the deque appears empty
+  const int64_t size() const;                               // Returns the approximate number of elements
+  const MemoryUsage memory_usage() const;                   // Returns the bytes held by the deque, broken down (owner thread only)
+};
+
+// Function definitions
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(int64_t capacity) : top(0), bottom(0) {
+  int64_t rounded = 1;
+  while (rounded < capacity) rounded <<= 1;
+  buffer.store(new Buffer(rounded), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+  delete buffer.load(std::memory_order_relaxed);
+  for (Buffer* old : retired) {
+    delete old;
+  }
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::grow(Buffer* old, int64_t t, int64_t b) {
+  Buffer* bigger = new Buffer(old->capacity * 2);
+  for (int64_t i = t; i < b; i++) {
+    bigger->put(i, old->get(i));
+  }
+
+  retired.push_back(old);
+  buffer.store(bigger, std::memory_order_release);
+  return bigger;
+}
+
+template <typename T>
+void WorkStealingDeque<T>::push(T value) {
+  int64_t b = bottom.load(std::memory_order_relaxed);
+  int64_t t = top.load(std::memory_order_acquire);
+  Buffer* current = buffer.load(std::memory_order_relaxed);
+
+  if (b - t > current->capacity - 1) {
+    current = grow(current, t, b);
+  }
+
+  current->put(b, value);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::pop(T& out) {
+  int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  Buffer* current = buffer.load(std::memory_order_relaxed);
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top.load(std::memory_order_relaxed);
+
+  if (t > b) {
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  out = current->get(b);
+  if (t == b) {
+    // Last element: race any thief for it
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::steal(T& out) {
+  int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom.load(std::memory_order_acquire);
+
+  if (t >= b) return false;
+
+  Buffer* current = buffer.load(std::memory_order_acquire);
+  T value = current->get(t);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    return false;
+  }
+
+  out = value;
+  return true;
+}
+
+template <typename T>
+const bool WorkStealingDeque<T>::empty() const {
+  return size() <= 0;
+}
+
+template <typename T>
+const int64_t WorkStealingDeque<T>::size() const {
+  return bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+const MemoryUsage WorkStealingDeque<T>::memory_usage() const {
+  Buffer* current = buffer.load(std::memory_order_relaxed);
+  int64_t count = std::min(std::max<int64_t>(size(), 0), current->capacity);
+
+  // Outgrown arrays stay allocated until destruction in case a thief still reads them
+  MemoryUsage usage;
+  usage.payload = size_t(count) * sizeof(std::atomic<T>);
+  usage.slack = size_t(current->capacity - count) * sizeof(std::atomic<T>);
+  usage.overhead = sizeof(*this) + (retired.size() + 1) * sizeof(Buffer) + retired.capacity() * sizeof(Buffer*);
+  for (const Buffer* old : retired) {
+    usage.fragmentation += size_t(old->capacity) * sizeof(std::atomic<T>);
+  }
+  usage.allocations = 2 * (retired.size() + 1) + (retired.capacity() > 0 ? 1 : 0);
+  return usage;
+}
+
+#endif
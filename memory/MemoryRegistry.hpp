@@ -0,0 +1,158 @@
+// MemoryRegistry.hpp
+#ifndef MEMORYREGISTRY_H
+#define MEMORYREGISTRY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MemoryUsage.hpp"
+
+// Struct describing one tracked container in a memory report
+struct MemoryReportEntry {
+  uint64_t id;                        // Registration number, never reused within the process
+  std::string name;                   // Name given when the container was tracked
+  const void* address;                // Address of the tracked container
+  MemoryUsage usage;                  // Breakdown at the time of the report
+};
+
+// Class keeping the container instances a process chose to track, so it can report where its memory goes
+// Tracking is opt-in per instance and costs one registration; nothing is measured until a report is made
+// Reports measure every container under the registry lock, so a measure function must not track or untrack anything,
+// and the caller must keep tracked containers from being modified while a report runs
+class MemoryRegistry {
+private:
+  // Struct holding a tracked container
+  struct Tracked {
+    uint64_t id;
+    std::string name;
+    const void* address;
+    std::function<MemoryUsage()> measure;
+  };
+
+  mutable std::mutex mutex;           // Guards the members below
+  std::vector<Tracked> tracked;       // Tracked containers in registration order
+  uint64_t next_id;                   // Id of the next registration
+
+  void untrack(uint64_t);             // Removes a registration
+public:
+  // Class removing its registration when destroyed; a tracked container must outlive its handle and stay in place
+  class Handle {
+  private:
+    MemoryRegistry* registry;         // Registry holding the registration, nullptr once released
+    uint64_t id;                      // Registration number
+  public:
+    Handle() : registry(nullptr), id(0) {}
+    Handle(MemoryRegistry* registry, uint64_t id) : registry(registry), id(id) {}
+    Handle(const Handle&) = delete;
+    Handle(Handle&& other) noexcept : registry(other.registry), id(other.id) { other.registry = nullptr; }
+    ~Handle() { release(); }
+
+    Handle& operator=(const Handle&) = delete;
+    Handle& operator=(Handle&& other) noexcept {
+      if (this != &other) {
+        release();
+        std::swap(registry, other.registry);
+        std::swap(id, other.id);
+      }
+      return *this;
+    }
+
+    // Stops tracking early
+    void release() {
+      if (registry != nullptr) registry->untrack(id);
+      registry = nullptr;
+    }
+  };
+
+  // Constructor
+  MemoryRegistry() : next_id(1) {}
+  MemoryRegistry(const MemoryRegistry&) = delete;
+  MemoryRegistry& operator=(const MemoryRegistry&) = delete;
+
+  // Registration
+  Handle track(const std::string&, const void*, std::function<MemoryUsage()>);     // Tracks anything able to measure itself
+  template <typename C>
+  Handle track(const std::string&, const C&);                                      // Tracks a container through its memory_usage()
+
+  // Reports
+  const size_t tracked_count() const;                                              // Returns the number of tracked containers
+  std::vector<MemoryReportEntry> report() const;                                   // Measures every tracked container, largest first
+  void dump(std::ostream&) const;                                                  // Prints the report as a table followed by the totals
+};
+
+// Returns the registry shared by the whole process
+inline MemoryRegistry& memory_registry() {
+  static MemoryRegistry registry;
+  return registry;
+}
+
+// Function definitions
+inline MemoryRegistry::Handle MemoryRegistry::track(const std::string& name, const void* address, std::function<MemoryUsage()> measure) {
+  std::lock_guard<std::mutex> guard(mutex);
+  uint64_t id = next_id++;
+  tracked.push_back(Tracked{id, name, address, std::move(measure)});
+  return Handle(this, id);
+}
+
+template <typename C>
+MemoryRegistry::Handle MemoryRegistry::track(const std::string& name, const C& container) {
+  const C* instance = &container;
+  return track(name, instance, [instance] { return instance->memory_usage(); });
+}
+
+inline void MemoryRegistry::untrack(uint64_t id) {
+  std::lock_guard<std::mutex> guard(mutex);
+  tracked.erase(std::remove_if(tracked.begin(), tracked.end(), [id](const Tracked& entry) { return entry.id == id; }), tracked.end());
+}
+
+inline const size_t MemoryRegistry::tracked_count() const {
+  std::lock_guard<std::mutex> guard(mutex);
+  return tracked.size();
+}
+
+inline std::vector<MemoryReportEntry> MemoryRegistry::report() const {
+  std::vector<MemoryReportEntry> entries;
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    entries.reserve(tracked.size());
+    for (const Tracked& entry : tracked) {
+      entries.push_back(MemoryReportEntry{entry.id, entry.name, entry.address, entry.measure()});
+    }
+  }
+
+  std::stable_sort(entries.begin(), entries.end(), [](const MemoryReportEntry& a, const MemoryReportEntry& b) {
+    return a.usage.total() > b.usage.total();
+  });
+  return entries;
+}
+
+inline void MemoryRegistry::dump(std::ostream& out) const {
+  std::vector<MemoryReportEntry> entries = report();
+  MemoryUsage sum;
+  char line[256];
+
+  std::snprintf(line, sizeof(line), "%-32s %18s %14s %14s %14s %14s %14s %14s %12s\n", "name", "address", "total",
+    "payload", "overhead", "slack", "fragmentation", "mapped", "allocations");
+  out << line;
+
+  for (const MemoryReportEntry& entry : entries) {
+    const MemoryUsage& usage = entry.usage;
+    std::snprintf(line, sizeof(line), "%-32s %18p %14zu %14zu %14zu %14zu %14zu %14zu %12zu\n", entry.name.c_str(), entry.address,
+      usage.total(), usage.payload, usage.overhead, usage.slack, usage.fragmentation, usage.mapped, usage.allocations);
+    out << line;
+    sum += usage;
+  }
+
+  std::snprintf(line, sizeof(line), "%-32s %18s %14zu %14zu %14zu %14zu %14zu %14zu %12zu\n", "total", "", sum.total(),
+    sum.payload, sum.overhead, sum.slack, sum.fragmentation, sum.mapped, sum.allocations);
+  out << line;
+}
+
+#endif
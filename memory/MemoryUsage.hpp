@@ -0,0 +1,31 @@
+// MemoryUsage.hpp
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+
+// Struct breaking down the bytes a container holds, as returned by memory_usage()
+// Element bytes are shallow: memory the elements own themselves (e.g. string buffers) is not followed
+struct MemoryUsage {
+  size_t payload = 0;                 // Bytes of the stored elements, or keys and values
+  size_t overhead = 0;                // Bookkeeping bytes: the container object, node links and heights, block maps
+  size_t slack = 0;                   // Element storage reserved but not holding an element (spare capacity, unfilled node slots)
+  size_t fragmentation = 0;           // Bytes held but unusable until released, e.g. outgrown buffers kept alive for readers
+  size_t mapped = 0;                  // Part of the total backed by read-only file mappings instead of the heap
+  size_t allocations = 0;             // Heap blocks held; the allocator adds its own header to each on top of the total
+
+  const size_t total() const { return payload + overhead + slack + fragmentation; }    // Returns every byte held
+
+  // Adds another breakdown, e.g. the parts of a composite container
+  MemoryUsage& operator+=(const MemoryUsage& other) {
+    payload += other.payload;
+    overhead += other.overhead;
+    slack += other.slack;
+    fragmentation += other.fragmentation;
+    mapped += other.mapped;
+    allocations += other.allocations;
+    return *this;
+  }
+};
+
+#endif
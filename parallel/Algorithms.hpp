@@ -0,0 +1,171 @@
+// Algorithms.hpp
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#include "../linear/Vector.hpp"
+#include "ThreadPool.hpp"
+
+// Minimum number of elements a chunk should hold before it is worth running in parallel
+constexpr size_t parallel_default_grain = 1 << 14;
+
+// Returns how many chunks to split n elements into, a few per pool worker so stealing can balance them
+inline size_t parallel_chunk_count(size_t n, size_t grain) {
+  size_t limit = 4 * default_thread_pool().size();
+  size_t chunks = grain == 0 ? n : n / grain;
+  return std::max<size_t>(1, std::min(chunks, limit));
+}
+
+// Runs fn(chunk, begin, end) over [0, n) split into the given number of contiguous chunks
+template <typename Fn>
+void parallel_chunks(size_t n, size_t chunks, Fn fn) {
+  if (chunks <= 1) {
+    fn(size_t(0), size_t(0), n);
+    return;
+  }
+
+  // The calling thread takes the first chunk itself and helps with the rest while waiting
+  TaskGroup group(default_thread_pool());
+  for (size_t chunk = 1; chunk < chunks; chunk++) {
+    group.spawn([&fn, n, chunks, chunk] { fn(chunk, n * chunk / chunks, n * (chunk + 1) / chunks); });
+  }
+  fn(size_t(0), size_t(0), n / chunks);
+  group.wait();
+}
+
+// Applies fn to every element in [first, last)
+template <typename RandomIt, typename Fn>
+void parallel_for_each(RandomIt first, RandomIt last, Fn fn, size_t grain = parallel_default_grain) {
+  size_t n = last - first;
+  parallel_chunks(n, parallel_chunk_count(n, grain), [&](size_t, size_t begin, size_t end) {
+    std::for_each(first + begin, first + end, fn);
+  });
+}
+
+// Writes fn(x) for every x in [first, last) to the range starting at d_first
+template <typename RandomIt, typename OutputIt, typename Fn>
+OutputIt parallel_transform(RandomIt first, RandomIt last, OutputIt d_first, Fn fn, size_t grain = parallel_default_grain) {
+  size_t n = last - first;
+  parallel_chunks(n, parallel_chunk_count(n, grain), [&](size_t, size_t begin, size_t end) {
+    std::transform(first + begin, first + end, d_first + begin, fn);
+  });
+  return d_first + n;
+}
+
+// Folds [first, last) into init with an associative operation
+// The first chunk folds from init; every other chunk has no identity to start from, so it is seeded
+// with its first element converted to T, which must therefore be a valid partial result on its own
+template <typename RandomIt, typename T, typename Op = std::plus<>>
+T parallel_reduce(RandomIt first, RandomIt last, T init, Op op = Op(), size_t grain = parallel_default_grain) {
+  size_t n = last - first;
+  if (n == 0) return init;
+
+  size_t chunks = parallel_chunk_count(n, grain);
+  std::vector<std::optional<T>> partials(chunks);
+  parallel_chunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+    T sum = chunk == 0 ? op(std::move(init), first[begin]) : T(first[begin]);
+    for (size_t i = begin + 1; i < end; i++) {
+      sum = op(std::move(sum), first[i]);
+    }
+    partials[chunk].emplace(std::move(sum));
+  });
+
+  T total = std::move(*partials[0]);
+  for (size_t chunk = 1; chunk < chunks; chunk++) {
+    total = op(std::move(total), std::move(*partials[chunk]));
+  }
+  return total;
+}
+
+// Writes the running totals of [first, last) under an associative operation to the range starting at d_first
+template <typename RandomIt, typename OutputIt, typename Op = std::plus<>>
+OutputIt parallel_inclusive_scan(RandomIt first, RandomIt last, OutputIt d_first, Op op = Op(), size_t grain = parallel_default_grain) {
+  using value_type = typename std::iterator_traits<OutputIt>::value_type;
+
+  size_t n = last - first;
+  if (n == 0) return d_first;
+
+  // Scan every chunk locally
+  size_t chunks = parallel_chunk_count(n, grain);
+  parallel_chunks(n, chunks, [&](size_t, size_t begin, size_t end) {
+    std::inclusive_scan(first + begin, first + end, d_first + begin, op);
+  });
+  if (chunks == 1) return d_first + n;
+
+  // Carry the total of all preceding chunks into each chunk
+  std::vector<value_type> carries;
+  carries.reserve(chunks);
+  carries.push_back(d_first[n / chunks - 1]);
+  for (size_t chunk = 1; chunk + 1 < chunks; chunk++) {
+    carries.push_back(op(carries.back(), d_first[n * (chunk + 1) / chunks - 1]));
+  }
+
+  parallel_chunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+    if (chunk == 0) return;
+    for (size_t i = begin; i < end; i++) {
+      d_first[i] = op(carries[chunk - 1], d_first[i]);
+    }
+  });
+  return d_first + n;
+}
+
+// Sorts [first, last) by sorting chunks in parallel and merging them pairwise
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(RandomIt first, RandomIt last, Compare compare = Compare(), size_t grain = parallel_default_grain) {
+  size_t n = last - first;
+  size_t chunks = parallel_chunk_count(n, grain);
+
+  parallel_chunks(n, chunks, [&](size_t, size_t begin, size_t end) {
+    std::sort(first + begin, first + end, compare);
+  });
+
+  // Each round merges neighbouring runs, halving the number of runs
+  for (size_t width = 1; width < chunks; width *= 2) {
+    size_t merges = (chunks + 2 * width - 1) / (2 * width);
+
+    parallel_chunks(merges, merges, [&](size_t merge, size_t, size_t) {
+      size_t left = merge * 2 * width;
+      size_t middle = std::min(left + width, chunks);
+      size_t right = std::min(left + 2 * width, chunks);
+      if (middle == right) return;
+
+      std::inplace_merge(first + n * left / chunks, first + n * middle / chunks, first + n * right / chunks, compare);
+    });
+  }
+}
+
+// Vector overloads
+template <typename T, typename Compare = std::less<>>
+void parallel_sort(Vector<T>& vector, Compare compare = Compare()) {
+  parallel_sort(vector.begin(), vector.end(), compare);
+}
+
+template <typename T, typename Fn>
+void parallel_for_each(Vector<T>& vector, Fn fn) {
+  parallel_for_each(vector.begin(), vector.end(), fn);
+}
+
+// Replaces every element x with fn(x)
+template <typename T, typename Fn>
+void parallel_transform(Vector<T>& vector, Fn fn) {
+  parallel_transform(vector.begin(), vector.end(), vector.begin(), fn);
+}
+
+template <typename T, typename U, typename Op = std::plus<>>
+U parallel_reduce(const Vector<T>& vector, U init, Op op = Op()) {
+  return parallel_reduce(vector.begin(), vector.end(), init, op);
+}
+
+// Replaces every element with the running total up to and including it
+template <typename T, typename Op = std::plus<>>
+void parallel_inclusive_scan(Vector<T>& vector, Op op = Op()) {
+  parallel_inclusive_scan(vector.begin(), vector.end(), vector.begin(), op);
+}
+
+#endif
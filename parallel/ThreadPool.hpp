@@ -0,0 +1,287 @@
+// ThreadPool.hpp
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "../linear/Queue.hpp"
+#include "../linear/WorkStealingDeque.hpp"
+
+class ThreadPool;
+
+// Class representing a set of fork-join tasks that can be waited on together
+class TaskGroup {
+private:
+  ThreadPool& pool;                       // Pool the tasks run on
+  std::atomic<size_t> outstanding;        // Number of spawned tasks that have not finished
+  std::exception_ptr error;               // First exception thrown by a task
+  std::mutex error_mutex;                 // Guards error
+
+  // Private helper function running pool tasks until every spawned task finished
+  void drain();
+
+  friend class ThreadPool;
+public:
+  // Constructor and Destructor
+  explicit TaskGroup(ThreadPool& pool) : pool(pool), outstanding(0) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  ~TaskGroup();                           // Waits for outstanding tasks
+
+  // Public Functions
+  template <typename Fn>
+  void spawn(Fn&& fn);                    // Schedules fn to run on the pool
+  void wait();                            // Runs pool tasks until every spawned task finished, then rethrows the first error
+};
+
+// Class representing a work-stealing thread pool
+// Each worker owns a Chase-Lev deque: spawned tasks go to the spawning worker's deque, idle workers steal
+class ThreadPool {
+private:
+  // A scheduled unit of work
+  struct Task {
+    std::function<void()> fn;             // Work to run
+    TaskGroup* group;                     // Group notified on completion
+  };
+
+  std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> deques;    // One deque per worker
+  std::vector<std::thread> workers;                                 // Worker threads
+  Queue<Task*> injected;                                            // Tasks spawned from outside the pool
+  std::mutex injected_mutex;                                        // Guards injected
+
+  std::atomic<size_t> pending;            // Number of queued tasks not yet picked up
+  std::atomic<size_t> sleepers;           // Number of workers blocked on wake
+  std::atomic<bool> stopping;             // Set when the pool shuts down
+  std::mutex sleep_mutex;                 // Guards the sleep/wake handshake
+  std::condition_variable wake;           // Signalled when work arrives
+
+  // Index of the calling worker in its pool, or -1 outside any pool
+  static thread_local ThreadPool* current_pool;
+  static thread_local int current_worker;
+
+  // Private helper functions
+  void worker_loop(size_t);                                         // Main loop of a worker thread
+  void enqueue(Task*);                                              // Queues a task on the caller's deque or the injection queue
+  Task* find_task();                                                // Pops local work, then steals from the injection queue and other workers
+  void run(Task*);                                                  // Runs a task and reports its completion
+  void pin(size_t);                                                 // Pins a worker thread to a CPU
+
+  friend class TaskGroup;
+public:
+  // Constructor and Destructor
+  explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()), bool pin_threads = false);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Accessors
+  const size_t size() const;                                        // Returns the number of worker threads
+
+  // Public Functions
+  template <typename Fn>
+  void parallel_for(size_t, size_t, Fn&&, size_t grain = 0);        // Runs fn(i) for every i in [begin, end), grain 0 picks one adaptively
+};
+
+// Returns the process-wide pool used by the parallel algorithms
+inline ThreadPool& default_thread_pool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+// Function definitions
+inline thread_local ThreadPool* ThreadPool::current_pool = nullptr;
+inline thread_local int ThreadPool::current_worker = -1;
+
+inline ThreadPool::ThreadPool(size_t threads, bool pin_threads) : pending(0), sleepers(0), stopping(false) {
+  if (threads == 0) threads = 1;
+
+  for (size_t i = 0; i < threads; i++) {
+    deques.emplace_back(new WorkStealingDeque<Task*>());
+  }
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    if (pin_threads) pin(i);
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+inline const size_t ThreadPool::size() const {
+  return workers.size();
+}
+
+inline void ThreadPool::pin(size_t index) {
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(index % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+  pthread_setaffinity_np(workers[index].native_handle(), sizeof(cpu_set_t), &cpus);
+#else
+  (void)index;
+#endif
+}
+
+inline void ThreadPool::enqueue(Task* task) {
+  // Count the task before publishing it so a thief can never take it before it is counted
+  pending.fetch_add(1);
+  if (current_pool == this) {
+    deques[current_worker]->push(task);
+  } else {
+    std::lock_guard<std::mutex> lock(injected_mutex);
+    injected.push(task);
+  }
+
+  // Sleepers re-check pending under the lock, so a wake-up cannot be lost between the check and the wait
+  if (sleepers.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    wake.notify_one();
+  }
+}
+
+inline ThreadPool::Task* ThreadPool::find_task() {
+  Task* task = nullptr;
+
+  if (current_pool == this && deques[current_worker]->pop(task)) {
+    pending.fetch_sub(1);
+    return task;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(injected_mutex);
+    if (!injected.empty()) {
+      task = injected.front();
+      injected.pop();
+      pending.fetch_sub(1);
+      return task;
+    }
+  }
+
+  // Try every other worker once, starting from a rotating victim
+  static thread_local size_t victim = 0;
+  for (size_t attempt = 0; attempt < deques.size(); attempt++) {
+    victim = (victim + 1) % deques.size();
+    if (current_pool == this && victim == size_t(current_worker)) continue;
+
+    if (deques[victim]->steal(task)) {
+      pending.fetch_sub(1);
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+inline void ThreadPool::run(Task* task) {
+  TaskGroup* group = task->group;
+
+  try {
+    task->fn();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(group->error_mutex);
+    if (!group->error) group->error = std::current_exception();
+  }
+
+  delete task;
+  group->outstanding.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+inline void ThreadPool::worker_loop(size_t index) {
+  current_pool = this;
+  current_worker = int(index);
+
+  while (true) {
+    Task* task = find_task();
+    if (task != nullptr) {
+      run(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    sleepers.fetch_add(1);
+    wake.wait(lock, [this] { return pending.load() > 0 || stopping.load(); });
+    sleepers.fetch_sub(1);
+
+    if (stopping.load() && pending.load() == 0) return;
+  }
+}
+
+template <typename Fn>
+void ThreadPool::parallel_for(size_t begin, size_t end, Fn&& fn, size_t grain) {
+  if (begin >= end) return;
+
+  // Aim for a handful of ranges per worker so stealing can even out uneven iterations
+  if (grain == 0) grain = std::max<size_t>(1, (end - begin) / (8 * size()));
+
+  // Queued subtasks call split, so it is declared before the group whose destructor may still run them
+  std::function<void(size_t, size_t)> split;
+  TaskGroup group(*this);
+  split = [&](size_t low, size_t high) {
+    while (high - low > grain) {
+      size_t middle = low + (high - low) / 2;
+      group.spawn([&split, middle, high] { split(middle, high); });
+      high = middle;
+    }
+    for (size_t i = low; i < high; i++) {
+      fn(i);
+    }
+  };
+
+  split(begin, end);
+  group.wait();
+}
+
+inline void TaskGroup::drain() {
+  // Help run tasks instead of blocking, so nested fork-join cannot starve the pool
+  while (outstanding.load(std::memory_order_acquire) > 0) {
+    ThreadPool::Task* task = pool.find_task();
+    if (task != nullptr) pool.run(task);
+    else std::this_thread::yield();
+  }
+}
+
+inline TaskGroup::~TaskGroup() {
+  // Tasks refer to the group, so it must outlive them even when wait() was skipped or threw
+  drain();
+}
+
+template <typename Fn>
+void TaskGroup::spawn(Fn&& fn) {
+  outstanding.fetch_add(1, std::memory_order_relaxed);
+  pool.enqueue(new ThreadPool::Task{std::function<void()>(std::forward<Fn>(fn)), this});
+}
+
+inline void TaskGroup::wait() {
+  drain();
+
+  std::lock_guard<std::mutex> lock(error_mutex);
+  if (error) {
+    std::exception_ptr thrown = error;
+    error = nullptr;
+    std::rethrow_exception(thrown);
+  }
+}
+
+#endif
@@ -0,0 +1,212 @@
+// TreeAlgorithms.hpp
+#ifndef TREEALGORITHMS_H
+#define TREEALGORITHMS_H
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "../trees/AVLTree.hpp"
+#include "../trees/BST.hpp"
+#include "ThreadPool.hpp"
+
+// Number of tree levels to fork at: enough subtrees for a few per pool worker
+inline size_t parallel_tree_depth() {
+  size_t depth = 0;
+  for (size_t subtrees = 1; subtrees < 4 * default_thread_pool().size(); subtrees *= 2) {
+    depth++;
+  }
+  return depth;
+}
+
+// Minimum number of nodes a set operation step should touch before its halves run as separate tasks
+constexpr size_t parallel_tree_grain = 1 << 12;
+
+// Fork policy for the AVLTree set operations: hands the second half of each large enough step to the pool
+struct PoolFork {
+  size_t grain;                       // Smallest step worth forking
+
+  PoolFork(size_t grain = parallel_tree_grain) : grain(grain) {}
+
+  template <typename First, typename Second>
+  void operator()(size_t work, First&& first, Second&& second) const {
+    if (work < grain) {
+      first();
+      second();
+      return;
+    }
+
+    TaskGroup group(default_thread_pool());
+    group.spawn([&second] { second(); });
+    first();
+    group.wait();
+  }
+};
+
+// Visits every node of a subtree in order on the calling thread
+template <typename Node, typename Fn>
+void subtree_for_each(Node* node, Fn& fn) {
+  if (node == nullptr) return;
+
+  subtree_for_each(node->left, fn);
+  fn(std::as_const(node->key), node->value);
+  subtree_for_each(node->right, fn);
+}
+
+// Folds every node of a subtree in order on the calling thread
+template <typename Node, typename T, typename Op>
+T subtree_reduce(const Node* node, T accumulator, Op& op) {
+  if (node == nullptr) return accumulator;
+
+  accumulator = subtree_reduce(node->left, std::move(accumulator), op);
+  accumulator = op(std::move(accumulator), node->key, node->value);
+  return subtree_reduce(node->right, std::move(accumulator), op);
+}
+
+// Visits every node of a subtree, handing the right child of each of the top levels to the pool
+template <typename Node, typename Fn>
+void parallel_subtree_for_each(Node* node, Fn& fn, size_t depth, TaskGroup& group) {
+  if (node == nullptr) return;
+  if (depth == 0) {
+    subtree_for_each(node, fn);
+    return;
+  }
+
+  group.spawn([node, &fn, depth, &group] { parallel_subtree_for_each(node->right, fn, depth - 1, group); });
+  parallel_subtree_for_each(node->left, fn, depth - 1, group);
+  fn(std::as_const(node->key), node->value);
+}
+
+// Folds a subtree, reducing the two halves of each of the top levels in parallel and combining them in order
+template <typename Node, typename T, typename Op, typename Combine>
+T parallel_subtree_reduce(const Node* node, const T& identity, Op& op, Combine& combine, size_t depth) {
+  if (node == nullptr) return identity;
+  if (depth == 0) return subtree_reduce(node, identity, op);
+
+  std::optional<T> right;
+  TaskGroup group(default_thread_pool());
+  group.spawn([&] { right = parallel_subtree_reduce(node->right, identity, op, combine, depth - 1); });
+
+  T left = parallel_subtree_reduce(node->left, identity, op, combine, depth - 1);
+  left = op(std::move(left), node->key, node->value);
+  group.wait();
+
+  return combine(std::move(left), std::move(*right));
+}
+
+// Counts a subtree, recording the sizes of the top levels by heap index (root 1, children 2i and 2i + 1)
+template <typename Node>
+size_t parallel_subtree_size(const Node* node, size_t depth, size_t index, std::vector<size_t>& sizes) {
+  if (node == nullptr) return 0;
+
+  size_t size;
+  if (depth == 0) {
+    size_t count = 0;
+    auto counter = [&count](const auto&, const auto&) { count++; };
+    subtree_for_each(node, counter);
+    size = count;
+  } else {
+    size_t right = 0;
+    TaskGroup group(default_thread_pool());
+    group.spawn([&] { right = parallel_subtree_size(node->right, depth - 1, 2 * index + 1, sizes); });
+    size_t left = parallel_subtree_size(node->left, depth - 1, 2 * index, sizes);
+    group.wait();
+    size = left + 1 + right;
+  }
+
+  sizes[index] = size;
+  return size;
+}
+
+// Copies a subtree into out[offset, offset + size) using the recorded sizes to give each task a disjoint slice
+template <typename Node, typename Pair>
+void parallel_subtree_fill(const Node* node, size_t depth, size_t index, const std::vector<size_t>& sizes, Pair* out, TaskGroup& group) {
+  if (node == nullptr) return;
+  if (depth == 0) {
+    auto writer = [&out](const auto& key, const auto& value) { *out++ = Pair(key, value); };
+    subtree_for_each(node, writer);
+    return;
+  }
+
+  size_t left = node->left == nullptr ? 0 : sizes[2 * index];
+  group.spawn([=, &sizes, &group] { parallel_subtree_fill(node->right, depth - 1, 2 * index + 1, sizes, out + left + 1, group); });
+  parallel_subtree_fill(node->left, depth - 1, 2 * index, sizes, out, group);
+  out[left] = Pair(node->key, node->value);
+}
+
+// Calls fn(key, value) on every pair of the tree; pairs are visited concurrently and in no particular order
+template <typename Key, typename Value, typename Stats, typename Compare, typename Fn>
+void parallel_for_each(AVLTree<Key, Value, Stats, Compare>& tree, Fn fn) {
+  // The tree is mutable here and only values are handed out mutably, so the root may shed its const
+  TaskGroup group(default_thread_pool());
+  parallel_subtree_for_each(const_cast<AVLTreeNode<Key, Value>*>(tree.get_root()), fn, parallel_tree_depth(), group);
+  group.wait();
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare, typename Fn>
+void parallel_for_each(BST<Key, Value, Stats, Compare>& tree, Fn fn) {
+  // The tree is mutable here and only values are handed out mutably, so the root may shed its const
+  TaskGroup group(default_thread_pool());
+  parallel_subtree_for_each(const_cast<BSTNode<Key, Value>*>(tree.get_root()), fn, parallel_tree_depth(), group);
+  group.wait();
+}
+
+// Folds op(accumulator, key, value) over the tree; identity must be neutral for combine(accumulator, accumulator)
+template <typename Key, typename Value, typename Stats, typename Compare, typename T, typename Op, typename Combine>
+T parallel_reduce(const AVLTree<Key, Value, Stats, Compare>& tree, T identity, Op op, Combine combine) {
+  return parallel_subtree_reduce(tree.get_root(), identity, op, combine, parallel_tree_depth());
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare, typename T, typename Op, typename Combine>
+T parallel_reduce(const BST<Key, Value, Stats, Compare>& tree, T identity, Op op, Combine combine) {
+  return parallel_subtree_reduce(tree.get_root(), identity, op, combine, parallel_tree_depth());
+}
+
+// Counts the pairs for which pred(key, value) holds
+template <typename Key, typename Value, typename Stats, typename Compare, typename Pred>
+size_t parallel_count_if(const AVLTree<Key, Value, Stats, Compare>& tree, Pred pred) {
+  return parallel_reduce(tree, size_t(0),
+    [&pred](size_t count, const Key& key, const Value& value) { return pred(key, value) ? count + 1 : count; },
+    [](size_t left, size_t right) { return left + right; });
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare, typename Pred>
+size_t parallel_count_if(const BST<Key, Value, Stats, Compare>& tree, Pred pred) {
+  return parallel_reduce(tree, size_t(0),
+    [&pred](size_t count, const Key& key, const Value& value) { return pred(key, value) ? count + 1 : count; },
+    [](size_t left, size_t right) { return left + right; });
+}
+
+// Join-based set operations splitting the recursion across the pool (see AVLTree::union_with)
+template <typename Key, typename Value, typename Stats, typename Compare>
+void parallel_union_with(AVLTree<Key, Value, Stats, Compare>& tree, AVLTree<Key, Value, Stats, Compare> other, size_t grain = parallel_tree_grain) {
+  tree.union_with(std::move(other), PoolFork(grain));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void parallel_intersect_with(AVLTree<Key, Value, Stats, Compare>& tree, AVLTree<Key, Value, Stats, Compare> other, size_t grain = parallel_tree_grain) {
+  tree.intersect_with(std::move(other), PoolFork(grain));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void parallel_difference(AVLTree<Key, Value, Stats, Compare>& tree, AVLTree<Key, Value, Stats, Compare> other, size_t grain = parallel_tree_grain) {
+  tree.difference(std::move(other), PoolFork(grain));
+}
+
+// Returns the tree as an in-order vector, each task filling its own slice (Key and Value must be default constructible)
+template <typename Key, typename Value, typename Stats, typename Compare>
+std::vector<std::pair<Key, Value>> parallel_to_vector(const AVLTree<Key, Value, Stats, Compare>& tree) {
+  std::vector<std::pair<Key, Value>> vector(tree.size());
+  if (tree.empty()) return vector;
+
+  size_t depth = parallel_tree_depth();
+  std::vector<size_t> sizes(size_t(2) << depth);
+  parallel_subtree_size(tree.get_root(), depth, 1, sizes);
+
+  TaskGroup group(default_thread_pool());
+  parallel_subtree_fill(tree.get_root(), depth, 1, sizes, vector.data(), group);
+  group.wait();
+  return vector;
+}
+
+#endif
@@ -0,0 +1,16 @@
+// Check.hpp
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Fails the test with the location of the condition; unlike assert it also runs in the default release build
+#define CHECK(...) do { \
+    if (!(__VA_ARGS__)) { \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #__VA_ARGS__); \
+      std::exit(1); \
+    } \
+  } while (0)
+
+#endif
@@ -0,0 +1,116 @@
+// DequeTest.cpp
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "linear/Deque.hpp"
+#include "linear/Queue.hpp"
+#include "parallel/Algorithms.hpp"
+
+// A steady-state FIFO drifts towards the back of the map, which must be recentred rather than grown
+static void test_fifo_map_stays_bounded() {
+  Deque<int> deque;
+  for (int i = 0; i < 100; i++) {
+    deque.push_back(i);
+  }
+
+  size_t settled = 0;
+  for (int i = 0; i < 2000000; i++) {
+    CHECK(deque.front() == i);
+    deque.pop_front();
+    deque.push_back(i + 100);
+    if (i == 100000) settled = deque.memory_usage().overhead;
+  }
+
+  CHECK(deque.size() == 100);
+  CHECK(deque.memory_usage().overhead == settled);
+  CHECK(deque.memory_usage().overhead < 1024);
+}
+
+// The same drift at the front, through push_front and pop_back
+static void test_reverse_fifo_map_stays_bounded() {
+  Deque<int> deque;
+  for (int i = 0; i < 1000000; i++) {
+    deque.push_front(i);
+    if (deque.size() > 300) deque.pop_back();
+  }
+
+  CHECK(deque.size() == 300);
+  CHECK(deque[0] == 999999 && deque[299] == 999700);
+  CHECK(deque.memory_usage().overhead < 1024);
+}
+
+// Queue defaults to Deque, so it must not leak map slots either
+static void test_queue_overhead_stays_bounded() {
+  Queue<int> queue;
+  for (int i = 0; i < 1000000; i++) {
+    queue.push(i);
+    if (queue.size() > 50) queue.pop();
+  }
+
+  CHECK(queue.front() == 1000000 - 50);
+  CHECK(queue.memory_usage().overhead < 1024);
+}
+
+// Growing from either end still keeps every element in order
+static void test_growth_keeps_order() {
+  Deque<int> deque;
+  for (int i = 0; i < 5000; i++) {
+    deque.push_back(i);
+    deque.push_front(-i - 1);
+  }
+
+  CHECK(deque.size() == 10000);
+  for (int i = 0; i < 10000; i++) {
+    CHECK(deque[i] == i - 5000);
+  }
+}
+
+// The iterators are random access, so sorting, binary search and the parallel algorithms run on a Deque
+static void test_random_access_iterators() {
+  static_assert(std::is_same<std::iterator_traits<Deque<int>::Iterator>::iterator_category, std::random_access_iterator_tag>::value, "Deque iterators must be random access");
+
+  Deque<int> deque;
+  std::vector<int> reference;
+  std::mt19937 rng(3);
+  for (int i = 0; i < 5000; i++) {
+    int value = int(rng() % 100000);
+    if (i % 2 == 0) {
+      deque.push_back(value);
+      reference.push_back(value);
+    } else {
+      deque.push_front(value);
+      reference.insert(reference.begin(), value);
+    }
+  }
+
+  std::sort(deque.begin(), deque.end());
+  std::sort(reference.begin(), reference.end());
+  const Deque<int>& view = deque;
+  CHECK(std::equal(view.begin(), view.end(), reference.begin(), reference.end()));
+
+  for (int probe = 0; probe < 100000; probe += 997) {
+    auto found = std::lower_bound(view.begin(), view.end(), probe);
+    CHECK(found - view.begin() == std::lower_bound(reference.begin(), reference.end(), probe) - reference.begin());
+  }
+
+  Deque<int>::Iterator it = deque.begin() + 100;
+  Deque<int>::ConstIterator cit = view.begin() + 100;
+  CHECK(it == cit && cit <= it && view.end() - it == 4900 && it[5] == reference[105] && *(it - 1) == reference[99]);
+
+  long total = 0;
+  for (int value : reference) total += value;
+  CHECK(parallel_reduce(view.begin(), view.end(), 0L, std::plus<>(), 64) == total);
+}
+
+int main() {
+  test_fifo_map_stays_bounded();
+  test_reverse_fifo_map_stays_bounded();
+  test_queue_overhead_stays_bounded();
+  test_growth_keeps_order();
+  test_random_access_iterators();
+  return 0;
+}
@@ -0,0 +1,169 @@
+// HeapTest.cpp
+#include <functional>
+#include <iterator>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "Check.hpp"
+#include "heaps/DaryHeap.hpp"
+#include "heaps/PairingHeap.hpp"
+
+// Pushes and pops against std::priority_queue, with bulk loads mixed in
+template <typename Heap>
+static void test_against_priority_queue() {
+  Heap heap;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+  std::mt19937 rng(5);
+
+  for (int step = 0; step < 50000; step++) {
+    unsigned choice = rng() % 10;
+    if (choice < 5) {
+      int value = int(rng() % 1000);
+      heap.push(value);
+      reference.push(value);
+    } else if (choice == 5) {
+      std::vector<int> values(rng() % 40);
+      for (int& value : values) value = int(rng() % 1000);
+      heap.push_many(values.begin(), values.end());
+      for (int value : values) reference.push(value);
+    } else if (!reference.empty()) {
+      CHECK(heap.top() == reference.top() && *heap.try_top() == reference.top());
+      CHECK(heap.take() == reference.top());
+      reference.pop();
+    }
+    CHECK(heap.size() == int(reference.size()) && heap.empty() == reference.empty());
+  }
+
+  while (!reference.empty()) {
+    CHECK(heap.take() == reference.top());
+    reference.pop();
+  }
+  CHECK(heap.empty() && heap.try_top() == nullptr);
+}
+
+// Drives handle operations with unique values, so the reference can map every value to its handle
+template <typename Heap>
+struct HandleModel {
+  Heap heap;
+  std::map<int, typename Heap::Handle> live;      // Value of every element in the heap and its handle
+  std::mt19937 rng;
+
+  HandleModel() : rng(9) {}
+
+  // Returns a value in [low, low + 4096) that no live element holds
+  int fresh_value(int low) {
+    while (true) {
+      int value = low + int(rng() % 4096);
+      if (live.count(value) == 0) return value;
+    }
+  }
+
+  typename std::map<int, typename Heap::Handle>::iterator pick() {
+    auto it = live.begin();
+    std::advance(it, rng() % live.size());
+    return it;
+  }
+
+  void step() {
+    unsigned choice = rng() % 7;
+    if (choice < 2 || live.empty()) {
+      int value = fresh_value(int(rng() % (1 << 20)));
+      live.emplace(value, heap.push(value));
+    } else if (choice == 2) {
+      CHECK(heap.top() == live.begin()->first);
+      heap.pop();
+      live.erase(live.begin());
+    } else if (choice == 3) {
+      auto it = pick();
+      heap.erase(it->second);
+      live.erase(it);
+    } else if (choice == 4) {
+      auto it = pick();
+      int value = fresh_value(it->first - 4096);
+      typename Heap::Handle handle = it->second;
+      heap.decrease_key(handle, value);
+      live.erase(it);
+      live.emplace(value, handle);
+    } else {
+      auto it = pick();
+      int value = fresh_value(int(rng() % (1 << 20)));
+      typename Heap::Handle handle = it->second;
+      heap.update(handle, value);
+      live.erase(it);
+      live.emplace(value, handle);
+    }
+  }
+
+  void check() {
+    CHECK(heap.size() == int(live.size()));
+    if (!live.empty()) CHECK(heap.top() == live.begin()->first);
+    for (const auto& pair : live) {
+      CHECK(heap.get(pair.second) == pair.first);
+    }
+  }
+};
+
+template <typename Heap>
+static void test_handles() {
+  HandleModel<Heap> model;
+  for (int step = 0; step < 30000; step++) {
+    model.step();
+    if (step % 1000 == 0) model.check();
+  }
+  model.check();
+
+  while (!model.live.empty()) {
+    CHECK(model.heap.take() == model.live.begin()->first);
+    model.live.erase(model.live.begin());
+  }
+  CHECK(model.heap.empty());
+}
+
+// Released DaryHeap handles read as dead until they are reused
+static void test_dary_released_handles() {
+  DaryHeap<int> heap;
+  DaryHeap<int>::Handle first = heap.push(3);
+  DaryHeap<int>::Handle second = heap.push(1);
+  heap.pop();
+  CHECK(heap.try_get(second) == nullptr && *heap.try_get(first) == 3);
+  heap.erase(first);
+  CHECK(heap.try_get(first) == nullptr && heap.empty());
+}
+
+// Merging moves every node across, so handles from both heaps keep working
+static void test_pairing_merge() {
+  HandleModel<PairingHeap<int>> left, right;
+  for (int step = 0; step < 2000; step++) {
+    left.step();
+    right.step();
+  }
+
+  // Values of the two heaps may collide, so the merged reference is a multimap
+  std::multimap<int, PairingHeap<int>::Handle> merged(left.live.begin(), left.live.end());
+  merged.insert(right.live.begin(), right.live.end());
+  left.heap.merge(right.heap);
+  CHECK(right.heap.empty() && left.heap.size() == int(merged.size()));
+
+  for (const auto& pair : merged) {
+    CHECK(left.heap.get(pair.second) == pair.first);
+  }
+  for (const auto& pair : merged) {
+    CHECK(left.heap.take() == pair.first);
+  }
+  CHECK(left.heap.empty());
+}
+
+int main() {
+  test_against_priority_queue<DaryHeap<int>>();
+  test_against_priority_queue<DaryHeap<int, std::less<int>, 2>>();
+  test_against_priority_queue<PairingHeap<int>>();
+  test_handles<DaryHeap<int>>();
+  test_handles<DaryHeap<int, std::less<int>, 8>>();
+  test_handles<PairingHeap<int>>();
+  test_dary_released_handles();
+  test_pairing_merge();
+  return 0;
+}
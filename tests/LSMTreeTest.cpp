@@ -0,0 +1,169 @@
+// LSMTreeTest.cpp
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Check.hpp"
+#include "io/LSMTree.hpp"
+
+// Returns a fresh, empty directory for one test
+static std::string fresh_directory(const std::string& name) {
+  std::string directory = "lsm_tree_test_" + name;
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+// Filters saved without the byte hash tag (e.g. by another build) are rebuilt instead of hiding keys
+static void test_foreign_filters_are_rebuilt() {
+  std::string directory = fresh_directory("filters");
+  {
+    LSMTree<uint64_t, uint64_t> tree(directory, 256);
+    for (uint64_t i = 0; i < 2000; i++) {
+      tree.insert(i * 7, i);
+    }
+  }
+
+  // An all-zero filter with no tag stands in for bits computed with a different hash
+  int replaced = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (entry.path().extension() != ".bloom") continue;
+
+    MappedVector<uint64_t> bits(entry.path().string());
+    CHECK(bits.tag() == BloomByteHash<uint64_t>::tag);
+    Vector<uint64_t> zeros(bits.size(), 10);
+    for (size_t i = 0; i < bits.size(); i++) {
+      zeros.push_back(0);
+    }
+    bits = MappedVector<uint64_t>();
+    save(zeros, entry.path().string());
+    replaced++;
+  }
+  CHECK(replaced > 0);
+
+  for (int reopen = 0; reopen < 2; reopen++) {
+    LSMTree<uint64_t, uint64_t> tree(directory, 256);
+    for (uint64_t i = 0; i < 2000; i++) {
+      CHECK(tree.search(i * 7) == i);
+    }
+    CHECK(!tree.try_get(3).has_value());
+  }
+
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (entry.path().extension() == ".bloom") CHECK(MappedVector<uint64_t>(entry.path().string()).tag() == BloomByteHash<uint64_t>::tag);
+  }
+  std::filesystem::remove_all(directory);
+}
+
+// Checks every lookup and the full ordered scan against the reference
+static void check_same(const LSMTree<uint64_t, uint64_t>& tree, const std::map<uint64_t, uint64_t>& reference, uint64_t key_range) {
+  for (uint64_t key = 0; key < key_range; key++) {
+    auto found = reference.find(key);
+    std::optional<uint64_t> value = tree.try_get(key);
+    CHECK(value.has_value() == (found != reference.end()));
+    if (value.has_value()) CHECK(*value == found->second && tree.search(key) == found->second);
+    CHECK(tree.contains(key) == (found != reference.end()));
+  }
+
+  auto expected = reference.begin();
+  tree.for_each([&](const uint64_t& key, const uint64_t& value) {
+    CHECK(expected != reference.end() && key == expected->first && value == expected->second);
+    ++expected;
+  });
+  CHECK(expected == reference.end());
+}
+
+// Random writes and deletions against std::map with a tiny memtable, so flushes and merges run all the time,
+// reopening the tree now and then to recover it from the manifest
+static void test_against_map() {
+  std::string directory = fresh_directory("differential");
+  const uint64_t key_range = 3000;
+  std::map<uint64_t, uint64_t> reference;
+  std::mt19937_64 rng(17);
+  size_t flushes = 0;
+
+  for (int session = 0; session < 4; session++) {
+    LSMTree<uint64_t, uint64_t> tree(directory, 64, 2);
+    check_same(tree, reference, key_range);
+
+    for (int step = 0; step < 20000; step++) {
+      uint64_t key = rng() % key_range;
+      if (rng() % 4 == 0) {
+        tree.remove(key);
+        reference.erase(key);
+      } else {
+        uint64_t value = rng();
+        tree.insert(key, value);
+        reference[key] = value;
+      }
+
+      if (step % 2500 == 0) {
+        tree.flush();
+        flushes++;
+        check_same(tree, reference, key_range);
+      }
+    }
+    check_same(tree, reference, key_range);
+
+    // Each flush adds a run and every pair of runs of a level merges, so the run count stays logarithmic
+    tree.flush();
+    CHECK(tree.run_count() < 64);
+  }
+
+  // Scoped so the background thread has stopped merging before the directory is removed
+  {
+    LSMTree<uint64_t, uint64_t> reopened(directory, 64, 2);
+    check_same(reopened, reference, key_range);
+  }
+  CHECK(flushes > 0);
+  std::filesystem::remove_all(directory);
+}
+
+// A process dying without closing the tree keeps everything flushed before, and loses only the memtable
+static void test_recovery_after_crash() {
+  std::string directory = fresh_directory("crash");
+
+  pid_t child = ::fork();
+  CHECK(child >= 0);
+  if (child == 0) {
+    LSMTree<uint64_t, uint64_t> tree(directory, 128, 3);
+    for (uint64_t i = 0; i < 1000; i++) {
+      tree.insert(i, i * 3);
+    }
+    tree.remove(10);
+    tree.flush();
+    for (uint64_t i = 1000; i < 1050; i++) {
+      tree.insert(i, i);
+    }
+    ::_exit(0);
+  }
+
+  int status = 0;
+  CHECK(::waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  std::map<uint64_t, uint64_t> reference;
+  for (uint64_t i = 0; i < 1000; i++) {
+    if (i != 10) reference[i] = i * 3;
+  }
+
+  // Writes after the last flush may or may not have reached a run, but no flushed write may be missing
+  {
+    LSMTree<uint64_t, uint64_t> tree(directory, 128, 3);
+    for (const auto& pair : reference) {
+      CHECK(tree.search(pair.first) == pair.second);
+    }
+    CHECK(!tree.contains(10));
+  }
+  std::filesystem::remove_all(directory);
+}
+
+int main() {
+  test_foreign_filters_are_rebuilt();
+  test_against_map();
+  test_recovery_after_crash();
+  return 0;
+}
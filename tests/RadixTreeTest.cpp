@@ -0,0 +1,115 @@
+// RadixTreeTest.cpp
+#include <map>
+#include <random>
+#include <string>
+
+#include "Check.hpp"
+#include "trees/RadixTree.hpp"
+
+// Draws keys that exercise every node kind: narrow alphabets build long compressed paths and nested terminals,
+// any-byte keys fill Node48 and Node256, and shared stems keep splitting the same prefix, one short enough
+// to stay inside the node and one long enough to spill to the heap
+static std::string random_key(std::mt19937& rng) {
+  std::string key;
+  switch (rng() % 4) {
+    case 0:
+      for (size_t i = 0, n = rng() % 12; i < n; i++) key.push_back("ab"[rng() % 2]);
+      break;
+    case 1:
+      for (size_t i = 0, n = 1 + rng() % 3; i < n; i++) key.push_back(char(rng() % 256));
+      break;
+    case 2:
+      key = "shared/stem/" + std::to_string(rng() % 500);
+      break;
+    default:
+      key = "a/much/longer/shared/stem/" + std::to_string(rng() % 2000) + std::string(rng() % 20, 'x');
+  }
+  return key;
+}
+
+// Checks every pair, the iteration order and the prefix queries against the reference
+static void check_same(const RadixTree<int>& tree, const std::map<std::string, int>& reference, std::mt19937& rng) {
+  CHECK(tree.size() == int(reference.size()));
+
+  auto expected = reference.begin();
+  for (auto it = tree.begin(); it != tree.end(); ++it, ++expected) {
+    CHECK(expected != reference.end());
+    CHECK(it.get_key() == expected->first && it.get_value() == expected->second);
+  }
+  CHECK(expected == reference.end());
+
+  for (int i = 0; i < 20; i++) {
+    std::string prefix = random_key(rng);
+    prefix.resize(prefix.size() / 2);
+
+    size_t count = 0;
+    for (auto it = reference.lower_bound(prefix); it != reference.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+      count++;
+    }
+    CHECK(tree.count_prefix(prefix) == count);
+  }
+}
+
+// Random inserts, overwrites and removals against std::map
+static void test_against_map() {
+  RadixTree<int> tree;
+  std::map<std::string, int> reference;
+  std::mt19937 rng(42);
+
+  for (int step = 0; step < 60000; step++) {
+    std::string key = random_key(rng);
+    int value = int(rng() % 1000);
+
+    switch (rng() % 6) {
+      case 0:
+        tree.insert(key, value);
+        reference.emplace(key, value);
+        break;
+      case 1:
+        CHECK(tree.insert_or_assign(key, value) == (reference.count(key) == 0));
+        reference[key] = value;
+        break;
+      case 2:
+        CHECK(tree.get_or_insert(key, value) == reference.emplace(key, value).first->second);
+        break;
+      case 3: case 4:
+        tree.remove(key);
+        reference.erase(key);
+        break;
+      default: {
+        auto found = reference.find(key);
+        const int* value_found = tree.find(key);
+        CHECK((value_found == nullptr) == (found == reference.end()));
+        if (value_found != nullptr) CHECK(*value_found == found->second && tree.search(key) == found->second);
+        CHECK(tree.contains(key) == (found != reference.end()));
+      }
+    }
+
+    if (step % 5000 == 0) check_same(tree, reference, rng);
+  }
+  check_same(tree, reference, rng);
+
+  // Copies are deep and prefix visits run in key order
+  RadixTree<int> copy(tree);
+  check_same(copy, reference, rng);
+  std::string last;
+  bool first = true;
+  copy.for_each_prefix("shared/stem/", [&](const std::string& key, int& value) {
+    CHECK(key.compare(0, 12, "shared/stem/") == 0 && value == reference.at(key));
+    CHECK(first || last < key);
+    last = key;
+    first = false;
+  });
+
+  // Draining every key leaves an empty tree
+  for (const auto& pair : reference) {
+    tree.remove(pair.first);
+  }
+  CHECK(tree.empty() && tree.size() == 0 && !(tree.begin() != tree.end()));
+  check_same(copy, reference, rng);
+}
+
+int main() {
+  test_against_map();
+  return 0;
+}
@@ -0,0 +1,133 @@
+// SerializationTest.cpp
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "io/LSMTree.hpp"
+#include "io/Serialization.hpp"
+#include "trees/AVLTree.hpp"
+#include "trees/BST.hpp"
+
+// Returns the bytes of a file
+static std::vector<char> read_bytes(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Leaves garbage on the heap and the stack, where the next records are likely to be built
+static void __attribute__((noinline)) dirty_memory() {
+  for (size_t size = 64; size <= (1 << 16); size *= 2) {
+    char* block = new char[size];
+    std::memset(block, 0xAB, size);
+    delete[] block;
+  }
+
+  volatile char stack[1 << 14];
+  for (size_t i = 0; i < sizeof(stack); i++) {
+    stack[i] = char(0xAB);
+  }
+}
+
+// An int key followed by a double value leaves four bytes of padding in every record
+static void test_pair_padding_is_zeroed() {
+  using Pair = SerializedPair<int, double>;
+  static_assert(sizeof(Pair) > sizeof(int) + sizeof(double), "Test needs a padded record");
+
+  AVLTree<int, double> tree;
+  for (int i = 0; i < 1000; i++) {
+    tree.insert(i, i * 0.5);
+  }
+
+  dirty_memory();
+  std::vector<Pair> pairs = serial_pairs<int, double>(tree.get_root());
+  CHECK(pairs.size() == 1000);
+
+  const char* bytes = reinterpret_cast<const char*>(pairs.data());
+  for (size_t i = 0; i < pairs.size(); i++) {
+    for (size_t b = sizeof(int); b < offsetof(Pair, second); b++) {
+      CHECK(bytes[i * sizeof(Pair) + b] == 0);
+    }
+  }
+}
+
+// Saving the same tree twice must give the same bytes, checksum included
+static void test_save_is_deterministic() {
+  AVLTree<int, double> tree;
+  for (int i = 0; i < 5000; i++) {
+    tree.insert((i * 7919) % 5000, i * 0.25);
+  }
+
+  const std::string first = "serialization_test_first.bin";
+  const std::string second = "serialization_test_second.bin";
+  save(tree, first);
+  dirty_memory();
+  save(tree, second);
+
+  std::vector<char> first_bytes = read_bytes(first);
+  CHECK(!first_bytes.empty());
+  CHECK(first_bytes == read_bytes(second));
+
+  MappedTree<int, double> mapped(second);
+  CHECK(mapped.size() == 5000);
+  for (int i = 0; i < 5000; i++) {
+    CHECK(mapped.contains(i));
+  }
+  CHECK(mapped.find(5000) == nullptr);
+
+  std::remove(first.c_str());
+  std::remove(second.c_str());
+}
+
+// Trees are streamed to disk in batches, so sizes around and across a batch must all come back whole
+static void test_saved_trees_round_trip() {
+  const size_t batch = serial_batch_bytes / sizeof(SerializedPair<int, double>);
+  const std::string path = "serialization_test_round_trip.bin";
+
+  for (size_t n : {size_t(0), size_t(1), batch - 1, batch, batch + 1, 5 * batch + 3}) {
+    AVLTree<int, double> avl;
+    BST<int, double> bst;
+    for (size_t i = 0; i < n; i++) {
+      int key = int((i * 7919) % n);
+      avl.insert(key, key * 0.5);
+      bst.insert(key, key * 0.5);
+    }
+
+    save(avl, path);
+    MappedTree<int, double> mapped(path);
+    CHECK(mapped.size() == n);
+    for (size_t i = 0; i < n; i++) {
+      CHECK(mapped.data()[i].first == int(i) && mapped.data()[i].second == int(i) * 0.5);
+    }
+
+    save(bst, path);
+    BST<int, double> loaded = load_bst<int, double>(path);
+    CHECK(loaded.count_if([](int, double) { return true; }) == n);
+    for (size_t i = 0; i < n; i++) {
+      CHECK(loaded.search(int(i)) == int(i) * 0.5);
+    }
+  }
+  std::remove(path.c_str());
+}
+
+// LSM entries are copied into the runs byte for byte, so their own padding must be zero too
+static void test_lsm_entry_padding_is_zeroed() {
+  LSMEntry<double> entry = make_entry(1.5, 1);
+  const char* bytes = reinterpret_cast<const char*>(&entry);
+  for (size_t b = offsetof(LSMEntry<double>, deleted) + 1; b < sizeof(entry); b++) {
+    CHECK(bytes[b] == 0);
+  }
+  CHECK(entry.value == 1.5 && entry.deleted == 1);
+}
+
+int main() {
+  test_pair_padding_is_zeroed();
+  test_save_is_deterministic();
+  test_saved_trees_round_trip();
+  test_lsm_entry_padding_is_zeroed();
+  return 0;
+}
@@ -0,0 +1,132 @@
+// SmallVectorTest.cpp
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Check.hpp"
+#include "linear/SmallVector.hpp"
+#include "linear/Vector.hpp"
+
+// Returns a value of the element type for a number
+template <typename T>
+static T make_value(int number) {
+  if constexpr (std::is_same<T, std::string>::value) {
+    return "value-" + std::to_string(number);
+  } else {
+    return T(number);
+  }
+}
+
+// Checks a container against a reference vector, through both the const and the mutable iterators
+template <typename V, typename T>
+static void check_same(V& vector, const std::vector<T>& reference) {
+  const V& view = vector;
+  CHECK(vector.size() == reference.size());
+  CHECK(std::equal(view.begin(), view.end(), reference.begin(), reference.end()));
+  CHECK(size_t(vector.end() - vector.begin()) == reference.size());
+}
+
+// Drives random edits through the interface Vector and SmallVector share, so either can stand in for the other
+template <typename V, typename T>
+static void test_shared_interface() {
+  V vector;
+  std::vector<T> reference;
+  std::mt19937 rng(11);
+
+  for (int step = 0; step < 4000; step++) {
+    T value = make_value<T>(int(rng() % 64));
+    switch (rng() % 8) {
+      case 0: case 1: vector.push_back(value); reference.push_back(value); break;
+      case 2: {
+        int index = int(rng() % (reference.size() + 1));
+        vector.emplace(index, value);
+        reference.insert(reference.begin() + index, value);
+        break;
+      }
+      case 3: {
+        std::vector<T> items(rng() % 5, value);
+        size_t index = rng() % (reference.size() + 1);
+        vector.insert(vector.begin() + index, items.begin(), items.end());
+        reference.insert(reference.begin() + index, items.begin(), items.end());
+        break;
+      }
+      case 4:
+        if (!reference.empty()) {
+          size_t from = rng() % reference.size();
+          size_t to = std::min(reference.size(), from + rng() % 4);
+          vector.erase(vector.begin() + from, vector.begin() + to);
+          reference.erase(reference.begin() + from, reference.begin() + to);
+        }
+        break;
+      case 5:
+        if (!reference.empty()) {
+          size_t index = rng() % reference.size();
+          vector.swap_remove(int(index));
+          reference[index] = reference.back();
+          reference.pop_back();
+        }
+        break;
+      case 6:
+        if (step % 40 == 0) {
+          CHECK(vector.erase_if([&](const T& item) { return item == value; }) == size_t(std::count(reference.begin(), reference.end(), value)));
+          reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+        }
+        break;
+      default:
+        if (!reference.empty()) {
+          vector.erase(vector.begin() + reference.size() - 1);
+          reference.pop_back();
+        }
+    }
+    check_same(vector, reference);
+  }
+
+  // Scans
+  T probe = make_value<T>(5);
+  auto position = std::find(reference.begin(), reference.end(), probe);
+  CHECK(vector.find(probe) == (position == reference.end() ? -1 : int(position - reference.begin())));
+  CHECK(vector.contains(probe) == (position != reference.end()));
+  CHECK(vector.count(probe) == size_t(std::count(reference.begin(), reference.end(), probe)));
+  if (!reference.empty()) {
+    CHECK(vector.min() == *std::min_element(reference.begin(), reference.end()));
+    CHECK(vector.max() == *std::max_element(reference.begin(), reference.end()));
+  }
+
+  auto selective = [&](const T& item) { return item < probe; };
+  V filtered = vector.filter(selective);
+  std::vector<T> expected;
+  std::copy_if(reference.begin(), reference.end(), std::back_inserter(expected), selective);
+  check_same(filtered, expected);
+
+  // The iterators work with <algorithm> like a Vector's
+  std::sort(vector.begin(), vector.end());
+  std::sort(reference.begin(), reference.end());
+  check_same(vector, reference);
+  CHECK(std::binary_search(vector.begin(), vector.end(), probe) == std::binary_search(reference.begin(), reference.end(), probe));
+}
+
+// Filtering a spilled vector down to a few elements brings the result back inline
+static void test_filter_result_fits_inline() {
+  SmallVector<int, 8> vector;
+  for (int i = 0; i < 100; i++) {
+    vector.push_back(i);
+  }
+  CHECK(vector.on_heap());
+  CHECK(vector.sum() == 4950);
+
+  SmallVector<int, 8> small = vector.filter([](int value) { return value % 20 == 0; });
+  CHECK(small.size() == 5 && !small.on_heap());
+
+  SmallVector<int, 8> large = vector.filter([](int value) { return value % 2 == 0; });
+  CHECK(large.size() == 50 && large.current_capacity() == 50);
+}
+
+int main() {
+  test_shared_interface<Vector<int>, int>();
+  test_shared_interface<SmallVector<int, 8>, int>();
+  test_shared_interface<SmallVector<std::string, 4>, std::string>();
+  test_shared_interface<Vector<std::string>, std::string>();
+  test_filter_result_fits_inline();
+  return 0;
+}
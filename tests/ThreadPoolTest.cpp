@@ -0,0 +1,58 @@
+// ThreadPoolTest.cpp
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "Check.hpp"
+#include "parallel/ThreadPool.hpp"
+
+// fn throwing on the calling thread leaves subtasks queued, which the group must still run safely before unwinding
+static void test_parallel_for_caller_throws() {
+  ThreadPool pool(1);
+  std::atomic<size_t> done(0);
+  bool caught = false;
+
+  try {
+    pool.parallel_for(0, 256, [&](size_t i) {
+      if (i == 0) throw std::runtime_error("caller failed");
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      done.fetch_add(1);
+    }, 1);
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+
+  CHECK(caught);
+  CHECK(done.load() == 255);
+}
+
+// An exception thrown on a worker reaches the caller too
+static void test_parallel_for_worker_throws() {
+  ThreadPool pool(2);
+  bool caught = false;
+
+  try {
+    pool.parallel_for(0, 1024, [](size_t i) {
+      if (i == 1000) throw std::runtime_error("worker failed");
+    }, 1);
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+
+  CHECK(caught);
+}
+
+static void test_parallel_for_visits_every_index() {
+  ThreadPool pool(2);
+  std::atomic<size_t> sum(0);
+  pool.parallel_for(0, 10000, [&](size_t i) { sum.fetch_add(i); });
+  CHECK(sum.load() == size_t(10000) * 9999 / 2);
+}
+
+int main() {
+  test_parallel_for_caller_throws();
+  test_parallel_for_worker_throws();
+  test_parallel_for_visits_every_index();
+  return 0;
+}
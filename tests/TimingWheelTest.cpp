@@ -0,0 +1,116 @@
+// TimingWheelTest.cpp
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "timers/TimingWheel.hpp"
+
+// Schedules, reschedules, cancels and advances against a map of deadlines, checking each advance fires exactly the timers
+// whose tick has been reached; a small wheel makes timers cascade through every level and wait beyond the last one
+template <size_t Levels, size_t SlotBits>
+static void test_against_map(uint64_t resolution, uint64_t seed) {
+  using Wheel = TimingWheel<int, Levels, SlotBits>;
+  Wheel wheel(resolution, 1000 * resolution);
+  std::map<int, uint64_t> deadlines;                          // Tick each pending timer fires at
+  std::map<int, typename Wheel::Handle> handles;              // Handle of each pending timer
+  std::vector<typename Wheel::Handle> stale;                  // Handles of timers that fired or were cancelled
+  std::mt19937_64 rng(seed);
+  const uint64_t span = uint64_t(1) << (SlotBits * Levels);
+  int next_id = 0;
+
+  auto random_deadline = [&]() {
+    uint64_t delay;
+    switch (rng() % 4) {
+      case 0: delay = rng() % 4; break;
+      case 1: delay = rng() % (2 << SlotBits); break;
+      case 2: delay = rng() % span; break;
+      default: delay = rng() % (4 * span);
+    }
+    return wheel.now() + delay * resolution + rng() % resolution;
+  };
+  auto tick_of = [&](uint64_t deadline) { return deadline / resolution + (deadline % resolution != 0); };
+
+  for (int step = 0; step < 20000; step++) {
+    unsigned choice = rng() % 8;
+    if (choice < 3) {
+      uint64_t deadline = random_deadline();
+      handles[next_id] = wheel.schedule(deadline, next_id);
+      deadlines[next_id] = tick_of(deadline);
+      next_id++;
+    } else if (choice == 3 && !handles.empty()) {
+      auto it = handles.begin();
+      std::advance(it, rng() % handles.size());
+      uint64_t deadline = random_deadline();
+      CHECK(wheel.reschedule(it->second, deadline));
+      deadlines[it->first] = tick_of(deadline);
+    } else if (choice == 4 && !handles.empty()) {
+      auto it = handles.begin();
+      std::advance(it, rng() % handles.size());
+      CHECK(wheel.cancel(it->second));
+      stale.push_back(it->second);
+      deadlines.erase(it->first);
+      handles.erase(it);
+    } else {
+      uint64_t time = wheel.now() + (rng() % (3 << SlotBits)) * resolution + rng() % resolution;
+      uint64_t tick = time / resolution;
+
+      std::vector<int> fired;
+      size_t count = wheel.advance(time, [&](int id) { fired.push_back(id); });
+      CHECK(count == fired.size());
+      CHECK(wheel.now() == tick * resolution);
+
+      std::vector<int> expected;
+      for (const auto& pair : deadlines) {
+        if (pair.second <= tick) expected.push_back(pair.first);
+      }
+      std::sort(fired.begin(), fired.end());
+      CHECK(fired == expected);
+
+      for (int id : fired) {
+        CHECK(!wheel.pending(handles[id]));
+        stale.push_back(handles[id]);
+        handles.erase(id);
+        deadlines.erase(id);
+      }
+    }
+
+    CHECK(wheel.size() == int(handles.size()));
+    if (!stale.empty()) {
+      typename Wheel::Handle handle = stale[rng() % stale.size()];
+      CHECK(!wheel.pending(handle) && !wheel.cancel(handle) && !wheel.reschedule(handle, 0));
+    }
+  }
+
+  // Running the clock far ahead fires everything still pending
+  size_t remaining = handles.size();
+  CHECK(wheel.advance(wheel.now() + 16 * span * resolution, [](int) {}) == remaining);
+  CHECK(wheel.empty());
+}
+
+// Timers a callback schedules for a time already reached fire on the next advance, not the current one
+static void test_callback_schedules_due_timer() {
+  TimingWheel<int> wheel;
+  wheel.schedule(10, 1);
+
+  std::vector<int> fired;
+  wheel.advance(10, [&](int id) {
+    fired.push_back(id);
+    if (id == 1) wheel.schedule(5, 2);
+  });
+  CHECK(fired == std::vector<int>{1} && wheel.size() == 1);
+
+  wheel.advance(10, [&](int id) { fired.push_back(id); });
+  CHECK((fired == std::vector<int>{1, 2}) && wheel.empty());
+}
+
+int main() {
+  test_against_map<3, 3>(1, 1);
+  test_against_map<2, 4>(7, 2);
+  test_against_map<1, 5>(1, 3);
+  test_against_map<4, 8>(3, 4);
+  test_callback_schedules_due_timer();
+  return 0;
+}
@@ -0,0 +1,120 @@
+// TreeTest.cpp
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include "Check.hpp"
+#include "trees/AVLTree.hpp"
+#include "trees/BST.hpp"
+#include "parallel/TreeAlgorithms.hpp"
+
+// Orders unique_ptr keys by what they point to, so a fresh pointer can look up an equal key
+struct PointeeCompare {
+  int operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const {
+    return int(*b < *a) - int(*a < *b);
+  }
+};
+
+// Inserts and removes move-only keys and values, which the removal of nodes with two children must not copy
+template <typename Tree>
+static void test_move_only_keys() {
+  Tree tree;
+  for (int i = 0; i < 200; i++) {
+    int key = (i * 37) % 200;
+    CHECK(tree.try_emplace(std::make_unique<int>(key), std::make_unique<int>(key * 2)));
+  }
+
+  // Every other key goes, most of them from nodes with two children
+  for (int key = 0; key < 200; key += 2) {
+    tree.remove(std::make_unique<int>(key));
+  }
+
+  for (int key = 0; key < 200; key++) {
+    const std::unique_ptr<int>* value = tree.find(std::make_unique<int>(key));
+    CHECK((value != nullptr) == (key % 2 == 1));
+    if (value != nullptr) CHECK(**value == key * 2);
+  }
+
+  int previous = -1;
+  size_t count = 0;
+  tree.for_each([&](const std::unique_ptr<int>& key, const std::unique_ptr<int>&) {
+    CHECK(*key > previous);
+    previous = *key;
+    count++;
+  });
+  CHECK(count == 100);
+}
+
+// Random inserts and removals agree with std::map, and the AVL tree keeps its height logarithmic
+static void test_random_removals() {
+  AVLTree<int, int> avl;
+  BST<int, int> bst;
+  std::map<int, int> reference;
+  std::mt19937 rng(3);
+
+  for (int step = 0; step < 50000; step++) {
+    int key = int(rng() % 2000);
+    if (rng() % 2 == 0) {
+      avl.insert(key, step);
+      bst.insert(key, step);
+      reference.emplace(key, step);
+    } else {
+      avl.remove(key);
+      bst.remove(key);
+      reference.erase(key);
+    }
+  }
+
+  CHECK(avl.size() == int(reference.size()));
+  CHECK(avl.height() <= int(1.45 * std::log2(reference.size() + 2)));
+  for (const auto& [key, value] : reference) {
+    CHECK(avl.search(key) == value);
+    CHECK(bst.search(key) == value);
+  }
+  for (int key = 0; key < 2000; key++) {
+    CHECK(avl.contains(key) == (reference.count(key) > 0));
+    CHECK(bst.contains(key) == (reference.count(key) > 0));
+  }
+
+  // split sizes its halves from the cached subtree sizes, which the removals must have kept in step
+  AVLTree<int, int> less, greater;
+  avl.split(1000, less, greater);
+  auto middle = reference.lower_bound(1000);
+  CHECK(less.size() == int(std::distance(reference.begin(), middle)));
+  CHECK(greater.size() == int(reference.size()) - less.size() - avl.size());
+}
+
+// Visitors may change values but must only ever see const keys, and the root is only handed out read-only
+template <typename Tree>
+static void test_visitors_see_const_keys() {
+  static_assert(std::is_const<std::remove_pointer_t<decltype(std::declval<Tree&>().get_root())>>::value, "get_root must not expose a mutable node");
+
+  Tree tree;
+  for (int i = 0; i < 1000; i++) {
+    tree.insert(i, i);
+  }
+
+  auto increment = [](auto& key, auto& value) {
+    static_assert(std::is_const<std::remove_reference_t<decltype(key)>>::value, "Visitors must not be able to rewrite keys");
+    value += 1;
+  };
+  tree.for_each(increment);
+  parallel_for_each(tree, increment);
+
+  for (int i = 0; i < 1000; i++) {
+    CHECK(tree.search(i) == i + 2);
+  }
+}
+
+int main() {
+  test_move_only_keys<AVLTree<std::unique_ptr<int>, std::unique_ptr<int>, NoTreeStats, PointeeCompare>>();
+  test_move_only_keys<BST<std::unique_ptr<int>, std::unique_ptr<int>, NoTreeStats, PointeeCompare>>();
+  test_random_removals();
+  test_visitors_see_const_keys<AVLTree<int, int>>();
+  test_visitors_see_const_keys<BST<int, int>>();
+  return 0;
+}
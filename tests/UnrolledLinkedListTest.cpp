@@ -0,0 +1,77 @@
+// UnrolledLinkedListTest.cpp
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Check.hpp"
+#include "linear/UnrolledLinkedList.hpp"
+
+// Checks a list against a reference vector element by element
+template <typename List>
+static void check_same(const List& list, const std::vector<int>& reference) {
+  CHECK(list.size() == reference.size());
+  size_t i = 0;
+  for (int value : list) {
+    CHECK(value == reference[i++]);
+  }
+}
+
+// Every node left underfilled by remove_all has a successor it could not absorb, so the nodes stay about a quarter full
+template <size_t N>
+static void test_remove_all_keeps_nodes_dense() {
+  UnrolledLinkedList<int, N> list;
+  std::vector<int> reference;
+  for (int i = 0; i < 20000; i++) {
+    list.push_back(i % 10);
+    reference.push_back(i % 10);
+  }
+
+  for (int value = 0; value < 9; value++) {
+    list.remove_all(value);
+    reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+    check_same(list, reference);
+    CHECK(list.memory_usage().allocations <= 4 * reference.size() / N + 2);
+  }
+}
+
+// Random edits against std::vector, removals included
+static void test_random_edits() {
+  UnrolledLinkedList<int, 8> list;
+  std::vector<int> reference;
+  std::mt19937 rng(7);
+
+  for (int step = 0; step < 20000; step++) {
+    int value = int(rng() % 16);
+    switch (rng() % 5) {
+      case 0: list.push_back(value); reference.push_back(value); break;
+      case 1: list.push_front(value); reference.insert(reference.begin(), value); break;
+      case 2: {
+        int index = int(rng() % (reference.size() + 1));
+        list.insert(index, value);
+        reference.insert(reference.begin() + index, value);
+        break;
+      }
+      case 3:
+        if (!reference.empty()) {
+          int index = int(rng() % reference.size());
+          list.remove_at(index);
+          reference.erase(reference.begin() + index);
+        }
+        break;
+      default:
+        if (step % 50 == 0) {
+          list.remove_all(value);
+          reference.erase(std::remove(reference.begin(), reference.end(), value), reference.end());
+        }
+    }
+  }
+  check_same(list, reference);
+}
+
+int main() {
+  test_remove_all_keeps_nodes_dense<4>();
+  test_remove_all_keeps_nodes_dense<16>();
+  test_remove_all_keeps_nodes_dense<unrolled_node_capacity<int>()>();
+  test_random_edits();
+  return 0;
+}
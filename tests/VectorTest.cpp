@@ -0,0 +1,55 @@
+// VectorTest.cpp
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "Check.hpp"
+#include "linear/Vector.hpp"
+#include "parallel/Algorithms.hpp"
+
+// An Iterator converts to a ConstIterator, so the two compare and subtract in either order
+static void test_mixed_iterator_comparisons() {
+  Vector<int> vector;
+  for (int i = 0; i < 10; i++) {
+    vector.push_back(i);
+  }
+
+  const Vector<int>& view = vector;
+  Vector<int>::Iterator it = vector.begin() + 3;
+  Vector<int>::ConstIterator cit = view.begin() + 3;
+  CHECK(it == cit && cit == it);
+  CHECK(!(it != cit) && !(cit != it));
+  CHECK(it < view.end() && view.begin() < it);
+  CHECK(it <= cit && cit >= it && !(it > cit) && !(cit < it));
+  CHECK(view.end() - it == 7 && it - view.begin() == 3);
+  CHECK(std::find(vector.begin(), vector.end(), 5) != view.end());
+}
+
+// init is folded in exactly once and the chunks are combined in order, whatever the chunking
+static void test_parallel_reduce_seeding() {
+  Vector<std::string> letters;
+  std::string expected = ">";
+  for (int i = 0; i < 1000; i++) {
+    letters.push_back(std::string(1, char('a' + i % 26)));
+    expected += letters[i];
+  }
+
+  Vector<long> numbers;
+  for (int i = 0; i < 1000; i++) {
+    numbers.push_back(i % 3 == 0 ? 2 : 1);
+  }
+
+  for (size_t grain : {size_t(0), size_t(1), size_t(7), size_t(100), size_t(5000)}) {
+    CHECK(parallel_reduce(letters.begin(), letters.end(), std::string(">"), std::plus<>(), grain) == expected);
+    CHECK(parallel_reduce(numbers.begin(), numbers.end(), 5L, std::plus<>(), grain) == 5 + 334 * 2 + 666);
+    auto capped = [](long a, long b) { return std::max(a, b); };
+    CHECK(parallel_reduce(numbers.begin(), numbers.end(), 9L, capped, grain) == 9);
+    CHECK(parallel_reduce(numbers.begin(), numbers.begin() + 1, 3L, std::multiplies<>(), grain) == 6);
+  }
+}
+
+int main() {
+  test_mixed_iterator_comparisons();
+  test_parallel_reduce_seeding();
+  return 0;
+}
@@ -0,0 +1,323 @@
+// TimingWheel.hpp
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../linear/DoublyLinkedList.hpp"
+#include "../memory/MemoryUsage.hpp"
+
+// Struct holding one timer, stored in a DoublyLinkedList node that moves between the wheel's buckets
+template <typename Value>
+struct TimerEntry {
+  uint64_t expiry;                    // Tick the timer fires at
+  uint32_t bucket;                    // Bucket whose list holds the node
+  uint32_t generation;                // Bumped whenever the node is recycled, so stale handles are recognised
+  Value value;                        // Value handed to the callback when the timer fires
+
+  // Constructor forwarding its arguments to the value
+  template <typename... Args>
+  explicit TimerEntry(Args&&... args) : expiry(0), bucket(0), generation(0), value(std::forward<Args>(args)...) {}
+};
+
+// Class representing a hierarchical timing wheel (Varghese and Lauck, 1987)
+// Time is counted in ticks of a configurable resolution; level l has 2^SlotBits buckets of 2^(SlotBits * l) ticks each,
+// so Levels levels cover 2^(SlotBits * Levels) ticks and later timers wait in the last level until they come in range
+// schedule, reschedule and cancel are O(1): a timer is a node linked into one bucket, and nodes are recycled rather than freed
+// advance cascades each bucket of a higher level into the lower levels once per lap, and fires due timers in one batch;
+// timers the callback schedules for a time already reached wait for the next call, so a callback cannot keep advance busy
+template <typename Value, size_t Levels = 4, size_t SlotBits = 8>
+class TimingWheel {
+  static_assert(Levels >= 1 && SlotBits >= 1 && Levels * SlotBits < 64, "TimingWheel levels must cover fewer than 2^64 ticks");
+public:
+  using Node = DoublyListNode<TimerEntry<Value>>;
+
+  // Struct identifying a scheduled timer; it goes stale once the timer fires or is cancelled
+  struct Handle {
+    Node* node = nullptr;             // Node of the timer
+    uint32_t generation = 0;          // Generation of the node when the timer was scheduled
+  };
+
+private:
+  static constexpr size_t slots = size_t(1) << SlotBits;                  // Buckets per level
+  static constexpr uint32_t due_bucket = uint32_t(Levels * slots);        // Bucket id of timers due
+  static constexpr uint32_t firing_bucket = due_bucket + 1;               // Bucket id of the batch advance is firing
+  static constexpr uint32_t spare_bucket = due_bucket + 2;                // Bucket id of recycled nodes
+
+  std::vector<DoublyLinkedList<TimerEntry<Value>>> buckets;   // Buckets of every level, level after level
+  DoublyLinkedList<TimerEntry<Value>> due;                    // Timers due, fired by the next advance
+  DoublyLinkedList<TimerEntry<Value>> firing;                 // Batch of due timers advance is firing
+  DoublyLinkedList<TimerEntry<Value>> spare;                  // Recycled nodes
+  size_t level_size[Levels];          // Timers waiting in each level, so advance can skip empty stretches
+  uint64_t resolution;                // Time units per tick
+  uint64_t tick;                      // Current tick
+  int wheel_size;                     // Number of timers scheduled
+
+  // Private helper functions
+  DoublyLinkedList<TimerEntry<Value>>& list_of(uint32_t);    // Returns the list a bucket id refers to
+  void place(Node*);                                          // Links a timer into the bucket its expiry falls in
+  Node* detach(Node*);                                        // Unlinks a timer from its bucket
+  void recycle(Node*);                                        // Stales a node's handles and keeps it for reuse
+  void cascade(size_t);                                       // Moves the timers of the current bucket of a level into lower levels
+public:
+  // Constructors
+  explicit TimingWheel(uint64_t resolution = 1, uint64_t start = 0);   // Wheel of the given tick resolution, its clock starting at start
+  TimingWheel(const TimingWheel&) = delete;                            // Handles refer to nodes of one wheel, so wheels are not copied
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  // Accessors
+  const uint64_t now() const;                                 // Returns the time of the current tick
+  const bool pending(Handle) const;                           // Returns if a timer has neither fired nor been cancelled
+  const bool empty() const;                                   // Returns if no timer is scheduled
+  const int size() const;                                     // Returns the number of timers scheduled
+  const MemoryUsage memory_usage() const;                     // Returns the bytes held by the wheel, broken down
+
+  // Mutators
+  template <typename... Args>
+  Handle schedule(uint64_t, Args&&...);                       // Schedules a timer firing once the clock reaches a deadline
+  bool reschedule(Handle, uint64_t);                          // Moves a pending timer to another deadline, returning false if it is stale
+  bool cancel(Handle);                                        // Cancels a pending timer, returning false if it is stale
+  template <typename Fn>
+  size_t advance(uint64_t, Fn);                               // Moves the clock to a time, calling fn(value) for each timer due, and returns how many fired
+  void clear();                                               // Cancels every timer
+};
+
+// Function definitions
+template <typename Value, size_t Levels, size_t SlotBits>
+TimingWheel<Value, Levels, SlotBits>::TimingWheel(uint64_t resolution, uint64_t start)
+    : buckets(Levels * slots), level_size(), resolution(resolution), tick(0), wheel_size(0) {
+  if (resolution == 0) throw std::invalid_argument("Tick resolution must be positive");
+  tick = start / resolution;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+DoublyLinkedList<TimerEntry<Value>>& TimingWheel<Value, Levels, SlotBits>::list_of(uint32_t bucket) {
+  if (bucket == due_bucket) return due;
+  if (bucket == firing_bucket) return firing;
+  if (bucket == spare_bucket) return spare;
+  return buckets[bucket];
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+void TimingWheel<Value, Levels, SlotBits>::place(Node* node) {
+  TimerEntry<Value>& entry = node->value;
+  if (entry.expiry <= tick) {
+    entry.bucket = due_bucket;
+    due.link_back(node);
+    return;
+  }
+
+  // The lowest level whose span covers the delay; a level's buckets are indexed by the expiry's bits at that level,
+  // so the bucket comes round exactly when the clock enters the expiry's span at that level
+  uint64_t delay = entry.expiry - tick;
+  size_t level = 0;
+  while (level + 1 < Levels && delay >= uint64_t(1) << (SlotBits * (level + 1))) {
+    level++;
+  }
+
+  // Timers beyond the last level's span wait in the furthest bucket and are placed again when it comes round
+  uint64_t target = entry.expiry;
+  if (level + 1 == Levels && delay >= uint64_t(1) << (SlotBits * Levels)) {
+    target = tick + (uint64_t(1) << (SlotBits * Levels)) - 1;
+  }
+
+  entry.bucket = uint32_t(level * slots + ((target >> (SlotBits * level)) & (slots - 1)));
+  buckets[entry.bucket].link_back(node);
+  level_size[level]++;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+typename TimingWheel<Value, Levels, SlotBits>::Node* TimingWheel<Value, Levels, SlotBits>::detach(Node* node) {
+  uint32_t bucket = node->value.bucket;
+  if (bucket < due_bucket) level_size[bucket / slots]--;
+  return list_of(bucket).unlink(node);
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+void TimingWheel<Value, Levels, SlotBits>::recycle(Node* node) {
+  // Drop what the value holds now rather than whenever the node is reused
+  if constexpr (std::is_default_constructible<Value>::value && std::is_move_assignable<Value>::value) {
+    node->value.value = Value();
+  }
+
+  node->value.generation++;
+  node->value.bucket = spare_bucket;
+  spare.link_back(node);
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+void TimingWheel<Value, Levels, SlotBits>::cascade(size_t level) {
+  size_t bucket = level * slots + ((tick >> (SlotBits * level)) & (slots - 1));
+
+  DoublyLinkedList<TimerEntry<Value>> moving;
+  moving.splice_back(buckets[bucket]);
+  level_size[level] -= moving.size();
+
+  while (!moving.empty()) {
+    place(moving.unlink(moving.begin_head().get_node()));
+  }
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+const uint64_t TimingWheel<Value, Levels, SlotBits>::now() const {
+  return tick * resolution;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+const bool TimingWheel<Value, Levels, SlotBits>::pending(Handle handle) const {
+  return handle.node != nullptr && handle.node->value.generation == handle.generation;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+const bool TimingWheel<Value, Levels, SlotBits>::empty() const {
+  return wheel_size == 0;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+const int TimingWheel<Value, Levels, SlotBits>::size() const {
+  return wheel_size;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+const MemoryUsage TimingWheel<Value, Levels, SlotBits>::memory_usage() const {
+  size_t nodes = size_t(wheel_size) + spare.size();
+
+  MemoryUsage usage;
+  usage.payload = wheel_size * sizeof(Value);
+  usage.overhead = sizeof(*this) + buckets.capacity() * sizeof(DoublyLinkedList<TimerEntry<Value>>) + wheel_size * (sizeof(Node) - sizeof(Value));
+  usage.slack = spare.size() * sizeof(Node);
+  usage.allocations = nodes + 1;
+  return usage;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+template <typename... Args>
+typename TimingWheel<Value, Levels, SlotBits>::Handle TimingWheel<Value, Levels, SlotBits>::schedule(uint64_t deadline, Args&&... args) {
+  Node* node;
+  if (spare.empty()) {
+    node = new Node(std::forward<Args>(args)...);
+  } else {
+    node = spare.begin_head().get_node();
+    node->value.value = Value(std::forward<Args>(args)...);
+    spare.unlink(node);
+  }
+
+  // A deadline between two ticks fires at the later one, never early
+  node->value.expiry = deadline / resolution + (deadline % resolution != 0);
+  place(node);
+  wheel_size++;
+  return Handle{node, node->value.generation};
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+bool TimingWheel<Value, Levels, SlotBits>::reschedule(Handle handle, uint64_t deadline) {
+  if (!pending(handle)) return false;
+
+  Node* node = detach(handle.node);
+  node->value.expiry = deadline / resolution + (deadline % resolution != 0);
+  place(node);
+  return true;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+bool TimingWheel<Value, Levels, SlotBits>::cancel(Handle handle) {
+  if (!pending(handle)) return false;
+
+  recycle(detach(handle.node));
+  wheel_size--;
+  return true;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+template <typename Fn>
+size_t TimingWheel<Value, Levels, SlotBits>::advance(uint64_t time, Fn fn) {
+  const uint64_t target = time / resolution;
+
+  while (tick < target) {
+    // Nothing happens before the next lap of the lowest level holding timers, so jump straight to it
+    size_t lowest = 0;
+    while (lowest < Levels && level_size[lowest] == 0) {
+      lowest++;
+    }
+    if (lowest == Levels) {
+      tick = target;
+      break;
+    }
+    if (lowest > 0) {
+      uint64_t lap = ((tick >> (SlotBits * lowest)) + 1) << (SlotBits * lowest);
+      if (lap > target) {
+        tick = target;
+        break;
+      }
+      tick = lap - 1;
+    }
+
+    tick++;
+    for (size_t level = Levels - 1; level > 0; level--) {
+      if ((tick & ((uint64_t(1) << (SlotBits * level)) - 1)) == 0) cascade(level);
+    }
+
+    // A single level also holds the timers beyond its span, which must be placed again rather than fired
+    if (Levels == 1) {
+      cascade(0);
+      continue;
+    }
+
+    DoublyLinkedList<TimerEntry<Value>>& bucket = buckets[tick & (slots - 1)];
+    level_size[0] -= bucket.size();
+    for (auto it = bucket.begin_head(); it != bucket.end(); ++it) {
+      (*it).bucket = due_bucket;
+    }
+    due.splice_back(bucket);
+  }
+
+  for (auto it = due.begin_head(); it != due.end(); ++it) {
+    (*it).bucket = firing_bucket;
+  }
+  firing.splice_back(due);
+
+  // Each timer's handle goes stale before its callback runs, while timers still waiting in the batch can be cancelled
+  size_t fired = 0;
+  while (!firing.empty()) {
+    Node* node = firing.unlink(firing.begin_head().get_node());
+    node->value.generation++;
+    wheel_size--;
+    fired++;
+
+    try {
+      fn(node->value.value);
+    } catch (...) {
+      recycle(node);
+      throw;
+    }
+    recycle(node);
+  }
+  return fired;
+}
+
+template <typename Value, size_t Levels, size_t SlotBits>
+void TimingWheel<Value, Levels, SlotBits>::clear() {
+  for (DoublyLinkedList<TimerEntry<Value>>& bucket : buckets) {
+    while (!bucket.empty()) {
+      recycle(bucket.unlink(bucket.begin_head().get_node()));
+    }
+  }
+  while (!due.empty()) {
+    recycle(due.unlink(due.begin_head().get_node()));
+  }
+  while (!firing.empty()) {
+    recycle(firing.unlink(firing.begin_head().get_node()));
+  }
+
+  for (size_t level = 0; level < Levels; level++) {
+    level_size[level] = 0;
+  }
+  wheel_size = 0;
+}
+
+#endif
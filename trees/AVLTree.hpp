@@ -2,85 +2,178 @@
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
+#include <cstddef>
 #include <iostream>
 #include <stdexcept>
-
+#include <utility>
 #include <vector>
 
-// Struct defining a node in the AVL tree
+#include "../memory/MemoryUsage.hpp"
+#include "TreeCompare.hpp"
+#include "TreeStats.hpp"
+
+// Struct defining a node in the AVL tree, deriving from the cached prefix of its key
 template <typename Key, typename Value>
-struct AVLTreeNode {
+struct AVLTreeNode : KeyPrefix<Key> {
   Key key;                            // Key stored in the node
   Value value;                        // Value stored in the node
   int height;                         // Height of the node in the tree
+  int subtree_size;                   // Number of nodes in the subtree rooted here
 
   AVLTreeNode<Key, Value>* left;      // Pointer to the left child node
   AVLTreeNode<Key, Value>* right;     // Pointer to the right child node
 
-  // Constructor to initialize the node with a key and value
-  AVLTreeNode(const Key& key, const Value& value) : key(key), value(value), height(0), left(nullptr), right(nullptr) {}
+  // Constructor to initialize the node with a key and the arguments forwarded to the value
+  template <typename K, typename... Args>
+  AVLTreeNode(K&& key, Args&&... args) : KeyPrefix<Key>(key), key(std::forward<K>(key)), value(std::forward<Args>(args)...), height(1), subtree_size(1), left(nullptr), right(nullptr) {}
+
+  // Cached prefix of the key, to be kept in step whenever the key changes
+  KeyPrefix<Key>& prefix() { return *this; }
+  const KeyPrefix<Key>& prefix() const { return *this; }
+};
+
+// Fork policy for the AVLTree set operations: runs both halves on the calling thread
+// A policy is called as fork(work, first, second), work being the number of nodes the two halves touch
+struct SequentialFork {
+  template <typename First, typename Second>
+  void operator()(size_t, First&& first, Second&& second) const {
+    first();
+    second();
+  }
 };
 
 // Class representing an AVL tree
-template <typename Key, typename Value>
+// Stats is a TreeStats.hpp policy, NoTreeStats (the default) compiles every counter away
+// Compare is a TreeCompare.hpp three-way comparator; the set operations expect both trees to order keys alike
+template <typename Key, typename Value, typename Stats = NoTreeStats, typename Compare = ThreeWayCompare<Key>>
 class AVLTree {
 private:
   AVLTreeNode<Key, Value>* root;      // Pointer to the root of the tree
   int tree_size;                      // Stores number of key-value pairs in the tree
+  Compare compare;                    // Orders the keys
+
+  // Private constructor adopting a detached subtree
+  AVLTree(AVLTreeNode<Key, Value>* root, const Compare& compare) : root(root), tree_size(get_size(root)), compare(compare) {}
 
   // Private Helper Functions
   AVLTreeNode<Key, Value>* search(AVLTreeNode<Key, Value>*, const Key&);                                // Finds a node with the given key
   const AVLTreeNode<Key, Value>* search(AVLTreeNode<Key, Value>*, const Key&) const;                          // Finds a node with the given key (const)
+  const int order(const Key&, const KeyPrefix<Key>&, const AVLTreeNode<Key, Value>*) const;             // Compares a key and its prefix with the key of a node
   
   const int get_height(AVLTreeNode<Key, Value>*) const;                                                 // Returns the height of the node
-  void update_height(AVLTreeNode<Key, Value>*);                                                         // Updates the height of the node
+  const int get_size(AVLTreeNode<Key, Value>*) const;                                                   // Returns the number of nodes in the subtree
+  void update_height(AVLTreeNode<Key, Value>*);                                                         // Updates the height and subtree size of the node
   const int get_balance(AVLTreeNode<Key, Value>*) const;                                                // Returns the balance factor of the given node
   AVLTreeNode<Key, Value>* get_local_min(AVLTreeNode<Key, Value>*);                                     // Returns the local minimum of a certain branch
 
   AVLTreeNode<Key, Value>* rotate_left(AVLTreeNode<Key, Value>*);                                       // Performs a left rotation around the given node
   AVLTreeNode<Key, Value>* rotate_right(AVLTreeNode<Key, Value>*);                                      // Performs a right rotation around the given node
+  AVLTreeNode<Key, Value>* rebalance(AVLTreeNode<Key, Value>*);                                         // Restores the AVL property at the given node
   
-  AVLTreeNode<Key, Value>* insert(AVLTreeNode<Key, Value>*, const Key&, const Value&);                  // Inserts a new key-value pair into the tree
-  AVLTreeNode<Key, Value>* remove(AVLTreeNode<Key, Value>*, const Key&);                                // Removes a key-value pair from the tree
+  template <typename K, typename... Args>
+  AVLTreeNode<Key, Value>* emplace(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*&, bool&, int, const KeyPrefix<Key>&, K&&, Args&&...);  // Inserts a new key-value pair unless the key already exists, pointing the node reference at the key's node (int: depth of the node)
+  AVLTreeNode<Key, Value>* remove(AVLTreeNode<Key, Value>*, const Key&, const KeyPrefix<Key>&);         // Removes a key-value pair from the tree
+
+  // Join-based set operations on detached subtrees
+  AVLTreeNode<Key, Value>* join(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*);  // Joins two subtrees around a middle node
+  AVLTreeNode<Key, Value>* join(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*);                    // Joins two subtrees without a middle node
+  AVLTreeNode<Key, Value>* detach_min(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*&);             // Unlinks the minimum node of a subtree
+  void split(AVLTreeNode<Key, Value>*, const Key&, const KeyPrefix<Key>&, AVLTreeNode<Key, Value>*&, AVLTreeNode<Key, Value>*&, AVLTreeNode<Key, Value>*&);  // Splits a subtree into smaller keys, the matching node and greater keys
+  template <typename Fork>
+  AVLTreeNode<Key, Value>* union_with(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*, Fork&);       // Merges two subtrees, keeping the first one's node on duplicates
+  template <typename Fork>
+  AVLTreeNode<Key, Value>* intersect_with(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*, Fork&);   // Keeps the first subtree's nodes whose keys are in the second
+  template <typename Fork>
+  AVLTreeNode<Key, Value>* difference(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*, Fork&);       // Keeps the first subtree's nodes whose keys are not in the second
   
   // Utility
   void clear(AVLTreeNode<Key, Value>*);                                                                 // Recursively deletes all nodes in the tree
+  AVLTreeNode<Key, Value>* clone(const AVLTreeNode<Key, Value>*) const;                                 // Recursively copies all nodes in a subtree
+  template <typename It>
+  AVLTreeNode<Key, Value>* build(It, size_t, size_t);                                                   // Builds a perfectly balanced subtree from sorted pairs [begin, end)
 
   void print_node(AVLTreeNode<Key, Value>*);                                                            // Prints the given node
   void in_order(AVLTreeNode<Key, Value>*);                                                              // Performs in-order traversal starting from the given node
   void pre_order(AVLTreeNode<Key, Value>*);                                                             // Performs pre-order traversal starting from the given node
   void post_order(AVLTreeNode<Key, Value>*);                                                            // Performs post-order traversal starting from the given node
   void to_vector(std::vector<std::pair<Key, Value>>&, AVLTreeNode<Key, Value>*);
+  template <typename Fn>
+  void for_each(AVLTreeNode<Key, Value>*, Fn&);                                                         // Visits every node of a subtree in order
+  template <typename T, typename Op>
+  T reduce(const AVLTreeNode<Key, Value>*, T, Op&) const;                                               // Folds every node of a subtree in order
 public:
   // Constructor and Destructor
-  AVLTree() : root(nullptr), tree_size(0) {}                                                            // Default constructor
+  AVLTree() : root(nullptr), tree_size(0), compare() {}                                                 // Default constructor
+  explicit AVLTree(const Compare& compare) : root(nullptr), tree_size(0), compare(compare) {}           // Constructor with a comparator
   AVLTree(std::vector<std::pair<Key, Value>>);                                                          // Constructor from vector<pair>
+  AVLTree(const AVLTree<Key, Value, Stats, Compare>&);                                                                  // Copy constructor
+  AVLTree(AVLTree<Key, Value, Stats, Compare>&&) noexcept;                                                              // Move constructor
   ~AVLTree();                                                                                           // Destructor
+
+  // Assignment
+  AVLTree<Key, Value, Stats, Compare>& operator=(const AVLTree<Key, Value, Stats, Compare>&);                                           // Copy assignment operator
+  AVLTree<Key, Value, Stats, Compare>& operator=(AVLTree<Key, Value, Stats, Compare>&&) noexcept;                                       // Move assignment operator
+
   // Accessors
   Value& search(const Key&);                                                                            // Returns the value associated with the given key from the list
   const Value& search(const Key&) const;                                                                // Returns the value associated with the given key from the list (const)
+  Value* find(const Key&);                                                                              // Returns the value associated with the given key, or nullptr if it is absent
+  const Value* find(const Key&) const;                                                                  // Returns the value associated with the given key, or nullptr if it is absent (const)
   const bool contains(const Key&) const;                                                                // Returns if the given key exists in the list
   const bool empty() const;                                                                             // Returns if the list is empty
   const int size() const;                                                                               // Returns the size of the list
   const int height() const;
+  const MemoryUsage memory_usage() const;                                                               // Returns the bytes held by the tree, broken down
+  const TreeStatsSnapshot stats() const { return Stats::snapshot(); }                                  // Returns the counters of the stats policy, summed over every thread
+  void reset_stats() { Stats::reset(); }                                                                // Zeroes the counters of the stats policy
 
   // Mutators
   void insert(const Key&, const Value&);                                                                // Inserts a new key-value pair into the tree
+  void insert(Key&&, Value&&);                                                                          // Moves a new key-value pair into the tree
+  template <typename... Args>
+  bool try_emplace(const Key&, Args&&...);                                                              // Constructs the value in place if the key is absent
+  template <typename... Args>
+  bool try_emplace(Key&&, Args&&...);                                                                   // Constructs the value in place if the key is absent (moved key)
+  template <typename... Args>
+  Value& get_or_insert(const Key&, Args&&...);                                                          // Returns the value of a key, first constructing it from args if the key is absent (one descent)
+  template <typename V>
+  bool insert_or_assign(const Key&, V&&);                                                               // Inserts a key-value pair or overwrites the value of an existing key, returning if it was inserted (one descent)
   void remove(const Key&);                                                                              // Removes a key-value pair from the tree
   void replace(const Key&, const Value&);                                                               // Replaces a certain key with a different value
   void clear();                                                                                         // Clears the tree
+  template <typename It>
+  void assign_sorted(It, It);                                                                           // Replaces the contents with pairs (first, second) of strictly increasing keys in O(n)
+
+  // Set operations, each taking ownership of the other tree's nodes (pass std::move(tree) to avoid a copy)
+  // Merging m pairs into n costs O(m log(n/m + 1)) instead of m separate inserts
+  void split(const Key&, AVLTree<Key, Value, Stats, Compare>&, AVLTree<Key, Value, Stats, Compare>&);                                   // Moves smaller keys to the first tree and greater keys to the second, leaving only the matching pair
+  void join(AVLTree<Key, Value, Stats, Compare>);                                                                       // Appends a tree whose keys are all greater than this tree's
+  template <typename Fork = SequentialFork>
+  void union_with(AVLTree<Key, Value, Stats, Compare>, Fork = Fork());                                                  // Adds the other tree's pairs, keeping this tree's value for duplicate keys
+  template <typename Fork = SequentialFork>
+  void intersect_with(AVLTree<Key, Value, Stats, Compare>, Fork = Fork());                                              // Keeps only the pairs whose keys are also in the other tree
+  template <typename Fork = SequentialFork>
+  void difference(AVLTree<Key, Value, Stats, Compare>, Fork = Fork());                                                  // Removes the pairs whose keys are in the other tree
 
   // Utility
   void in_order();                                                                                      // Prints the list (in-order)
   void pre_order();                                                                                     // Prints the list (pre-order)
   void post_order();                                                                                    // Prints the list (post-order)
   std::vector<std::pair<Key, Value>> to_vector();                                                       // Returns the AVLTree as a vector
+  template <typename Fn>
+  void for_each(Fn);                                                                                    // Calls fn(key, value) on every pair (in-order)
+  template <typename T, typename Op>
+  T reduce(T, Op) const;                                                                                // Folds op(accumulator, key, value) over every pair (in-order)
+  template <typename Pred>
+  const size_t count_if(Pred) const;                                                                    // Counts the pairs for which pred(key, value) holds
+  const AVLTreeNode<Key, Value>* get_root() const { return root; }                                      // Returns the root node, read-only, for subtree algorithms
   
   // Iterator 
   class Iterator {
   private: 
     AVLTreeNode<Key, Value>* current; // Pointer to the current node in the iteration
     AVLTreeNode<Key, Value>* root;    // Pointer to the root node of the AVL Tree
+    Compare compare;                  // Comparator of the tree
 
     // Private helper function to get next node in-order
     AVLTreeNode<Key, Value>* next_in_order(AVLTreeNode<Key, Value>*, AVLTreeNode<Key, Value>*) {
@@ -100,11 +193,12 @@ public:
       AVLTreeNode<Key, Value>* ancestor = root;
 
       while (ancestor != nullptr) {
-        if (current->key < ancestor->key) {
+        int order = compare_keys(compare, current->key, current->prefix(), ancestor->key, ancestor->prefix());
+        if (order < 0) {
           successor = ancestor;
           ancestor = ancestor->left;
 
-        } else if (current->key > ancestor->key) {
+        } else if (order > 0) {
           ancestor = ancestor->right;
 
         } else break;
@@ -116,7 +210,7 @@ public:
   public:
     // Constructors
     Iterator() : current(nullptr), root(nullptr) { }
-    Iterator(AVLTreeNode<Key, Value>* root) : root(root) { 
+    Iterator(AVLTreeNode<Key, Value>* root, const Compare& compare = Compare()) : root(root), compare(compare) { 
       AVLTreeNode<Key, Value>* node = root;
       while (node != nullptr && node->left != nullptr) { 
         node = node->left;
@@ -140,6 +234,7 @@ public:
 
     // Increment operator
     Iterator& operator++() { 
+      Stats::iterator_step();
       if (root != nullptr) {
         current = next_in_order(current, root);
       }
@@ -152,60 +247,132 @@ public:
 
 
   // Iterator methods
-  Iterator begin() { return Iterator(root); }               // Returns an iterator pointing to the root node
+  Iterator begin() { return Iterator(root, compare); }      // Returns an iterator pointing to the root node
   Iterator end() { return Iterator(nullptr); }              // Returns an iterator pointing to the end (nullptr)
-  const Iterator begin() const { return Iterator(root); }   // Returns a const iterator pointing to the root node
+  const Iterator begin() const { return Iterator(root, compare); }  // Returns a const iterator pointing to the root node
   const Iterator end() const { return Iterator(nullptr); }  // Returns a const iterator pointing to the end (nullptr)
   
 }; 
 
 // Function Definitions
-template <typename Key, typename Value>
-AVLTree<Key, Value>::AVLTree(std::vector<std::pair<Key, Value>> vector) : root(nullptr) {
-  for (const auto& element : vector) {
-    insert(element.first, element.second);
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>::AVLTree(std::vector<std::pair<Key, Value>> vector) : root(nullptr), tree_size(0), compare() {
+  for (auto& element : vector) {
+    insert(std::move(element.first), std::move(element.second));
   }
 }
 
-template <typename Key, typename Value>
-AVLTree<Key, Value>::~AVLTree() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>::AVLTree(const AVLTree<Key, Value, Stats, Compare>& other) : root(clone(other.root)), tree_size(other.tree_size), compare(other.compare) {}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>::AVLTree(AVLTree<Key, Value, Stats, Compare>&& other) noexcept : root(other.root), tree_size(other.tree_size), compare(other.compare) {
+  other.root = nullptr;
+  other.tree_size = 0;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>::~AVLTree() {
   clear();
 }
 
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>& AVLTree<Key, Value, Stats, Compare>::operator=(const AVLTree<Key, Value, Stats, Compare>& other) {
+  if (this != &other) {
+    AVLTree<Key, Value, Stats, Compare> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
 
-template <typename Key, typename Value>
-const AVLTreeNode<Key, Value>* AVLTree<Key, Value>::search(AVLTreeNode<Key, Value>* node, const Key& key) const {
-  if (node == nullptr) return nullptr;
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTree<Key, Value, Stats, Compare>& AVLTree<Key, Value, Stats, Compare>::operator=(AVLTree<Key, Value, Stats, Compare>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(root, other.root);
+    std::swap(tree_size, other.tree_size);
+    compare = other.compare;
+  }
+  return *this;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::search(AVLTreeNode<Key, Value>* node, const Key& key) {
+  KeyPrefix<Key> prefix(key);
+  int depth = 0;
+  while (node != nullptr) {
+    Stats::comparison();
+    depth++;
+
+    int order = this->order(key, prefix, node);
+    if (order < 0) {
+      node = node->left;
+    } else if (order > 0) {
+      node = node->right;
+    } else break;
+  }
+
+  Stats::depth(depth);
+  return node;
+}
 
-  if (key < node->key) return search(node->left, key);
-  if (key > node->key) return search(node->right, key);
+template <typename Key, typename Value, typename Stats, typename Compare>
+const AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::search(AVLTreeNode<Key, Value>* node, const Key& key) const {
+  KeyPrefix<Key> prefix(key);
+  int depth = 0;
+  while (node != nullptr) {
+    Stats::comparison();
+    depth++;
 
+    int order = this->order(key, prefix, node);
+    if (order < 0) {
+      node = node->left;
+    } else if (order > 0) {
+      node = node->right;
+    } else break;
+  }
+
+  Stats::depth(depth);
   return node;
 }
 
-template <typename Key, typename Value>
-const int AVLTree<Key, Value>::get_height(AVLTreeNode<Key, Value>* node) const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::order(const Key& key, const KeyPrefix<Key>& prefix, const AVLTreeNode<Key, Value>* node) const {
+  return compare_keys(compare, key, prefix, node->key, node->prefix());
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::get_height(AVLTreeNode<Key, Value>* node) const {
   if (node == nullptr) return 0;
 
   return node->height;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::update_height(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::get_size(AVLTreeNode<Key, Value>* node) const {
+  if (node == nullptr) return 0;
+
+  return node->subtree_size;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::update_height(AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
 
   node->height = std::max(get_height(node->left), get_height(node->right)) + 1;
+  node->subtree_size = get_size(node->left) + get_size(node->right) + 1;
 }
 
-template <typename Key, typename Value>
-const int AVLTree<Key, Value>::get_balance(AVLTreeNode<Key, Value>* node) const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::get_balance(AVLTreeNode<Key, Value>* node) const {
   if (node == nullptr) return 0;
 
   return get_height(node->left) - get_height(node->right);
 }
 
-template <typename Key, typename Value>
-AVLTreeNode<Key, Value>* AVLTree<Key, Value>::rotate_left(AVLTreeNode<Key, Value>* x) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::rotate_left(AVLTreeNode<Key, Value>* x) {
+  Stats::rotation();
   AVLTreeNode<Key, Value>* y = x->right;
   AVLTreeNode<Key, Value>* T2 = y->left;
 
@@ -218,59 +385,45 @@ AVLTreeNode<Key, Value>* AVLTree<Key, Value>::rotate_left(AVLTreeNode<Key, Value
   return y;
 }
 
-template <typename Key, typename Value>
-AVLTreeNode<Key, Value>* AVLTree<Key, Value>::rotate_right(AVLTreeNode<Key, Value>* y) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::rotate_right(AVLTreeNode<Key, Value>* y) {
+  Stats::rotation();
   AVLTreeNode<Key, Value>* x = y->left;
   AVLTreeNode<Key, Value>* T2 = x->right;
 
   x->right = y;
   y->left = T2;
 
-  update_height(x);
   update_height(y);
+  update_height(x);
 
   return x;
 }
 
-template <typename Key, typename Value>
-AVLTreeNode<Key, Value>* AVLTree<Key, Value>::insert(AVLTreeNode<Key, Value>* node, const Key& key, const Value& value) {
-  if (node == nullptr) { 
-    tree_size++;
-    return new AVLTreeNode<Key, Value>(key, value); 
-    }
-
-  if (key < node->key) {
-    node->left = insert(node->left, key, value);
-  }
-  else if (key > node->key) {
-    node->right = insert(node->right, key, value);
-  }
-  else {
-    return node;
-  }
-
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::rebalance(AVLTreeNode<Key, Value>* node) {
   update_height(node);
 
   int balance = get_balance(node);
 
   // right
-  if (balance > 1 && key < node->left->key) {
+  if (balance > 1 && get_balance(node->left) >= 0) {
     return rotate_right(node);
   }
-
+  
   // left
-  if (balance < -1 && key > node->right->key) { 
+  if (balance < -1 && get_balance(node->right) <= 0) {
     return rotate_left(node);
   }
 
   // left-right
-  if (balance > 1 && key > node->left->key) {
+  if (balance > 1 && get_balance(node->left) < 0) {
     node->left = rotate_left(node->left);
     return rotate_right(node);
   }
 
   // right-left
-  if (balance < -1 && key < node->right->key) {
+  if (balance < -1 && get_balance(node->right) > 0) {
     node->right = rotate_right(node->right);
     return rotate_left(node);
   }
@@ -278,73 +431,240 @@ AVLTreeNode<Key, Value>* AVLTree<Key, Value>::insert(AVLTreeNode<Key, Value>* no
   return node;
 }
 
-template <typename Key, typename Value>
-AVLTreeNode<Key, Value>* AVLTree<Key, Value>::remove(AVLTreeNode<Key, Value>* node, const Key& key) {
-  if (node == nullptr) return nullptr;
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename K, typename... Args>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::emplace(AVLTreeNode<Key, Value>* node, AVLTreeNode<Key, Value>*& found, bool& inserted, int depth, const KeyPrefix<Key>& prefix, K&& key, Args&&... args) {
+  if (node == nullptr) { 
+    Stats::depth(depth);
+    Stats::allocation();
+    found = new AVLTreeNode<Key, Value>(std::forward<K>(key), std::forward<Args>(args)...);
+    tree_size++;
+    inserted = true;
+    return found;
+    }
 
-  if (key < node->key) {
-    node->left = remove(node->left, key);
-  } else if (key > node->key) {
-    node->right = remove(node->right, key);
+  Stats::comparison();
+  int order = this->order(key, prefix, node);
+  if (order < 0) {
+    node->left = emplace(node->left, found, inserted, depth + 1, prefix, std::forward<K>(key), std::forward<Args>(args)...);
+  }
+  else if (order > 0) {
+    node->right = emplace(node->right, found, inserted, depth + 1, prefix, std::forward<K>(key), std::forward<Args>(args)...);
   }
   else {
-    tree_size--;
+    found = node;
+    return node;
+  }
+
+  // The key may have been moved into the new node, so rebalance on child balance factors
+  return rebalance(node);
+}
 
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::remove(AVLTreeNode<Key, Value>* node, const Key& key, const KeyPrefix<Key>& prefix) {
+  if (node == nullptr) return nullptr;
+
+  Stats::comparison();
+  int order = this->order(key, prefix, node);
+  if (order < 0) {
+    node->left = remove(node->left, key, prefix);
+  } else if (order > 0) {
+    node->right = remove(node->right, key, prefix);
+  }
+  else {
     if (node->left == nullptr && node->right == nullptr) {
+      Stats::free();
       delete node;
       node = nullptr;
+      tree_size--;
 
     } else if (node->left == nullptr) {
       AVLTreeNode<Key, Value>* temp = node;
       node = node->right;
+      Stats::free();
       delete temp;
+      tree_size--;
     
     } else if (node->right == nullptr) {
       AVLTreeNode<Key, Value>* temp = node;
       node = node->left;
+      Stats::free();
       delete temp;
+      tree_size--;
 
     }else {
-      AVLTreeNode<Key, Value>* temp = get_local_min(node->right);
-      node->key = temp->key;
-      node->value = temp->value;
-      node->right = remove(node->right, temp->key);
+      // Splice the in-order successor into the node's place, so keys are never assigned and may be move-only
+      AVLTreeNode<Key, Value>* successor = nullptr;
+      AVLTreeNode<Key, Value>* right = detach_min(node->right, successor);
+      successor->left = node->left;
+      successor->right = right;
+      Stats::free();
+      delete node;
+      tree_size--;
+      node = successor;
     }
   }
 
   if (node == nullptr) return node;
 
-  update_height(node);
+  return rebalance(node);
+}
 
-  int balance = get_balance(node);
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::join(AVLTreeNode<Key, Value>* left, AVLTreeNode<Key, Value>* middle, AVLTreeNode<Key, Value>* right) {
+  // Walk down the spine of the taller side until the heights are within one, then rebalance on the way back up
+  if (get_height(left) > get_height(right) + 1) {
+    left->right = join(left->right, middle, right);
+    return rebalance(left);
+  }
 
-  // right
-  if (balance > 1 && get_balance(node->left) >= 0) {
-    return rotate_right(node);
+  if (get_height(right) > get_height(left) + 1) {
+    right->left = join(left, middle, right->left);
+    return rebalance(right);
   }
-  
-  // left
-  if (balance < -1 && get_balance(node->right) >= 0) {
-    return rotate_left(node);
+
+  middle->left = left;
+  middle->right = right;
+  update_height(middle);
+  return middle;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::join(AVLTreeNode<Key, Value>* left, AVLTreeNode<Key, Value>* right) {
+  if (left == nullptr) return right;
+  if (right == nullptr) return left;
+
+  AVLTreeNode<Key, Value>* middle = nullptr;
+  right = detach_min(right, middle);
+  return join(left, middle, right);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::detach_min(AVLTreeNode<Key, Value>* node, AVLTreeNode<Key, Value>*& min) {
+  if (node->left == nullptr) {
+    AVLTreeNode<Key, Value>* right = node->right;
+    min = node;
+    min->right = nullptr;
+    update_height(min);
+    return right;
   }
 
-  // left-right
-  if (balance > 1 && get_balance(node->left) < 0) {
-    node->left = rotate_left(node->left);
-    return rotate_right(node);
+  node->left = detach_min(node->left, min);
+  return rebalance(node);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::split(AVLTreeNode<Key, Value>* node, const Key& key, const KeyPrefix<Key>& prefix, AVLTreeNode<Key, Value>*& less, AVLTreeNode<Key, Value>*& match, AVLTreeNode<Key, Value>*& greater) {
+  if (node == nullptr) {
+    less = nullptr;
+    match = nullptr;
+    greater = nullptr;
+    return;
   }
 
-  // right-left
-  if (balance < -1 && get_balance(node->right) > 0) {
-    node->right = rotate_right(node->right);
-    return rotate_left(node);
+  AVLTreeNode<Key, Value>* left = node->left;
+  AVLTreeNode<Key, Value>* right = node->right;
+
+  Stats::comparison();
+  int order = this->order(key, prefix, node);
+  if (order < 0) {
+    split(left, key, prefix, less, match, greater);
+    greater = join(greater, node, right);
+  } else if (order > 0) {
+    split(right, key, prefix, less, match, greater);
+    less = join(left, node, less);
+  } else {
+    less = left;
+    greater = right;
+    match = node;
+    match->left = nullptr;
+    match->right = nullptr;
+    update_height(match);
   }
+}
 
-  return node;
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::union_with(AVLTreeNode<Key, Value>* node, AVLTreeNode<Key, Value>* other, Fork& fork) {
+  if (node == nullptr) return other;
+  if (other == nullptr) return node;
+
+  size_t work = get_size(node) + get_size(other);
+  AVLTreeNode<Key, Value>* less;
+  AVLTreeNode<Key, Value>* match;
+  AVLTreeNode<Key, Value>* greater;
+  split(other, node->key, node->prefix(), less, match, greater);
+  if (match != nullptr) Stats::free();
+  delete match;
+
+  AVLTreeNode<Key, Value>* left = node->left;
+  AVLTreeNode<Key, Value>* right = node->right;
+  fork(work, [&] { left = union_with(left, less, fork); }, [&] { right = union_with(right, greater, fork); });
+
+  return join(left, node, right);
 }
 
-template <typename Key, typename Value>
-AVLTreeNode<Key, Value>* AVLTree<Key, Value>::get_local_min(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::intersect_with(AVLTreeNode<Key, Value>* node, AVLTreeNode<Key, Value>* other, Fork& fork) {
+  if (node == nullptr || other == nullptr) {
+    clear(node);
+    clear(other);
+    return nullptr;
+  }
+
+  size_t work = get_size(node) + get_size(other);
+  AVLTreeNode<Key, Value>* less;
+  AVLTreeNode<Key, Value>* match;
+  AVLTreeNode<Key, Value>* greater;
+  split(other, node->key, node->prefix(), less, match, greater);
+
+  AVLTreeNode<Key, Value>* left = node->left;
+  AVLTreeNode<Key, Value>* right = node->right;
+  fork(work, [&] { left = intersect_with(left, less, fork); }, [&] { right = intersect_with(right, greater, fork); });
+
+  Stats::free();
+  if (match != nullptr) {
+    delete match;
+    return join(left, node, right);
+  }
+
+  delete node;
+  return join(left, right);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::difference(AVLTreeNode<Key, Value>* node, AVLTreeNode<Key, Value>* other, Fork& fork) {
+  if (node == nullptr) {
+    clear(other);
+    return nullptr;
+  }
+  if (other == nullptr) return node;
+
+  size_t work = get_size(node) + get_size(other);
+  AVLTreeNode<Key, Value>* less;
+  AVLTreeNode<Key, Value>* match;
+  AVLTreeNode<Key, Value>* greater;
+  split(other, node->key, node->prefix(), less, match, greater);
+
+  AVLTreeNode<Key, Value>* left = node->left;
+  AVLTreeNode<Key, Value>* right = node->right;
+  fork(work, [&] { left = difference(left, less, fork); }, [&] { right = difference(right, greater, fork); });
+
+  if (match != nullptr) {
+    Stats::free();
+    Stats::free();
+    delete match;
+    delete node;
+    return join(left, right);
+  }
+
+  return join(left, node, right);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::get_local_min(AVLTreeNode<Key, Value>* node) {
   AVLTreeNode<Key, Value>* current = node;
   while (current->left != nullptr) {
     current = current->left;
@@ -352,21 +672,49 @@ AVLTreeNode<Key, Value>* AVLTree<Key, Value>::get_local_min(AVLTreeNode<Key, Val
   return current;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::clear(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::clear(AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
   clear(node->left);
   clear(node->right);
+  Stats::free();
   delete node;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::print_node(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::clone(const AVLTreeNode<Key, Value>* node) const {
+  if (node == nullptr) return nullptr;
+
+  Stats::allocation();
+  AVLTreeNode<Key, Value>* copy = new AVLTreeNode<Key, Value>(node->key, node->value);
+  copy->height = node->height;
+  copy->subtree_size = node->subtree_size;
+  copy->left = clone(node->left);
+  copy->right = clone(node->right);
+  return copy;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename It>
+AVLTreeNode<Key, Value>* AVLTree<Key, Value, Stats, Compare>::build(It pairs, size_t begin, size_t end) {
+  if (begin == end) return nullptr;
+
+  size_t middle = begin + (end - begin) / 2;
+  Stats::allocation();
+  AVLTreeNode<Key, Value>* node = new AVLTreeNode<Key, Value>(pairs[middle].first, pairs[middle].second);
+  node->left = build(pairs, begin, middle);
+  node->right = build(pairs, middle + 1, end);
+  update_height(node);
+  return node;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::print_node(AVLTreeNode<Key, Value>* node) {
   std::cout << "(" << node->key << "," << node->value << "), ";
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::in_order(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::in_order(AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
 
   in_order(node->left);
@@ -374,8 +722,8 @@ void AVLTree<Key, Value>::in_order(AVLTreeNode<Key, Value>* node) {
   in_order(node->right);
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::pre_order(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::pre_order(AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
 
   print_node(node);
@@ -383,8 +731,8 @@ void AVLTree<Key, Value>::pre_order(AVLTreeNode<Key, Value>* node) {
   pre_order(node->right);
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::post_order(AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::post_order(AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
 
   post_order(node->left);
@@ -392,96 +740,275 @@ void AVLTree<Key, Value>::post_order(AVLTreeNode<Key, Value>* node) {
   print_node(node);
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::to_vector(std::vector<std::pair<Key, Value>>& vector, AVLTreeNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::to_vector(std::vector<std::pair<Key, Value>>& vector, AVLTreeNode<Key, Value>* node) {
   if (node == nullptr) return;
   to_vector(vector, node->left);
   vector.push_back(std::pair<Key, Value>(node->key, node->value));
   to_vector(vector, node->right);
 }
 
-template <typename Key, typename Value>
-Value& AVLTree<Key, Value>::search(const Key& key) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+Value& AVLTree<Key, Value, Stats, Compare>::search(const Key& key) {
   AVLTreeNode<Key, Value>* result = search(root, key);
   if (result == nullptr) throw std::out_of_range("Key not found!");
-  return result;
+  return result->value;
 }
 
-template <typename Key, typename Value>
-const Value& AVLTree<Key, Value>::search(const Key& key) const {
-  AVLTreeNode<Key, Value>* result = search(root, key);
+template <typename Key, typename Value, typename Stats, typename Compare>
+const Value& AVLTree<Key, Value, Stats, Compare>::search(const Key& key) const {
+  const AVLTreeNode<Key, Value>* result = search(root, key);
   if (result == nullptr) throw std::out_of_range("Key not found!");
-  return result;
+  return result->value;
 }
 
-template <typename Key, typename Value>
-const bool AVLTree<Key, Value>::contains(const Key& key) const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+Value* AVLTree<Key, Value, Stats, Compare>::find(const Key& key) {
+  AVLTreeNode<Key, Value>* result = search(root, key);
+  return result == nullptr ? nullptr : &result->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const Value* AVLTree<Key, Value, Stats, Compare>::find(const Key& key) const {
+  const AVLTreeNode<Key, Value>* result = search(root, key);
+  return result == nullptr ? nullptr : &result->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const bool AVLTree<Key, Value, Stats, Compare>::contains(const Key& key) const {
   return search(root, key) != nullptr;
 }
 
-template <typename Key, typename Value>
-const bool AVLTree<Key, Value>::empty() const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const bool AVLTree<Key, Value, Stats, Compare>::empty() const {
   return root == nullptr;
 }
 
-template <typename Key, typename Value>
-const int AVLTree<Key, Value>::size() const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::size() const {
   return tree_size;
 }
 
-template <typename Key, typename Value>
-const int AVLTree<Key, Value>::height() const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int AVLTree<Key, Value, Stats, Compare>::height() const {
   if (root == nullptr) return 0;
 
   return root->height;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::insert(const Key& key, const Value& value) {
-  root = insert(root, key, value);
+template <typename Key, typename Value, typename Stats, typename Compare>
+const MemoryUsage AVLTree<Key, Value, Stats, Compare>::memory_usage() const {
+  size_t nodes = size_t(tree_size);
+
+  MemoryUsage usage;
+  usage.payload = nodes * (sizeof(Key) + sizeof(Value));
+  usage.overhead = sizeof(*this) + nodes * (sizeof(AVLTreeNode<Key, Value>) - sizeof(Key) - sizeof(Value));
+  usage.allocations = nodes;
+  return usage;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::remove(const Key& key) {
-  remove(root, key);
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::insert(const Key& key, const Value& value) {
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), key, value);
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::replace(const Key& key, const Value& value) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::insert(Key&& key, Value&& value) {
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), std::move(key), std::move(value));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+bool AVLTree<Key, Value, Stats, Compare>::try_emplace(const Key& key, Args&&... args) {
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), key, std::forward<Args>(args)...);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+bool AVLTree<Key, Value, Stats, Compare>::try_emplace(Key&& key, Args&&... args) {
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), std::move(key), std::forward<Args>(args)...);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+Value& AVLTree<Key, Value, Stats, Compare>::get_or_insert(const Key& key, Args&&... args) {
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), key, std::forward<Args>(args)...);
+  return found->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename V>
+bool AVLTree<Key, Value, Stats, Compare>::insert_or_assign(const Key& key, V&& value) {
+  // The value is only forwarded into a new node, so it is still intact when the key already exists
+  AVLTreeNode<Key, Value>* found = nullptr;
+  bool inserted = false;
+  root = emplace(root, found, inserted, 1, KeyPrefix<Key>(key), key, std::forward<V>(value));
+  if (!inserted) found->value = std::forward<V>(value);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::remove(const Key& key) {
+  root = remove(root, key, KeyPrefix<Key>(key));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::replace(const Key& key, const Value& value) {
   AVLTreeNode<Key, Value>* node = search(root, key);
+  if (node == nullptr) throw std::out_of_range("Key not found!");
   node->value = value;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::clear() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::clear() {
   clear(root);
   root = nullptr;
   tree_size = 0;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::in_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename It>
+void AVLTree<Key, Value, Stats, Compare>::assign_sorted(It first, It last) {
+  clear();
+  root = build(first, 0, last - first);
+  tree_size = get_size(root);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::split(const Key& key, AVLTree<Key, Value, Stats, Compare>& less, AVLTree<Key, Value, Stats, Compare>& greater) {
+  AVLTreeNode<Key, Value>* less_root;
+  AVLTreeNode<Key, Value>* match;
+  AVLTreeNode<Key, Value>* greater_root;
+  split(root, key, KeyPrefix<Key>(key), less_root, match, greater_root);
+
+  root = match;
+  tree_size = get_size(match);
+  less = AVLTree<Key, Value, Stats, Compare>(less_root, compare);
+  greater = AVLTree<Key, Value, Stats, Compare>(greater_root, compare);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::join(AVLTree<Key, Value, Stats, Compare> greater) {
+  if (root != nullptr && greater.root != nullptr) {
+    AVLTreeNode<Key, Value>* max = root;
+    while (max->right != nullptr) {
+      max = max->right;
+    }
+
+    AVLTreeNode<Key, Value>* min = get_local_min(greater.root);
+    if (compare_keys(compare, max->key, max->prefix(), min->key, min->prefix()) >= 0) {
+      throw std::invalid_argument("Joined tree must only hold greater keys!");
+    }
+  }
+
+  root = join(root, greater.root);
+  tree_size = get_size(root);
+  greater.root = nullptr;
+  greater.tree_size = 0;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+void AVLTree<Key, Value, Stats, Compare>::union_with(AVLTree<Key, Value, Stats, Compare> other, Fork fork) {
+  root = union_with(root, other.root, fork);
+  tree_size = get_size(root);
+  other.root = nullptr;
+  other.tree_size = 0;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+void AVLTree<Key, Value, Stats, Compare>::intersect_with(AVLTree<Key, Value, Stats, Compare> other, Fork fork) {
+  root = intersect_with(root, other.root, fork);
+  tree_size = get_size(root);
+  other.root = nullptr;
+  other.tree_size = 0;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fork>
+void AVLTree<Key, Value, Stats, Compare>::difference(AVLTree<Key, Value, Stats, Compare> other, Fork fork) {
+  root = difference(root, other.root, fork);
+  tree_size = get_size(root);
+  other.root = nullptr;
+  other.tree_size = 0;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::in_order() {
   in_order(root);
   std::cout << std::endl;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::pre_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::pre_order() {
   pre_order(root);
   std::cout << std::endl;
 }
 
-template <typename Key, typename Value>
-void AVLTree<Key, Value>::post_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void AVLTree<Key, Value, Stats, Compare>::post_order() {
   post_order(root);
   std::cout << std::endl;
 }
 
-template <typename Key, typename Value>
-std::vector<std::pair<Key, Value>> AVLTree<Key, Value>::to_vector() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+std::vector<std::pair<Key, Value>> AVLTree<Key, Value, Stats, Compare>::to_vector() {
   std::vector<std::pair<Key, Value>> vector;
   to_vector(vector, this->root);
   return vector;
 }
 
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fn>
+void AVLTree<Key, Value, Stats, Compare>::for_each(AVLTreeNode<Key, Value>* node, Fn& fn) {
+  if (node == nullptr) return;
+
+  for_each(node->left, fn);
+  fn(static_cast<const Key&>(node->key), node->value);
+  for_each(node->right, fn);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename T, typename Op>
+T AVLTree<Key, Value, Stats, Compare>::reduce(const AVLTreeNode<Key, Value>* node, T accumulator, Op& op) const {
+  if (node == nullptr) return accumulator;
+
+  accumulator = reduce(node->left, std::move(accumulator), op);
+  accumulator = op(std::move(accumulator), node->key, node->value);
+  return reduce(node->right, std::move(accumulator), op);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fn>
+void AVLTree<Key, Value, Stats, Compare>::for_each(Fn fn) {
+  for_each(root, fn);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename T, typename Op>
+T AVLTree<Key, Value, Stats, Compare>::reduce(T init, Op op) const {
+  return reduce(root, std::move(init), op);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Pred>
+const size_t AVLTree<Key, Value, Stats, Compare>::count_if(Pred pred) const {
+  return reduce(size_t(0), [&pred](size_t count, const Key& key, const Value& value) {
+    return pred(key, value) ? count + 1 : count;
+  });
+}
+
 #endif
@@ -2,117 +2,181 @@
 #ifndef BINARYSEARCHTREE_H
 #define BINARYSEARCHTREE_H
 
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
-// Struct defining a node in the binary search tree
+#include "../memory/MemoryUsage.hpp"
+#include "TreeCompare.hpp"
+#include "TreeStats.hpp"
+
+// Struct defining a node in the binary search tree, deriving from the cached prefix of its key
 template <typename Key, typename Value>
-struct BSTNode {
+struct BSTNode : KeyPrefix<Key> {
   Key key;                        // Key stored in the node
   Value value;                    // Value stored in the node
   BSTNode<Key, Value>* left;      // Pointer to the left child node
   BSTNode<Key, Value>* right;     // Pointer to the right child node
   
-  // Constructor to initialize the node with a value
-  BSTNode(const Key& key, const Value& value) : key(key), value(value), left(nullptr), right(nullptr) {}
+  // Constructor to initialize the node with a key and the arguments forwarded to the value
+  template <typename K, typename... Args>
+  BSTNode(K&& key, Args&&... args) : KeyPrefix<Key>(key), key(std::forward<K>(key)), value(std::forward<Args>(args)...), left(nullptr), right(nullptr) {}
+
+  // Cached prefix of the key, to be kept in step whenever the key changes
+  KeyPrefix<Key>& prefix() { return *this; }
+  const KeyPrefix<Key>& prefix() const { return *this; }
 };
 
 // Class representing a binary search tree
-template <typename Key, typename Value>
+// Stats is a TreeStats.hpp policy, NoTreeStats (the default) compiles every counter away
+// Compare is a TreeCompare.hpp three-way comparator
+template <typename Key, typename Value, typename Stats = NoTreeStats, typename Compare = ThreeWayCompare<Key>>
 class BST {
 private:
   BSTNode<Key, Value>* root;          // Pointer to the root node of the tree
+  Compare compare;                    // Orders the keys
 
   // Private Helper Functions
   BSTNode<Key, Value>* get_node(const Key& key);                                  // Finds a node with the given key
   const BSTNode<Key, Value>* get_node(const Key& key) const;                      // Finds a node with the given key
-  BSTNode<Key, Value>* get_local_min(BSTNode<Key, Value>* node) const;            // Finds the node with the minimum key in a subtree
+  const int order(const Key& key, const KeyPrefix<Key>& prefix, const BSTNode<Key, Value>* node) const;  // Compares a key and its prefix with the key of a node
   BSTNode<Key, Value>* get_local_max(BSTNode<Key, Value>* node) const;            // Finds the node with the maximum key in a subtree
-  void remove(BSTNode<Key, Value>*& node, const Key& key);                        // Recursively deletes all nodes with the given tree
+  void remove(BSTNode<Key, Value>*& node, const Key& key, const KeyPrefix<Key>& prefix);  // Recursively deletes the node with the given key
   void clear(BSTNode<Key, Value>* node);                                          // Recursively deletes all nodes in the tree
+  BSTNode<Key, Value>* clone(const BSTNode<Key, Value>* node) const;              // Recursively copies all nodes in a subtree
+  template <typename It>
+  BSTNode<Key, Value>* build(It pairs, size_t begin, size_t end);                 // Builds a perfectly balanced subtree from sorted pairs [begin, end)
+  template <typename K, typename... Args>
+  BSTNode<Key, Value>* emplace_node(bool& inserted, K&& key, Args&&... args);     // Links a new node unless the key already exists, returning the key's node
 
   void print_node(BSTNode<Key, Value>* node);                                     // Prints the given node
   void in_order(BSTNode<Key, Value>* node);                                       // Performs in-order traversal starting from the given node
   void pre_order(BSTNode<Key, Value>* node);                                      // Performs pre-order traversal starting from the given node
   void post_order(BSTNode<Key, Value>* node);                                     // Performs post-order traversal starting from the given node
+  template <typename Fn>
+  void for_each(BSTNode<Key, Value>* node, Fn& fn);                               // Visits every node of a subtree in order
+  template <typename T, typename Op>
+  T reduce(const BSTNode<Key, Value>* node, T accumulator, Op& op) const;         // Folds every node of a subtree in order
 
 public:
   // Constructors and Destructor
-  BST() : root(nullptr) {}                                                        // Default constructor
+  BST() : root(nullptr), compare() {}                                             // Default constructor
+  explicit BST(const Compare& compare) : root(nullptr), compare(compare) {}       // Constructor with a comparator
+  BST(const BST<Key, Value, Stats, Compare>& other);                                              // Copy constructor
+  BST(BST<Key, Value, Stats, Compare>&& other) noexcept;                                          // Move constructor
   ~BST();                                                                         // Destructor
+
+  // Assignment
+  BST<Key, Value, Stats, Compare>& operator=(const BST<Key, Value, Stats, Compare>& other);                       // Copy assignment operator
+  BST<Key, Value, Stats, Compare>& operator=(BST<Key, Value, Stats, Compare>&& other) noexcept;                    // Move assignment operator
   
   // Accessors
   Value& search(const Key& key);                                                  // Returns the value associated with the given key from the tree
   const Value& search(const Key& key) const;                                      // Returns the value associated with the given key from the tree (const)
+  Value* find(const Key& key);                                                    // Returns the value associated with the given key, or nullptr if it is absent
+  const Value* find(const Key& key) const;                                        // Returns the value associated with the given key, or nullptr if it is absent (const)
+  const bool contains(const Key& key) const;                                      // Returns if the given key exists in the tree
+  const MemoryUsage memory_usage() const;                                         // Returns the bytes held by the tree, broken down (O(n), the tree keeps no size)
+  const TreeStatsSnapshot stats() const { return Stats::snapshot(); }             // Returns the counters of the stats policy, summed over every thread
+  void reset_stats() { Stats::reset(); }                                          // Zeroes the counters of the stats policy
   
   // Mutators
   void insert(const Key& key, const Value& value);                                // Inserts a new key-value pair into the tree
+  void insert(Key&& key, Value&& value);                                          // Moves a new key-value pair into the tree
+  template <typename... Args>
+  bool try_emplace(const Key& key, Args&&... args);                               // Constructs the value in place if the key is absent
+  template <typename... Args>
+  bool try_emplace(Key&& key, Args&&... args);                                    // Constructs the value in place if the key is absent (moved key)
+  template <typename... Args>
+  Value& get_or_insert(const Key& key, Args&&... args);                           // Returns the value of a key, first constructing it from args if the key is absent (one descent)
+  template <typename V>
+  bool insert_or_assign(const Key& key, V&& value);                               // Inserts a key-value pair or overwrites the value of an existing key, returning if it was inserted (one descent)
   void remove(const Key& key);                                                    // Removes a key-value pair from the tree
   void clear();                                                                   // Clears the tree
+  template <typename It>
+  void assign_sorted(It first, It last);                                          // Replaces the contents with pairs (first, second) of strictly increasing keys in O(n)
   
   // Utility
   void in_order();                                                                // Prints all key-value pairs in the tree (in-order)
   void pre_order();                                                               // Prints all key-value pairs in the tree (pre-order)
   void post_order();                                                              // Prints all key-value pairs in the tree (post-order)
+  template <typename Fn>
+  void for_each(Fn fn);                                                           // Calls fn(key, value) on every pair (in-order)
+  template <typename T, typename Op>
+  T reduce(T init, Op op) const;                                                  // Folds op(accumulator, key, value) over every pair (in-order)
+  template <typename Pred>
+  const size_t count_if(Pred pred) const;                                         // Counts the pairs for which pred(key, value) holds
+  const BSTNode<Key, Value>* get_root() const { return root; }                    // Returns the root node, read-only, for subtree algorithms
 };
 
 // Function definitions
-template <typename Key, typename Value>
-BSTNode<Key, Value>* BST<Key, Value>::get_node(const Key& key) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::get_node(const Key& key) {
   BSTNode<Key, Value>* current = root;
+  KeyPrefix<Key> prefix(key);
+  int depth = 0;
   while (current != nullptr) {
-    if (key < current->key) {
+    Stats::comparison();
+    depth++;
+    int order = this->order(key, prefix, current);
+    if (order < 0) {
       current = current->left;
     }
-    else if (key > current->key) {
+    else if (order > 0) {
       current = current->right;
     }
     else {
-      return current;
+      break;
     }
   }
-  return nullptr;
+  Stats::depth(depth);
+  return current;
 }
 
-template <typename Key, typename Value>
-const BSTNode<Key, Value>* BST<Key, Value>::get_node(const Key& key) const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+const BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::get_node(const Key& key) const {
   BSTNode<Key, Value>* current = root;
+  KeyPrefix<Key> prefix(key);
+  int depth = 0;
   while (current != nullptr) {
-    if (key < current->key) {
+    Stats::comparison();
+    depth++;
+    int order = this->order(key, prefix, current);
+    if (order < 0) {
       current = current->left;
     }
-    else if (key > current->key) {
+    else if (order > 0) {
       current = current->right;
     }
     else {
-      return current;
+      break;
     }
   }
-  return nullptr;
+  Stats::depth(depth);
+  return current;
 }
 
-template <typename Key, typename Value>
-BSTNode<Key, Value>* BST<Key, Value>::get_local_min(BSTNode<Key, Value>* node) const {
-  while (node->left != nullptr) {
-    node = node->left;
-  }
-  return node;
+template <typename Key, typename Value, typename Stats, typename Compare>
+const int BST<Key, Value, Stats, Compare>::order(const Key& key, const KeyPrefix<Key>& prefix, const BSTNode<Key, Value>* node) const {
+  return compare_keys(compare, key, prefix, node->key, node->prefix());
 }
 
-template <typename Key, typename Value>
-BSTNode<Key, Value>* BST<Key, Value>::get_local_max(BSTNode<Key, Value>* node) const {
+template <typename Key, typename Value, typename Stats, typename Compare>
+BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::get_local_max(BSTNode<Key, Value>* node) const {
   while (node->right != nullptr) {
     node = node->right;
   }
   return node;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::print_node(BSTNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::print_node(BSTNode<Key, Value>* node) {
   std::cout << "(" << node->key << ", " << node->value << "), ";
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::in_order(BSTNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::in_order(BSTNode<Key, Value>* node) {
   if (node == nullptr)  return;
 
   in_order(node->left);
@@ -120,8 +184,8 @@ void BST<Key, Value>::in_order(BSTNode<Key, Value>* node) {
   in_order(node->right);
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::pre_order(BSTNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::pre_order(BSTNode<Key, Value>* node) {
   if (node == nullptr)  return;
 
   print_node(node);
@@ -129,8 +193,8 @@ void BST<Key, Value>::pre_order(BSTNode<Key, Value>* node) {
   in_order(node->right);
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::post_order(BSTNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::post_order(BSTNode<Key, Value>* node) {
   if (node == nullptr)  return;
 
   in_order(node->left);
@@ -138,118 +202,309 @@ void BST<Key, Value>::post_order(BSTNode<Key, Value>* node) {
   print_node(node);
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::remove(BSTNode<Key, Value>*& node, const Key& key) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::remove(BSTNode<Key, Value>*& node, const Key& key, const KeyPrefix<Key>& prefix) {
   if (node == nullptr) return;
   
-  if (key < node->key) {
-    remove(node->left, key);
+  Stats::comparison();
+  int order = this->order(key, prefix, node);
+  if (order < 0) {
+    remove(node->left, key, prefix);
     return;
   }
 
-  if (key > node->key) {
-    remove(node->right, key);
+  if (order > 0) {
+    remove(node->right, key, prefix);
     return;
   } 
   
   if (node->left == nullptr && node->right == nullptr) {
+    Stats::free();
     delete node;
     node = nullptr;
   } else if (node->left == nullptr) {
 
     BSTNode<Key, Value>* temp = node;
     node = node->right;
+    Stats::free();
     delete temp;
   } else if (node->right == nullptr) {
     BSTNode<Key, Value>* temp = node;
     node = node->left;
+    Stats::free();
     delete temp;
   } else {
-    BSTNode<Key, Value>* temp = get_local_min(node->right);
-    
-    node->key = temp->key;
-    node->value = temp->value;
-    remove(node->right, key);
+    // Unlink the in-order successor and splice it into the node's place, so keys are never assigned and may be move-only
+    BSTNode<Key, Value>** link = &node->right;
+    while ((*link)->left != nullptr) {
+      link = &(*link)->left;
+    }
+
+    BSTNode<Key, Value>* successor = *link;
+    *link = successor->right;
+    successor->left = node->left;
+    successor->right = node->right;
+    Stats::free();
+    delete node;
+    node = successor;
   }
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::clear(BSTNode<Key, Value>* node) {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::clear(BSTNode<Key, Value>* node) {
   if (node == nullptr) return;
   clear(node->left);
   clear(node->right);
+  Stats::free();
   delete node;
 }
 
-template <typename Key, typename Value>
-BST<Key, Value>::~BST() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::clone(const BSTNode<Key, Value>* node) const {
+  if (node == nullptr) return nullptr;
+
+  Stats::allocation();
+  BSTNode<Key, Value>* copy = new BSTNode<Key, Value>(node->key, node->value);
+  copy->left = clone(node->left);
+  copy->right = clone(node->right);
+  return copy;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename It>
+BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::build(It pairs, size_t begin, size_t end) {
+  if (begin == end) return nullptr;
+
+  size_t middle = begin + (end - begin) / 2;
+  Stats::allocation();
+  BSTNode<Key, Value>* node = new BSTNode<Key, Value>(pairs[middle].first, pairs[middle].second);
+  node->left = build(pairs, begin, middle);
+  node->right = build(pairs, middle + 1, end);
+  return node;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+BST<Key, Value, Stats, Compare>::BST(const BST<Key, Value, Stats, Compare>& other) : root(clone(other.root)), compare(other.compare) {}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+BST<Key, Value, Stats, Compare>::BST(BST<Key, Value, Stats, Compare>&& other) noexcept : root(other.root), compare(other.compare) {
+  other.root = nullptr;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+BST<Key, Value, Stats, Compare>::~BST() {
   clear();
 }
 
-template <typename Key, typename Value>
-Value& BST<Key, Value>::search(const Key& key) {
-  return get_node(key)->value;
+template <typename Key, typename Value, typename Stats, typename Compare>
+BST<Key, Value, Stats, Compare>& BST<Key, Value, Stats, Compare>::operator=(const BST<Key, Value, Stats, Compare>& other) {
+  if (this != &other) {
+    BST<Key, Value, Stats, Compare> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
 }
 
-template <typename Key, typename Value>
-const Value& BST<Key, Value>::search(const Key& key) const {
-  return get_node(key)->value;
+template <typename Key, typename Value, typename Stats, typename Compare>
+BST<Key, Value, Stats, Compare>& BST<Key, Value, Stats, Compare>::operator=(BST<Key, Value, Stats, Compare>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(root, other.root);
+    compare = other.compare;
+  }
+  return *this;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::insert(const Key& key, const Value& value) {
-  BSTNode<Key, Value>* node = new BSTNode<Key, Value>(key, value);
-  if (root == nullptr) { root = node; return; }
+template <typename Key, typename Value, typename Stats, typename Compare>
+Value& BST<Key, Value, Stats, Compare>::search(const Key& key) {
+  BSTNode<Key, Value>* node = get_node(key);
+  if (node == nullptr) throw std::out_of_range("Key not found!");
+  return node->value;
+}
 
-  BSTNode<Key, Value>* current = root;
-  BSTNode<Key, Value>* parent = nullptr;
-  while (current != nullptr) {
-    parent = current;
-    if (key < current->key) {
-      current = current->left;
+template <typename Key, typename Value, typename Stats, typename Compare>
+const Value& BST<Key, Value, Stats, Compare>::search(const Key& key) const {
+  const BSTNode<Key, Value>* node = get_node(key);
+  if (node == nullptr) throw std::out_of_range("Key not found!");
+  return node->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+Value* BST<Key, Value, Stats, Compare>::find(const Key& key) {
+  BSTNode<Key, Value>* node = get_node(key);
+  return node == nullptr ? nullptr : &node->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const Value* BST<Key, Value, Stats, Compare>::find(const Key& key) const {
+  const BSTNode<Key, Value>* node = get_node(key);
+  return node == nullptr ? nullptr : &node->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const bool BST<Key, Value, Stats, Compare>::contains(const Key& key) const {
+  return get_node(key) != nullptr;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+const MemoryUsage BST<Key, Value, Stats, Compare>::memory_usage() const {
+  size_t nodes = reduce(size_t(0), [](size_t count, const Key&, const Value&) { return count + 1; });
+
+  MemoryUsage usage;
+  usage.payload = nodes * (sizeof(Key) + sizeof(Value));
+  usage.overhead = sizeof(*this) + nodes * (sizeof(BSTNode<Key, Value>) - sizeof(Key) - sizeof(Value));
+  usage.allocations = nodes;
+  return usage;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename K, typename... Args>
+BSTNode<Key, Value>* BST<Key, Value, Stats, Compare>::emplace_node(bool& inserted, K&& key, Args&&... args) {
+  BSTNode<Key, Value>** link = &root;
+  KeyPrefix<Key> prefix(key);
+  int depth = 1;
+  while (*link != nullptr) {
+    Stats::comparison();
+    depth++;
+    int order = this->order(key, prefix, *link);
+    if (order < 0) {
+      link = &(*link)->left;
     }
-    else if (key > current->key) {
-      current = current->right;
+    else if (order > 0) {
+      link = &(*link)->right;
     } else {
-      return;
+      inserted = false;
+      return *link;
     }
   }
 
-  if (key < parent->key) {
-    parent->left = node;
-  }
-  else {
-    parent->right = node;
-  }
+  // Only allocate once the key is known to be absent
+  Stats::depth(depth);
+  Stats::allocation();
+  *link = new BSTNode<Key, Value>(std::forward<K>(key), std::forward<Args>(args)...);
+  inserted = true;
+  return *link;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::remove(const Key& key) {
-  remove(root, key);
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::insert(const Key& key, const Value& value) {
+  bool inserted;
+  emplace_node(inserted, key, value);
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::clear() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::insert(Key&& key, Value&& value) {
+  bool inserted;
+  emplace_node(inserted, std::move(key), std::move(value));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+bool BST<Key, Value, Stats, Compare>::try_emplace(const Key& key, Args&&... args) {
+  bool inserted;
+  emplace_node(inserted, key, std::forward<Args>(args)...);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+bool BST<Key, Value, Stats, Compare>::try_emplace(Key&& key, Args&&... args) {
+  bool inserted;
+  emplace_node(inserted, std::move(key), std::forward<Args>(args)...);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename... Args>
+Value& BST<Key, Value, Stats, Compare>::get_or_insert(const Key& key, Args&&... args) {
+  bool inserted;
+  return emplace_node(inserted, key, std::forward<Args>(args)...)->value;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename V>
+bool BST<Key, Value, Stats, Compare>::insert_or_assign(const Key& key, V&& value) {
+  // The value is only forwarded into a new node, so it is still intact when the key already exists
+  bool inserted;
+  BSTNode<Key, Value>* node = emplace_node(inserted, key, std::forward<V>(value));
+  if (!inserted) node->value = std::forward<V>(value);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::remove(const Key& key) {
+  remove(root, key, KeyPrefix<Key>(key));
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::clear() {
   clear(root);
   root = nullptr;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::in_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename It>
+void BST<Key, Value, Stats, Compare>::assign_sorted(It first, It last) {
+  clear();
+  root = build(first, 0, last - first);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::in_order() {
   in_order(root);
   std::cout << std::endl;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::pre_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::pre_order() {
   pre_order(root);
   std::cout << std::endl;
 }
 
-template <typename Key, typename Value>
-void BST<Key, Value>::post_order() {
+template <typename Key, typename Value, typename Stats, typename Compare>
+void BST<Key, Value, Stats, Compare>::post_order() {
   post_order(root);
   std::cout << std::endl;
 }
 
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fn>
+void BST<Key, Value, Stats, Compare>::for_each(BSTNode<Key, Value>* node, Fn& fn) {
+  if (node == nullptr) return;
+
+  for_each(node->left, fn);
+  fn(static_cast<const Key&>(node->key), node->value);
+  for_each(node->right, fn);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename T, typename Op>
+T BST<Key, Value, Stats, Compare>::reduce(const BSTNode<Key, Value>* node, T accumulator, Op& op) const {
+  if (node == nullptr) return accumulator;
+
+  accumulator = reduce(node->left, std::move(accumulator), op);
+  accumulator = op(std::move(accumulator), node->key, node->value);
+  return reduce(node->right, std::move(accumulator), op);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Fn>
+void BST<Key, Value, Stats, Compare>::for_each(Fn fn) {
+  for_each(root, fn);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename T, typename Op>
+T BST<Key, Value, Stats, Compare>::reduce(T init, Op op) const {
+  return reduce(root, std::move(init), op);
+}
+
+template <typename Key, typename Value, typename Stats, typename Compare>
+template <typename Pred>
+const size_t BST<Key, Value, Stats, Compare>::count_if(Pred pred) const {
+  return reduce(size_t(0), [&pred](size_t count, const Key& key, const Value& value) {
+    return pred(key, value) ? count + 1 : count;
+  });
+}
+
 #endif
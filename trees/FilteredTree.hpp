@@ -0,0 +1,173 @@
+// FilteredTree.hpp
+#ifndef FILTEREDTREE_H
+#define FILTEREDTREE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "../filters/CuckooFilter.hpp"
+#include "../memory/MemoryUsage.hpp"
+#include "AVLTree.hpp"
+
+// Class pairing a tree (AVLTree or BST) with an approximate membership filter kept in step on every insert and remove
+// A key the filter rules out is answered without walking the tree, so most misses cost one or two cache misses
+// The tree is only handed out read-only, so it cannot change behind the filter's back
+// Filter needs insert/remove/possibly_contains/capacity/memory_usage and a constructor taking the expected key count
+template <typename Key, typename Value, typename Tree = AVLTree<Key, Value>, typename Filter = CuckooFilter<Key>>
+class FilteredTree {
+private:
+  Tree map;                           // Tree holding the pairs
+  Filter filter;                      // Filter over every key of the tree
+  size_t count;                       // Number of keys in the tree
+
+  // Private helper functions
+  void rebuild(size_t);                                                     // Refills the filter from the tree with room for a number of keys
+  void added(const Key&);                                                   // Records a key just inserted into the tree
+public:
+  // Constructor
+  FilteredTree(size_t expected = 1024) : map(), filter(expected), count(0) {}  // Sized for the expected number of keys, grown as needed
+
+  // Accessors
+  Value* find(const Key&);                                                  // Returns the value associated with the given key, or nullptr if it is absent
+  const Value* find(const Key&) const;                                      // Returns the value associated with the given key, or nullptr if it is absent (const)
+  Value& search(const Key&);                                                // Returns the value associated with the given key
+  const Value& search(const Key&) const;                                    // Returns the value associated with the given key (const)
+  const bool contains(const Key&) const;                                    // Returns if the given key exists in the tree
+  const size_t size() const { return count; }                               // Returns the number of pairs
+  const bool empty() const { return count == 0; }                           // Returns if the tree is empty
+  const Tree& tree() const { return map; }                                  // Returns the tree, e.g. for ordered traversal
+  const MemoryUsage memory_usage() const;                                   // Returns the bytes held by the tree and the filter, broken down
+
+  // Mutators
+  void insert(const Key&, const Value&);                                    // Inserts a new key-value pair, leaving an existing key alone (as the trees do)
+  template <typename... Args>
+  bool try_emplace(const Key&, Args&&...);                                  // Constructs the value in place if the key is absent
+  template <typename... Args>
+  Value& get_or_insert(const Key&, Args&&...);                              // Returns the value of a key, first constructing it from args if the key is absent
+  template <typename V>
+  bool insert_or_assign(const Key&, V&&);                                   // Inserts a key-value pair or overwrites the value of an existing key, returning if it was inserted
+  bool remove(const Key&);                                                  // Removes a key-value pair, returning if the key was present
+  void clear();                                                             // Clears the tree and the filter
+};
+
+// Function definitions
+template <typename Key, typename Value, typename Tree, typename Filter>
+void FilteredTree<Key, Value, Tree, Filter>::rebuild(size_t expected) {
+  // A filter too full to take every key is retried twice the size
+  while (true) {
+    Filter fresh(expected);
+    bool complete = true;
+    map.for_each([&](const Key& key, const Value&) { complete = complete && fresh.insert(key); });
+
+    if (complete) {
+      filter = std::move(fresh);
+      return;
+    }
+    expected *= 2;
+  }
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+void FilteredTree<Key, Value, Tree, Filter>::added(const Key& key) {
+  count++;
+
+  // Past 95% load the eviction chains grow long, so the filter doubles before it gets there
+  if (20 * count > 19 * filter.capacity() || !filter.insert(key)) rebuild(2 * count);
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+Value* FilteredTree<Key, Value, Tree, Filter>::find(const Key& key) {
+  if (!filter.possibly_contains(key)) return nullptr;
+
+  return map.find(key);
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+const Value* FilteredTree<Key, Value, Tree, Filter>::find(const Key& key) const {
+  if (!filter.possibly_contains(key)) return nullptr;
+
+  return map.find(key);
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+Value& FilteredTree<Key, Value, Tree, Filter>::search(const Key& key) {
+  Value* value = find(key);
+  if (value == nullptr) throw std::out_of_range("Key not found!");
+  return *value;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+const Value& FilteredTree<Key, Value, Tree, Filter>::search(const Key& key) const {
+  const Value* value = find(key);
+  if (value == nullptr) throw std::out_of_range("Key not found!");
+  return *value;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+const bool FilteredTree<Key, Value, Tree, Filter>::contains(const Key& key) const {
+  return find(key) != nullptr;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+const MemoryUsage FilteredTree<Key, Value, Tree, Filter>::memory_usage() const {
+  MemoryUsage usage = map.memory_usage();
+  usage += filter.memory_usage();
+  usage.overhead += sizeof(*this) - sizeof(map) - sizeof(filter);
+  return usage;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+void FilteredTree<Key, Value, Tree, Filter>::insert(const Key& key, const Value& value) {
+  try_emplace(key, value);
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+template <typename... Args>
+bool FilteredTree<Key, Value, Tree, Filter>::try_emplace(const Key& key, Args&&... args) {
+  if (!map.try_emplace(key, std::forward<Args>(args)...)) return false;
+  added(key);
+  return true;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+template <typename... Args>
+Value& FilteredTree<Key, Value, Tree, Filter>::get_or_insert(const Key& key, Args&&... args) {
+  // A key the filter rules out is new, so only a possible hit walks the tree before the insert
+  if (filter.possibly_contains(key)) {
+    Value* existing = map.find(key);
+    if (existing != nullptr) return *existing;
+  }
+
+  Value& value = map.get_or_insert(key, std::forward<Args>(args)...);
+  added(key);
+  return value;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+template <typename V>
+bool FilteredTree<Key, Value, Tree, Filter>::insert_or_assign(const Key& key, V&& value) {
+  if (!map.insert_or_assign(key, std::forward<V>(value))) return false;
+  added(key);
+  return true;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+bool FilteredTree<Key, Value, Tree, Filter>::remove(const Key& key) {
+  // The tree keeps no removal result, so a key the filter cannot rule out is looked up before it is removed
+  if (find(key) == nullptr) return false;
+
+  map.remove(key);
+  filter.remove(key);
+  count--;
+  return true;
+}
+
+template <typename Key, typename Value, typename Tree, typename Filter>
+void FilteredTree<Key, Value, Tree, Filter>::clear() {
+  map.clear();
+  filter.clear();
+  count = 0;
+}
+
+#endif
@@ -0,0 +1,356 @@
+// PersistentAVLTree.hpp
+#ifndef PERSISTENTAVLTREE_H
+#define PERSISTENTAVLTREE_H
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <vector>
+
+#include "../memory/MemoryUsage.hpp"
+
+// Struct defining an immutable node shared between versions of a persistent AVL tree
+template <typename Key, typename Value>
+struct PersistentAVLTreeNode {
+  using Pointer = std::shared_ptr<const PersistentAVLTreeNode<Key, Value>>;
+
+  const Key key;                      // Key stored in the node
+  const Value value;                  // Value stored in the node
+  const int height;                   // Height of the node in the tree
+
+  const Pointer left;                 // Shared pointer to the left child node
+  const Pointer right;                // Shared pointer to the right child node
+
+  // Constructor to initialize the node with a key, a value and its children
+  PersistentAVLTreeNode(const Key& key, const Value& value, Pointer left, Pointer right)
+    : key(key), value(value), height(std::max(left ? left->height : 0, right ? right->height : 0) + 1),
+      left(std::move(left)), right(std::move(right)) {}
+};
+
+// Class representing a persistent AVL tree
+// Mutators leave the tree untouched and return a new version that shares every unchanged subtree with it
+template <typename Key, typename Value>
+class PersistentAVLTree {
+private:
+  using Node = PersistentAVLTreeNode<Key, Value>;
+  using Pointer = typename Node::Pointer;
+
+  Pointer root;                       // Shared pointer to the root of this version
+  int tree_size;                      // Stores number of key-value pairs in this version
+
+  // Private constructor wrapping an existing root
+  PersistentAVLTree(Pointer root, int tree_size) : root(std::move(root)), tree_size(tree_size) {}
+
+  // Private Helper Functions
+  static const int get_height(const Pointer&);                                                          // Returns the height of the node
+  static Pointer make_node(const Key&, const Value&, Pointer, Pointer);                                 // Creates a node, rebalancing it if needed
+  static Pointer insert(const Pointer&, const Key&, const Value&, bool, bool&, bool&);                  // Path-copies the tree with a key-value pair added or replaced
+  static Pointer remove(const Pointer&, const Key&, bool&);                                             // Path-copies the tree with a key-value pair removed
+  static Pointer remove_min(const Pointer&, const Node*&);                                              // Path-copies a subtree without its minimum node
+
+  void print_node(const Node*) const;                                                                   // Prints the given node
+  void in_order(const Node*) const;                                                                     // Performs in-order traversal starting from the given node
+  void to_vector(std::vector<std::pair<Key, Value>>&, const Node*) const;
+public:
+  // Constructor
+  PersistentAVLTree() : root(nullptr), tree_size(0) {}                                                  // Default constructor
+  // Copying a version is O(1) and is how snapshots are taken
+
+  // Accessors
+  const Value* find(const Key&) const;                                                                  // Returns the value associated with the given key, or nullptr if it is absent
+  const Value& search(const Key&) const;                                                                // Returns the value associated with the given key
+  const bool contains(const Key&) const;                                                                // Returns if the given key exists in the tree
+  const bool empty() const;                                                                             // Returns if the tree is empty
+  const int size() const;                                                                               // Returns the size of the tree
+  const int height() const;                                                                             // Returns the height of the tree
+  const MemoryUsage memory_usage() const;                                                               // Returns the bytes reachable from this version, broken down (nodes shared with other versions are counted in each)
+
+  // Versioning operations, each returning a new version
+  PersistentAVLTree<Key, Value> insert(const Key&, const Value&) const;                                 // Returns a version with the key-value pair added (unchanged if the key exists)
+  PersistentAVLTree<Key, Value> replace(const Key&, const Value&) const;                                // Returns a version with the key mapped to the given value
+  PersistentAVLTree<Key, Value> remove(const Key&) const;                                               // Returns a version without the given key
+  PersistentAVLTree<Key, Value> snapshot() const;                                                       // Returns this version in O(1)
+
+  // Utility
+  void in_order() const;                                                                                // Prints the tree (in-order)
+  std::vector<std::pair<Key, Value>> to_vector() const;                                                 // Returns the tree as a vector
+  const bool shares_root_with(const PersistentAVLTree<Key, Value>&) const;                              // Returns if two versions are the same version
+
+  // Iterator
+  class Iterator {
+  private:
+    std::vector<const Node*> path;    // Ancestors still to be visited, the current node on top
+
+    // Private helper function to push a node and its left spine
+    void push_left(const Node* node) {
+      while (node != nullptr) {
+        path.push_back(node);
+        node = node->left.get();
+      }
+    }
+  public:
+    // Constructors
+    Iterator() {}
+    Iterator(const Node* root) { push_left(root); }
+
+    // Dereference operator
+    const Value& operator*() const { return path.back()->value; }
+
+    // Get the current key
+    const Key& get_key() const { return path.back()->key; }
+
+    // Get the current value
+    const Value& get_value() const { return path.back()->value; }
+
+    // Increment operator
+    Iterator& operator++() {
+      const Node* node = path.back();
+      path.pop_back();
+      push_left(node->right.get());
+      return *this;
+    }
+
+    // Inequality operator
+    bool operator!=(const Iterator& other) const {
+      const Node* mine = path.empty() ? nullptr : path.back();
+      const Node* theirs = other.path.empty() ? nullptr : other.path.back();
+      return mine != theirs;
+    }
+  };
+
+  // Iterator methods
+  Iterator begin() const { return Iterator(root.get()); }       // Returns an iterator pointing to the smallest key
+  Iterator end() const { return Iterator(); }                   // Returns an iterator pointing to the end
+};
+
+// Function Definitions
+template <typename Key, typename Value>
+const int PersistentAVLTree<Key, Value>::get_height(const Pointer& node) {
+  return node ? node->height : 0;
+}
+
+template <typename Key, typename Value>
+typename PersistentAVLTree<Key, Value>::Pointer PersistentAVLTree<Key, Value>::make_node(const Key& key, const Value& value, Pointer left, Pointer right) {
+  int balance = get_height(left) - get_height(right);
+
+  // right
+  if (balance > 1 && get_height(left->left) >= get_height(left->right)) {
+    return std::make_shared<const Node>(left->key, left->value, left->left,
+      std::make_shared<const Node>(key, value, left->right, std::move(right)));
+  }
+
+  // left-right
+  if (balance > 1) {
+    const Pointer& pivot = left->right;
+    return std::make_shared<const Node>(pivot->key, pivot->value,
+      std::make_shared<const Node>(left->key, left->value, left->left, pivot->left),
+      std::make_shared<const Node>(key, value, pivot->right, std::move(right)));
+  }
+
+  // left
+  if (balance < -1 && get_height(right->right) >= get_height(right->left)) {
+    return std::make_shared<const Node>(right->key, right->value,
+      std::make_shared<const Node>(key, value, std::move(left), right->left), right->right);
+  }
+
+  // right-left
+  if (balance < -1) {
+    const Pointer& pivot = right->left;
+    return std::make_shared<const Node>(pivot->key, pivot->value,
+      std::make_shared<const Node>(key, value, std::move(left), pivot->left),
+      std::make_shared<const Node>(right->key, right->value, pivot->right, right->right));
+  }
+
+  return std::make_shared<const Node>(key, value, std::move(left), std::move(right));
+}
+
+template <typename Key, typename Value>
+typename PersistentAVLTree<Key, Value>::Pointer PersistentAVLTree<Key, Value>::insert(const Pointer& node, const Key& key, const Value& value, bool overwrite, bool& changed, bool& added) {
+  if (!node) {
+    changed = true;
+    added = true;
+    return std::make_shared<const Node>(key, value, nullptr, nullptr);
+  }
+
+  if (key < node->key) {
+    Pointer left = insert(node->left, key, value, overwrite, changed, added);
+    return changed ? make_node(node->key, node->value, std::move(left), node->right) : node;
+  }
+
+  if (key > node->key) {
+    Pointer right = insert(node->right, key, value, overwrite, changed, added);
+    return changed ? make_node(node->key, node->value, node->left, std::move(right)) : node;
+  }
+
+  if (!overwrite) return node;
+
+  changed = true;
+  return std::make_shared<const Node>(key, value, node->left, node->right);
+}
+
+template <typename Key, typename Value>
+typename PersistentAVLTree<Key, Value>::Pointer PersistentAVLTree<Key, Value>::remove_min(const Pointer& node, const Node*& min) {
+  if (!node->left) {
+    min = node.get();
+    return node->right;
+  }
+
+  return make_node(node->key, node->value, remove_min(node->left, min), node->right);
+}
+
+template <typename Key, typename Value>
+typename PersistentAVLTree<Key, Value>::Pointer PersistentAVLTree<Key, Value>::remove(const Pointer& node, const Key& key, bool& changed) {
+  if (!node) return node;
+
+  if (key < node->key) {
+    Pointer left = remove(node->left, key, changed);
+    return changed ? make_node(node->key, node->value, std::move(left), node->right) : node;
+  }
+
+  if (key > node->key) {
+    Pointer right = remove(node->right, key, changed);
+    return changed ? make_node(node->key, node->value, node->left, std::move(right)) : node;
+  }
+
+  changed = true;
+  if (!node->left) return node->right;
+  if (!node->right) return node->left;
+
+  // The old version keeps the successor node alive, so it can be read after unlinking
+  const Node* successor = nullptr;
+  Pointer right = remove_min(node->right, successor);
+  return make_node(successor->key, successor->value, node->left, std::move(right));
+}
+
+template <typename Key, typename Value>
+void PersistentAVLTree<Key, Value>::print_node(const Node* node) const {
+  std::cout << "(" << node->key << "," << node->value << "), ";
+}
+
+template <typename Key, typename Value>
+void PersistentAVLTree<Key, Value>::in_order(const Node* node) const {
+  if (node == nullptr) return;
+
+  in_order(node->left.get());
+  print_node(node);
+  in_order(node->right.get());
+}
+
+template <typename Key, typename Value>
+void PersistentAVLTree<Key, Value>::to_vector(std::vector<std::pair<Key, Value>>& vector, const Node* node) const {
+  if (node == nullptr) return;
+  to_vector(vector, node->left.get());
+  vector.push_back(std::pair<Key, Value>(node->key, node->value));
+  to_vector(vector, node->right.get());
+}
+
+template <typename Key, typename Value>
+const Value* PersistentAVLTree<Key, Value>::find(const Key& key) const {
+  const Node* node = root.get();
+  while (node != nullptr) {
+    if (key < node->key) node = node->left.get();
+    else if (key > node->key) node = node->right.get();
+    else return &node->value;
+  }
+
+  return nullptr;
+}
+
+template <typename Key, typename Value>
+const Value& PersistentAVLTree<Key, Value>::search(const Key& key) const {
+  const Value* value = find(key);
+  if (value == nullptr) throw std::out_of_range("Key not found!");
+  return *value;
+}
+
+template <typename Key, typename Value>
+const bool PersistentAVLTree<Key, Value>::contains(const Key& key) const {
+  return find(key) != nullptr;
+}
+
+template <typename Key, typename Value>
+const bool PersistentAVLTree<Key, Value>::empty() const {
+  return root == nullptr;
+}
+
+template <typename Key, typename Value>
+const int PersistentAVLTree<Key, Value>::size() const {
+  return tree_size;
+}
+
+template <typename Key, typename Value>
+const int PersistentAVLTree<Key, Value>::height() const {
+  return get_height(root);
+}
+
+template <typename Key, typename Value>
+const MemoryUsage PersistentAVLTree<Key, Value>::memory_usage() const {
+  // make_shared puts a vtable pointer and the two reference counts in front of every node
+  const size_t control_block = sizeof(void*) + 2 * sizeof(int);
+
+  MemoryUsage usage;
+  usage.overhead = sizeof(*this);
+  std::vector<const Node*> pending;
+  if (root) pending.push_back(root.get());
+  while (!pending.empty()) {
+    const Node* node = pending.back();
+    pending.pop_back();
+
+    usage.payload += sizeof(Key) + sizeof(Value);
+    usage.overhead += sizeof(Node) - sizeof(Key) - sizeof(Value) + control_block;
+    usage.allocations++;
+    if (node->left) pending.push_back(node->left.get());
+    if (node->right) pending.push_back(node->right.get());
+  }
+  return usage;
+}
+
+template <typename Key, typename Value>
+PersistentAVLTree<Key, Value> PersistentAVLTree<Key, Value>::insert(const Key& key, const Value& value) const {
+  bool changed = false, added = false;
+  Pointer new_root = insert(root, key, value, false, changed, added);
+  return PersistentAVLTree<Key, Value>(std::move(new_root), added ? tree_size + 1 : tree_size);
+}
+
+template <typename Key, typename Value>
+PersistentAVLTree<Key, Value> PersistentAVLTree<Key, Value>::replace(const Key& key, const Value& value) const {
+  bool changed = false, added = false;
+  Pointer new_root = insert(root, key, value, true, changed, added);
+  return PersistentAVLTree<Key, Value>(std::move(new_root), added ? tree_size + 1 : tree_size);
+}
+
+template <typename Key, typename Value>
+PersistentAVLTree<Key, Value> PersistentAVLTree<Key, Value>::remove(const Key& key) const {
+  bool changed = false;
+  Pointer new_root = remove(root, key, changed);
+  return PersistentAVLTree<Key, Value>(std::move(new_root), changed ? tree_size - 1 : tree_size);
+}
+
+template <typename Key, typename Value>
+PersistentAVLTree<Key, Value> PersistentAVLTree<Key, Value>::snapshot() const {
+  return *this;
+}
+
+template <typename Key, typename Value>
+void PersistentAVLTree<Key, Value>::in_order() const {
+  in_order(root.get());
+  std::cout << std::endl;
+}
+
+template <typename Key, typename Value>
+std::vector<std::pair<Key, Value>> PersistentAVLTree<Key, Value>::to_vector() const {
+  std::vector<std::pair<Key, Value>> vector;
+  vector.reserve(tree_size);
+  to_vector(vector, root.get());
+  return vector;
+}
+
+template <typename Key, typename Value>
+const bool PersistentAVLTree<Key, Value>::shares_root_with(const PersistentAVLTree<Key, Value>& other) const {
+  return root == other.root;
+}
+
+#endif
@@ -0,0 +1,1192 @@
+// RadixTree.hpp
+#ifndef RADIXTREE_H
+#define RADIXTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../memory/MemoryUsage.hpp"
+
+// Class holding the bytes of a compressed path, stored inside the node when short and in a heap block otherwise,
+// so the common short prefixes and suffixes cost no allocation and far less than a std::string
+class RadixPath {
+private:
+  static constexpr size_t inline_capacity = 12;
+  static_assert(sizeof(char*) <= inline_capacity, "RadixPath must be able to hold a pointer inline");
+
+  uint32_t length;                               // Number of bytes
+  unsigned char storage[inline_capacity];        // The bytes when they fit, otherwise the pointer to their heap block
+
+  const bool on_heap() const { return length > inline_capacity; }
+  char* heap() const {
+    char* block;
+    std::memcpy(&block, storage, sizeof(block));
+    return block;
+  }
+
+  // Private helper function to replace the bytes, which may point into the current ones
+  void assign(const char* bytes, size_t count) {
+    if (count > UINT32_MAX) throw std::length_error("Key is too long");
+
+    unsigned char fresh[inline_capacity] = {};
+    if (count > inline_capacity) {
+      char* block = new char[count];
+      std::memcpy(block, bytes, count);
+      std::memcpy(fresh, &block, sizeof(block));
+    } else if (count > 0) {
+      std::memcpy(fresh, bytes, count);
+    }
+
+    if (on_heap()) delete[] heap();
+    std::memcpy(storage, fresh, inline_capacity);
+    length = uint32_t(count);
+  }
+public:
+  RadixPath() : length(0), storage() {}
+  explicit RadixPath(std::string_view bytes) : length(0), storage() { assign(bytes.data(), bytes.size()); }
+  RadixPath(const RadixPath& other) : length(0), storage() { assign(other.data(), other.size()); }
+  RadixPath(RadixPath&& other) noexcept : length(other.length) {
+    std::memcpy(storage, other.storage, inline_capacity);
+    other.length = 0;
+  }
+  RadixPath& operator=(const RadixPath& other) {
+    if (this != &other) assign(other.data(), other.size());
+    return *this;
+  }
+  RadixPath& operator=(RadixPath&& other) noexcept {
+    if (this != &other) {
+      if (on_heap()) delete[] heap();
+      length = other.length;
+      std::memcpy(storage, other.storage, inline_capacity);
+      other.length = 0;
+    }
+    return *this;
+  }
+  ~RadixPath() {
+    if (on_heap()) delete[] heap();
+  }
+
+  const size_t size() const { return length; }
+  const char* data() const { return on_heap() ? heap() : reinterpret_cast<const char*>(storage); }
+  const char operator[](size_t index) const { return data()[index]; }
+  std::string_view view() const { return std::string_view(data(), length); }
+  const size_t heap_bytes() const { return on_heap() ? length : 0; }   // Bytes held in a heap block, 0 when inline
+
+  void clear() { assign(nullptr, 0); }
+  void erase_front(size_t count) { assign(data() + count, length - count); }   // Drops the first count bytes
+  void prepend(std::string_view bytes) {
+    std::string joined(bytes);
+    joined.append(data(), length);
+    assign(joined.data(), joined.size());
+  }
+};
+
+// Kinds of node in a radix tree
+enum class RadixNodeType : uint8_t { Leaf, Node4, Node16, Node48, Node256 };
+
+// Struct holding the type every radix tree node starts with
+struct RadixNode {
+  RadixNodeType type;                 // Concrete type of the node
+
+  explicit RadixNode(RadixNodeType type) : type(type) {}
+};
+
+// Struct defining a leaf, holding the rest of its key and the value
+template <typename Value>
+struct RadixLeaf : RadixNode {
+  RadixPath suffix;                   // Bytes of the key below the point the leaf hangs from
+  Value value;                        // Value stored in the leaf
+
+  // Constructor to initialize the leaf with its suffix and the arguments forwarded to the value
+  template <typename... Args>
+  RadixLeaf(RadixPath suffix, Args&&... args) : RadixNode(RadixNodeType::Leaf), suffix(std::move(suffix)), value(std::forward<Args>(args)...) {}
+};
+
+// Struct holding what every inner node has: a compressed path and the leaf of the key ending right after it
+struct RadixInner : RadixNode {
+  uint16_t count;                     // Number of children
+  RadixPath prefix;                   // Bytes every key below shares after the byte leading here (path compression)
+  RadixNode* terminal;                // Leaf of the key ending after the prefix, nullptr if there is none
+
+  RadixInner(RadixNodeType type, RadixPath prefix) : RadixNode(type), count(0), prefix(std::move(prefix)), terminal(nullptr) {}
+};
+
+// Inner node of up to 4 children, keys sorted
+struct RadixNode4 : RadixInner {
+  unsigned char keys[4];              // Byte of each child
+  RadixNode* children[4];             // Children in key order
+
+  explicit RadixNode4(RadixPath prefix) : RadixInner(RadixNodeType::Node4, std::move(prefix)), keys(), children() {}
+};
+
+// Inner node of up to 16 children, keys sorted and searched 16 at a time with SSE2
+struct RadixNode16 : RadixInner {
+  unsigned char keys[16];             // Byte of each child
+  RadixNode* children[16];            // Children in key order
+
+  explicit RadixNode16(RadixPath prefix) : RadixInner(RadixNodeType::Node16, std::move(prefix)), keys(), children() {}
+};
+
+// Inner node of up to 48 children, indexed by byte
+struct RadixNode48 : RadixInner {
+  unsigned char index[256];           // Slot + 1 of the child of each byte, 0 if there is none
+  RadixNode* children[48];            // Children in no particular order, nullptr for free slots
+
+  explicit RadixNode48(RadixPath prefix) : RadixInner(RadixNodeType::Node48, std::move(prefix)), index(), children() {}
+};
+
+// Inner node with a slot for every byte
+struct RadixNode256 : RadixInner {
+  RadixNode* children[256];           // Child of each byte, nullptr if there is none
+
+  explicit RadixNode256(RadixPath prefix) : RadixInner(RadixNodeType::Node256, std::move(prefix)), children() {}
+};
+
+// Class representing an ordered map from strings to values as an adaptive radix tree (Leis et al., ICDE 2013)
+// Inner nodes grow from 4 to 16, 48 and 256 children as needed and store the bytes their keys share only once,
+// so keys with long common prefixes cost neither the memory nor the comparisons of a comparison tree
+// Keys may hold any bytes, including '\0'; they are ordered like std::string::compare
+template <typename Value>
+class RadixTree {
+private:
+  using Leaf = RadixLeaf<Value>;
+
+  RadixNode* root;                    // Pointer to the root of the tree
+  int tree_size;                      // Stores number of key-value pairs in the tree
+
+  static Leaf* as_leaf(RadixNode* node) { return static_cast<Leaf*>(node); }
+  static const Leaf* as_leaf(const RadixNode* node) { return static_cast<const Leaf*>(node); }
+  static RadixInner* as_inner(RadixNode* node) { return static_cast<RadixInner*>(node); }
+  static const RadixInner* as_inner(const RadixNode* node) { return static_cast<const RadixInner*>(node); }
+
+  // Private Helper Functions
+  static RadixNode** find_child(RadixInner*, unsigned char);                          // Returns the slot of the child of a byte, nullptr if there is none
+  static RadixNode* next_child(const RadixInner*, int, int&);                         // Returns the child of the smallest byte >= the given one and sets that byte
+  static void add_child(RadixNode*&, unsigned char, RadixNode*);                      // Adds a child, growing the node if it is full
+  static void remove_child(RadixNode*&, unsigned char);                               // Removes a child, shrinking or merging the node as it empties
+  static void compact(RadixNode*&);                                                   // Shrinks or merges an inner node that lost a child or its terminal
+  static size_t common_length(std::string_view, const std::string&, size_t);           // Counts the leading bytes of a string matching a key from a depth
+
+  const Leaf* find_leaf(const std::string&) const;                                    // Finds the leaf of a key
+  const RadixNode* find_prefix(const std::string&, size_t&) const;                    // Finds the subtree holding every key starting with a prefix
+  template <typename... Args>
+  Leaf* emplace(const std::string&, bool&, Args&&...);                                // Inserts a new key-value pair unless the key already exists, returning the key's leaf
+
+  // Utility
+  static void free_node(RadixNode*);                                                  // Deletes one node
+  static void clear(RadixNode*);                                                      // Recursively deletes all nodes in a subtree
+  static RadixNode* clone(const RadixNode*);                                          // Recursively copies all nodes in a subtree
+  template <typename Fn>
+  static void for_each(RadixNode*, std::string&, Fn&);                                // Visits every leaf of a subtree in order, key holding the bytes above it
+  static void measure(const RadixNode*, MemoryUsage&);                                // Adds up the bytes held by a subtree
+public:
+  // Constructors and Destructor
+  RadixTree() : root(nullptr), tree_size(0) {}                                        // Default constructor
+  RadixTree(std::vector<std::pair<std::string, Value>>);                              // Constructor from vector<pair>
+  RadixTree(const RadixTree<Value>&);                                                 // Copy constructor
+  RadixTree(RadixTree<Value>&&) noexcept;                                             // Move constructor
+  ~RadixTree();                                                                       // Destructor
+
+  // Assignment
+  RadixTree<Value>& operator=(const RadixTree<Value>&);                               // Copy assignment operator
+  RadixTree<Value>& operator=(RadixTree<Value>&&) noexcept;                           // Move assignment operator
+
+  // Accessors
+  Value& search(const std::string&);                                                  // Returns the value associated with the given key
+  const Value& search(const std::string&) const;                                      // Returns the value associated with the given key (const)
+  Value* find(const std::string&);                                                    // Returns the value associated with the given key, or nullptr if it is absent
+  const Value* find(const std::string&) const;                                        // Returns the value associated with the given key, or nullptr if it is absent (const)
+  const bool contains(const std::string&) const;                                      // Returns if the given key exists in the tree
+  const bool empty() const;                                                           // Returns if the tree is empty
+  const int size() const;                                                             // Returns the number of pairs in the tree
+  const MemoryUsage memory_usage() const;                                             // Returns the bytes held by the tree, broken down (O(n))
+
+  // Mutators
+  void insert(const std::string&, const Value&);                                      // Inserts a new key-value pair into the tree
+  void insert(std::string&&, Value&&);                                                // Moves a new key-value pair into the tree
+  template <typename... Args>
+  bool try_emplace(const std::string&, Args&&...);                                    // Constructs the value in place if the key is absent
+  template <typename... Args>
+  Value& get_or_insert(const std::string&, Args&&...);                                // Returns the value of a key, first constructing it from args if the key is absent (one descent)
+  template <typename V>
+  bool insert_or_assign(const std::string&, V&&);                                     // Inserts a key-value pair or overwrites the value of an existing key, returning if it was inserted (one descent)
+  void remove(const std::string&);                                                    // Removes a key-value pair from the tree
+  void replace(const std::string&, const Value&);                                     // Replaces the value of an existing key
+  void clear();                                                                       // Clears the tree
+
+  // Prefix queries, visiting only the subtree below the prefix
+  template <typename Fn>
+  void for_each_prefix(const std::string&, Fn);                                       // Calls fn(key, value) on every pair whose key starts with the prefix (in order)
+  const size_t count_prefix(const std::string&) const;                                // Counts the keys starting with the prefix
+
+  // Utility
+  void in_order();                                                                    // Prints the tree (in order)
+  std::vector<std::pair<std::string, Value>> to_vector();                             // Returns the tree as a vector
+  template <typename Fn>
+  void for_each(Fn);                                                                  // Calls fn(key, value) on every pair (in order)
+  template <typename T, typename Op>
+  T reduce(T, Op) const;                                                              // Folds op(accumulator, key, value) over every pair (in order)
+  template <typename Pred>
+  const size_t count_if(Pred) const;                                                  // Counts the pairs for which pred(key, value) holds
+
+  // Iterator, rebuilding each key from the bytes along its path
+  class Iterator {
+  private:
+    // Struct recording an inner node on the path to the current leaf
+    struct Frame {
+      const RadixInner* node;         // Inner node
+      int next;                       // Smallest byte not visited yet, -1 before the terminal leaf
+      size_t length;                  // Key length after the node's prefix
+    };
+
+    std::vector<Frame> path;          // Inner nodes from the root down to the current leaf
+    std::string key;                  // Key of the current leaf
+    Leaf* current;                    // Pointer to the current leaf in the iteration
+
+    // Private helper function to enter a subtree whose bytes above are already in key
+    void enter(RadixNode* node) {
+      if (node->type == RadixNodeType::Leaf) {
+        current = as_leaf(node);
+        key += current->suffix.view();
+        return;
+      }
+
+      RadixInner* inner = as_inner(node);
+      key += inner->prefix.view();
+      path.push_back(Frame{inner, -1, key.size()});
+      advance();
+    }
+
+    // Private helper function to move to the next leaf in order
+    void advance() {
+      current = nullptr;
+      while (!path.empty()) {
+        Frame& frame = path.back();
+        key.resize(frame.length);
+
+        if (frame.next < 0) {
+          frame.next = 0;
+          if (frame.node->terminal != nullptr) {
+            current = as_leaf(frame.node->terminal);
+            return;
+          }
+        }
+
+        int byte = 0;
+        RadixNode* child = next_child(frame.node, frame.next, byte);
+        if (child == nullptr) {
+          path.pop_back();
+          continue;
+        }
+
+        frame.next = byte + 1;
+        key.push_back(char(byte));
+        enter(child);
+        return;
+      }
+    }
+
+  public:
+    // Constructors
+    Iterator() : current(nullptr) {}
+    Iterator(RadixNode* root) : current(nullptr) {
+      if (root != nullptr) enter(root);
+    }
+
+    // Dereference operator (non-const value)
+    Value& operator*() const { return current->value; }
+
+    // Get the current key
+    const std::string& get_key() const { return key; }
+
+    // Get the current value
+    Value& get_value() { return current->value; }
+    const Value& get_value() const { return current->value; }
+
+    // Increment operator
+    Iterator& operator++() {
+      if (current != nullptr) advance();
+      return *this;
+    }
+
+    // Inequality operator
+    bool operator!=(const Iterator& other) const { return current != other.current; }
+  };
+
+  // Iterator methods
+  Iterator begin() { return Iterator(root); }               // Returns an iterator pointing to the smallest key
+  Iterator end() { return Iterator(); }                     // Returns an iterator pointing to the end
+  const Iterator begin() const { return Iterator(root); }   // Returns a const iterator pointing to the smallest key
+  const Iterator end() const { return Iterator(); }         // Returns a const iterator pointing to the end
+};
+
+// Function Definitions
+template <typename Value>
+RadixNode** RadixTree<Value>::find_child(RadixInner* node, unsigned char byte) {
+  switch (node->type) {
+    case RadixNodeType::Node4: {
+      RadixNode4* node4 = static_cast<RadixNode4*>(node);
+      for (int i = 0; i < node4->count; i++) {
+        if (node4->keys[i] == byte) return &node4->children[i];
+      }
+      return nullptr;
+    }
+    case RadixNodeType::Node16: {
+      RadixNode16* node16 = static_cast<RadixNode16*>(node);
+#if defined(__SSE2__)
+      // Compare the byte against all 16 keys at once, masking off the unused slots
+      __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(char(byte)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(node16->keys)));
+      unsigned mask = unsigned(_mm_movemask_epi8(matches)) & ((1u << node16->count) - 1);
+      if (mask == 0) return nullptr;
+      return &node16->children[__builtin_ctz(mask)];
+#else
+      for (int i = 0; i < node16->count; i++) {
+        if (node16->keys[i] == byte) return &node16->children[i];
+      }
+      return nullptr;
+#endif
+    }
+    case RadixNodeType::Node48: {
+      RadixNode48* node48 = static_cast<RadixNode48*>(node);
+      unsigned char slot = node48->index[byte];
+      return slot == 0 ? nullptr : &node48->children[slot - 1];
+    }
+    case RadixNodeType::Node256: {
+      RadixNode256* node256 = static_cast<RadixNode256*>(node);
+      return node256->children[byte] == nullptr ? nullptr : &node256->children[byte];
+    }
+    default:
+      return nullptr;
+  }
+}
+
+template <typename Value>
+RadixNode* RadixTree<Value>::next_child(const RadixInner* node, int from, int& byte) {
+  switch (node->type) {
+    case RadixNodeType::Node4: {
+      const RadixNode4* node4 = static_cast<const RadixNode4*>(node);
+      for (int i = 0; i < node4->count; i++) {
+        if (node4->keys[i] >= from) {
+          byte = node4->keys[i];
+          return node4->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case RadixNodeType::Node16: {
+      const RadixNode16* node16 = static_cast<const RadixNode16*>(node);
+      for (int i = 0; i < node16->count; i++) {
+        if (node16->keys[i] >= from) {
+          byte = node16->keys[i];
+          return node16->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case RadixNodeType::Node48: {
+      const RadixNode48* node48 = static_cast<const RadixNode48*>(node);
+      for (int i = from; i < 256; i++) {
+        if (node48->index[i] != 0) {
+          byte = i;
+          return node48->children[node48->index[i] - 1];
+        }
+      }
+      return nullptr;
+    }
+    case RadixNodeType::Node256: {
+      const RadixNode256* node256 = static_cast<const RadixNode256*>(node);
+      for (int i = from; i < 256; i++) {
+        if (node256->children[i] != nullptr) {
+          byte = i;
+          return node256->children[i];
+        }
+      }
+      return nullptr;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+template <typename Value>
+void RadixTree<Value>::add_child(RadixNode*& slot, unsigned char byte, RadixNode* child) {
+  RadixInner* node = as_inner(slot);
+
+  switch (node->type) {
+    case RadixNodeType::Node4: {
+      RadixNode4* node4 = static_cast<RadixNode4*>(node);
+      if (node4->count < 4) {
+        int i = node4->count;
+        for (; i > 0 && node4->keys[i - 1] > byte; i--) {
+          node4->keys[i] = node4->keys[i - 1];
+          node4->children[i] = node4->children[i - 1];
+        }
+        node4->keys[i] = byte;
+        node4->children[i] = child;
+        node4->count++;
+        return;
+      }
+
+      RadixNode16* bigger = new RadixNode16(std::move(node4->prefix));
+      bigger->terminal = node4->terminal;
+      bigger->count = node4->count;
+      std::memcpy(bigger->keys, node4->keys, sizeof(node4->keys));
+      std::memcpy(bigger->children, node4->children, sizeof(node4->children));
+      delete node4;
+      slot = bigger;
+      break;
+    }
+    case RadixNodeType::Node16: {
+      RadixNode16* node16 = static_cast<RadixNode16*>(node);
+      if (node16->count < 16) {
+        int i = node16->count;
+        for (; i > 0 && node16->keys[i - 1] > byte; i--) {
+          node16->keys[i] = node16->keys[i - 1];
+          node16->children[i] = node16->children[i - 1];
+        }
+        node16->keys[i] = byte;
+        node16->children[i] = child;
+        node16->count++;
+        return;
+      }
+
+      RadixNode48* bigger = new RadixNode48(std::move(node16->prefix));
+      bigger->terminal = node16->terminal;
+      bigger->count = node16->count;
+      for (int i = 0; i < node16->count; i++) {
+        bigger->index[node16->keys[i]] = (unsigned char)(i + 1);
+        bigger->children[i] = node16->children[i];
+      }
+      delete node16;
+      slot = bigger;
+      break;
+    }
+    case RadixNodeType::Node48: {
+      RadixNode48* node48 = static_cast<RadixNode48*>(node);
+      if (node48->count < 48) {
+        int free = 0;
+        while (node48->children[free] != nullptr) {
+          free++;
+        }
+        node48->index[byte] = (unsigned char)(free + 1);
+        node48->children[free] = child;
+        node48->count++;
+        return;
+      }
+
+      RadixNode256* bigger = new RadixNode256(std::move(node48->prefix));
+      bigger->terminal = node48->terminal;
+      bigger->count = node48->count;
+      for (int i = 0; i < 256; i++) {
+        if (node48->index[i] != 0) bigger->children[i] = node48->children[node48->index[i] - 1];
+      }
+      delete node48;
+      slot = bigger;
+      break;
+    }
+    case RadixNodeType::Node256: {
+      RadixNode256* node256 = static_cast<RadixNode256*>(node);
+      node256->children[byte] = child;
+      node256->count++;
+      return;
+    }
+    default:
+      return;
+  }
+
+  // The node grew, add the child to its replacement
+  add_child(slot, byte, child);
+}
+
+template <typename Value>
+void RadixTree<Value>::remove_child(RadixNode*& slot, unsigned char byte) {
+  RadixInner* node = as_inner(slot);
+
+  switch (node->type) {
+    case RadixNodeType::Node4: {
+      RadixNode4* node4 = static_cast<RadixNode4*>(node);
+      int i = 0;
+      while (node4->keys[i] != byte) {
+        i++;
+      }
+      for (; i + 1 < node4->count; i++) {
+        node4->keys[i] = node4->keys[i + 1];
+        node4->children[i] = node4->children[i + 1];
+      }
+      break;
+    }
+    case RadixNodeType::Node16: {
+      RadixNode16* node16 = static_cast<RadixNode16*>(node);
+      int i = 0;
+      while (node16->keys[i] != byte) {
+        i++;
+      }
+      for (; i + 1 < node16->count; i++) {
+        node16->keys[i] = node16->keys[i + 1];
+        node16->children[i] = node16->children[i + 1];
+      }
+      break;
+    }
+    case RadixNodeType::Node48: {
+      RadixNode48* node48 = static_cast<RadixNode48*>(node);
+      node48->children[node48->index[byte] - 1] = nullptr;
+      node48->index[byte] = 0;
+      break;
+    }
+    case RadixNodeType::Node256: {
+      RadixNode256* node256 = static_cast<RadixNode256*>(node);
+      node256->children[byte] = nullptr;
+      break;
+    }
+    default:
+      return;
+  }
+
+  node->count--;
+  compact(slot);
+}
+
+template <typename Value>
+void RadixTree<Value>::compact(RadixNode*& slot) {
+  RadixInner* node = as_inner(slot);
+
+  // A node left with only its terminal becomes that leaf
+  if (node->count == 0) {
+    RadixNode* terminal = node->terminal;
+    if (terminal != nullptr) as_leaf(terminal)->suffix = std::move(node->prefix);
+    slot = terminal;
+    free_node(node);
+    return;
+  }
+
+  // A node left with a single child merges into it, the child taking over the path
+  if (node->count == 1 && node->terminal == nullptr) {
+    int byte = 0;
+    RadixNode* child = next_child(node, 0, byte);
+    std::string path(node->prefix.view());
+    path.push_back(char(byte));
+
+    if (child->type == RadixNodeType::Leaf) {
+      as_leaf(child)->suffix.prepend(path);
+    } else {
+      as_inner(child)->prefix.prepend(path);
+    }
+    slot = child;
+    free_node(node);
+    return;
+  }
+
+  // Shrink well below each capacity so a node does not flip sizes on every insert and remove
+  if (node->type == RadixNodeType::Node16 && node->count <= 3) {
+    RadixNode16* node16 = static_cast<RadixNode16*>(node);
+    RadixNode4* smaller = new RadixNode4(std::move(node16->prefix));
+    smaller->terminal = node16->terminal;
+    smaller->count = node16->count;
+    std::memcpy(smaller->keys, node16->keys, node16->count);
+    std::memcpy(smaller->children, node16->children, node16->count * sizeof(RadixNode*));
+    delete node16;
+    slot = smaller;
+
+  } else if (node->type == RadixNodeType::Node48 && node->count <= 12) {
+    RadixNode48* node48 = static_cast<RadixNode48*>(node);
+    RadixNode16* smaller = new RadixNode16(std::move(node48->prefix));
+    smaller->terminal = node48->terminal;
+    for (int i = 0; i < 256; i++) {
+      if (node48->index[i] == 0) continue;
+      smaller->keys[smaller->count] = (unsigned char)i;
+      smaller->children[smaller->count] = node48->children[node48->index[i] - 1];
+      smaller->count++;
+    }
+    delete node48;
+    slot = smaller;
+
+  } else if (node->type == RadixNodeType::Node256 && node->count <= 37) {
+    RadixNode256* node256 = static_cast<RadixNode256*>(node);
+    RadixNode48* smaller = new RadixNode48(std::move(node256->prefix));
+    smaller->terminal = node256->terminal;
+    for (int i = 0; i < 256; i++) {
+      if (node256->children[i] == nullptr) continue;
+      smaller->children[smaller->count] = node256->children[i];
+      smaller->count++;
+      smaller->index[i] = (unsigned char)smaller->count;
+    }
+    delete node256;
+    slot = smaller;
+  }
+}
+
+template <typename Value>
+size_t RadixTree<Value>::common_length(std::string_view bytes, const std::string& key, size_t depth) {
+  size_t limit = std::min(bytes.size(), key.size() - depth);
+  size_t length = 0;
+  while (length < limit && bytes[length] == key[depth + length]) {
+    length++;
+  }
+  return length;
+}
+
+template <typename Value>
+const RadixLeaf<Value>* RadixTree<Value>::find_leaf(const std::string& key) const {
+  const RadixNode* node = root;
+  size_t depth = 0;
+
+  while (node != nullptr) {
+    if (node->type == RadixNodeType::Leaf) {
+      const Leaf* leaf = as_leaf(node);
+      if (key.size() - depth != leaf->suffix.size() || key.compare(depth, std::string::npos, leaf->suffix.view()) != 0) return nullptr;
+      return leaf;
+    }
+
+    const RadixInner* inner = as_inner(node);
+    size_t length = inner->prefix.size();
+    if (key.size() - depth < length || key.compare(depth, length, inner->prefix.view()) != 0) return nullptr;
+    depth += length;
+
+    if (depth == key.size()) return as_leaf(inner->terminal);
+
+    RadixNode** child = find_child(const_cast<RadixInner*>(inner), (unsigned char)key[depth]);
+    if (child == nullptr) return nullptr;
+    node = *child;
+    depth++;
+  }
+
+  return nullptr;
+}
+
+template <typename Value>
+const RadixNode* RadixTree<Value>::find_prefix(const std::string& prefix, size_t& depth) const {
+  const RadixNode* node = root;
+  depth = 0;
+
+  while (node != nullptr) {
+    size_t rest = prefix.size() - depth;
+
+    if (node->type == RadixNodeType::Leaf) {
+      std::string_view suffix = as_leaf(node)->suffix.view();
+      if (suffix.size() < rest || suffix.compare(0, rest, prefix, depth, rest) != 0) return nullptr;
+      return node;
+    }
+
+    // The prefix may end inside the node's compressed path, in which case every key below matches
+    const RadixInner* inner = as_inner(node);
+    std::string_view path = inner->prefix.view();
+    size_t length = std::min(rest, path.size());
+    if (path.compare(0, length, prefix, depth, length) != 0) return nullptr;
+    if (rest <= path.size()) return node;
+    depth += path.size();
+
+    RadixNode** child = find_child(const_cast<RadixInner*>(inner), (unsigned char)prefix[depth]);
+    if (child == nullptr) return nullptr;
+    node = *child;
+    depth++;
+  }
+
+  return nullptr;
+}
+
+template <typename Value>
+template <typename... Args>
+RadixLeaf<Value>* RadixTree<Value>::emplace(const std::string& key, bool& inserted, Args&&... args) {
+  std::string_view bytes(key);
+  RadixNode** slot = &root;
+  size_t depth = 0;
+  inserted = true;
+
+  while (true) {
+    RadixNode* node = *slot;
+
+    if (node == nullptr) {
+      Leaf* created = new Leaf(RadixPath(bytes.substr(depth)), std::forward<Args>(args)...);
+      *slot = created;
+      tree_size++;
+      return created;
+    }
+
+    if (node->type == RadixNodeType::Leaf) {
+      Leaf* leaf = as_leaf(node);
+      size_t common = common_length(leaf->suffix.view(), key, depth);
+      bool key_ends = depth + common == key.size();
+      if (common == leaf->suffix.size() && key_ends) {
+        inserted = false;
+        return leaf;
+      }
+
+      // Split the leaf into a node holding the shared bytes, with both leaves below it
+      std::unique_ptr<Leaf> created(new Leaf(key_ends ? RadixPath() : RadixPath(bytes.substr(depth + common + 1)), std::forward<Args>(args)...));
+      RadixNode* parent = new RadixNode4(RadixPath(leaf->suffix.view().substr(0, common)));
+
+      if (common == leaf->suffix.size()) {
+        leaf->suffix.clear();
+        as_inner(parent)->terminal = leaf;
+      } else {
+        unsigned char byte = (unsigned char)leaf->suffix[common];
+        leaf->suffix.erase_front(common + 1);
+        add_child(parent, byte, leaf);
+      }
+
+      Leaf* result = created.get();
+      if (key_ends) {
+        as_inner(parent)->terminal = created.release();
+      } else {
+        add_child(parent, (unsigned char)key[depth + common], created.release());
+      }
+
+      *slot = parent;
+      tree_size++;
+      return result;
+    }
+
+    RadixInner* inner = as_inner(node);
+    size_t common = common_length(inner->prefix.view(), key, depth);
+
+    if (common < inner->prefix.size()) {
+      // The key leaves the compressed path: split the path where they part
+      bool key_ends = depth + common == key.size();
+      std::unique_ptr<Leaf> created(new Leaf(key_ends ? RadixPath() : RadixPath(bytes.substr(depth + common + 1)), std::forward<Args>(args)...));
+      RadixNode* parent = new RadixNode4(RadixPath(inner->prefix.view().substr(0, common)));
+
+      unsigned char byte = (unsigned char)inner->prefix[common];
+      inner->prefix.erase_front(common + 1);
+      add_child(parent, byte, inner);
+
+      Leaf* result = created.get();
+      if (key_ends) {
+        as_inner(parent)->terminal = created.release();
+      } else {
+        add_child(parent, (unsigned char)key[depth + common], created.release());
+      }
+
+      *slot = parent;
+      tree_size++;
+      return result;
+    }
+
+    depth += common;
+    if (depth == key.size()) {
+      if (inner->terminal != nullptr) {
+        inserted = false;
+        return as_leaf(inner->terminal);
+      }
+
+      Leaf* created = new Leaf(RadixPath(), std::forward<Args>(args)...);
+      inner->terminal = created;
+      tree_size++;
+      return created;
+    }
+
+    unsigned char byte = (unsigned char)key[depth];
+    RadixNode** child = find_child(inner, byte);
+    if (child == nullptr) {
+      std::unique_ptr<Leaf> created(new Leaf(RadixPath(bytes.substr(depth + 1)), std::forward<Args>(args)...));
+      add_child(*slot, byte, created.get());
+      tree_size++;
+      return created.release();
+    }
+
+    slot = child;
+    depth++;
+  }
+}
+
+template <typename Value>
+void RadixTree<Value>::free_node(RadixNode* node) {
+  switch (node->type) {
+    case RadixNodeType::Leaf: delete as_leaf(node); break;
+    case RadixNodeType::Node4: delete static_cast<RadixNode4*>(node); break;
+    case RadixNodeType::Node16: delete static_cast<RadixNode16*>(node); break;
+    case RadixNodeType::Node48: delete static_cast<RadixNode48*>(node); break;
+    case RadixNodeType::Node256: delete static_cast<RadixNode256*>(node); break;
+  }
+}
+
+template <typename Value>
+void RadixTree<Value>::clear(RadixNode* node) {
+  if (node == nullptr) return;
+
+  if (node->type != RadixNodeType::Leaf) {
+    RadixInner* inner = as_inner(node);
+    clear(inner->terminal);
+
+    int byte = 0;
+    for (RadixNode* child = next_child(inner, 0, byte); child != nullptr; child = next_child(inner, byte + 1, byte)) {
+      clear(child);
+    }
+  }
+
+  free_node(node);
+}
+
+template <typename Value>
+RadixNode* RadixTree<Value>::clone(const RadixNode* node) {
+  if (node == nullptr) return nullptr;
+
+  RadixInner* copy;
+  switch (node->type) {
+    case RadixNodeType::Leaf: {
+      const Leaf* leaf = as_leaf(node);
+      return new Leaf(leaf->suffix, leaf->value);
+    }
+    case RadixNodeType::Node4: copy = new RadixNode4(*static_cast<const RadixNode4*>(node)); break;
+    case RadixNodeType::Node16: copy = new RadixNode16(*static_cast<const RadixNode16*>(node)); break;
+    case RadixNodeType::Node48: copy = new RadixNode48(*static_cast<const RadixNode48*>(node)); break;
+    default: copy = new RadixNode256(*static_cast<const RadixNode256*>(node)); break;
+  }
+
+  // The copy still points at the original's children, replace each with a copy
+  copy->terminal = clone(copy->terminal);
+  int byte = 0;
+  for (RadixNode* child = next_child(copy, 0, byte); child != nullptr; child = next_child(copy, byte + 1, byte)) {
+    *find_child(copy, (unsigned char)byte) = clone(child);
+  }
+  return copy;
+}
+
+template <typename Value>
+template <typename Fn>
+void RadixTree<Value>::for_each(RadixNode* node, std::string& key, Fn& fn) {
+  size_t length = key.size();
+
+  if (node->type == RadixNodeType::Leaf) {
+    Leaf* leaf = as_leaf(node);
+    key += leaf->suffix.view();
+    fn(const_cast<const std::string&>(key), leaf->value);
+    key.resize(length);
+    return;
+  }
+
+  RadixInner* inner = as_inner(node);
+  key += inner->prefix.view();
+  if (inner->terminal != nullptr) fn(const_cast<const std::string&>(key), as_leaf(inner->terminal)->value);
+
+  size_t below = key.size();
+  int byte = 0;
+  for (RadixNode* child = next_child(inner, 0, byte); child != nullptr; child = next_child(inner, byte + 1, byte)) {
+    key.push_back(char(byte));
+    for_each(child, key, fn);
+    key.resize(below);
+  }
+  key.resize(length);
+}
+
+template <typename Value>
+void RadixTree<Value>::measure(const RadixNode* node, MemoryUsage& usage) {
+  if (node == nullptr) return;
+
+  // Counts key bytes as payload; inline bytes were already counted with the node as overhead,
+  // while a path too long to fit inline adds a heap block of exactly its bytes
+  auto add_path = [&usage](const RadixPath& bytes) {
+    usage.payload += bytes.size();
+    if (bytes.heap_bytes() > 0) {
+      usage.allocations++;
+    } else {
+      usage.overhead -= bytes.size();
+    }
+  };
+
+  usage.allocations++;
+  switch (node->type) {
+    case RadixNodeType::Leaf: {
+      const Leaf* leaf = as_leaf(node);
+      usage.payload += sizeof(Value);
+      usage.overhead += sizeof(Leaf) - sizeof(Value);
+      add_path(leaf->suffix);
+      return;
+    }
+    case RadixNodeType::Node4:
+      usage.overhead += sizeof(RadixNode4) - (4 - as_inner(node)->count) * sizeof(RadixNode*);
+      usage.slack += (4 - as_inner(node)->count) * sizeof(RadixNode*);
+      break;
+    case RadixNodeType::Node16:
+      usage.overhead += sizeof(RadixNode16) - (16 - as_inner(node)->count) * sizeof(RadixNode*);
+      usage.slack += (16 - as_inner(node)->count) * sizeof(RadixNode*);
+      break;
+    case RadixNodeType::Node48:
+      usage.overhead += sizeof(RadixNode48) - (48 - as_inner(node)->count) * sizeof(RadixNode*);
+      usage.slack += (48 - as_inner(node)->count) * sizeof(RadixNode*);
+      break;
+    case RadixNodeType::Node256:
+      usage.overhead += sizeof(RadixNode256) - (256 - as_inner(node)->count) * sizeof(RadixNode*);
+      usage.slack += (256 - as_inner(node)->count) * sizeof(RadixNode*);
+      break;
+  }
+
+  const RadixInner* inner = as_inner(node);
+  add_path(inner->prefix);
+  measure(inner->terminal, usage);
+
+  int byte = 0;
+  for (RadixNode* child = next_child(inner, 0, byte); child != nullptr; child = next_child(inner, byte + 1, byte)) {
+    measure(child, usage);
+  }
+}
+
+template <typename Value>
+RadixTree<Value>::RadixTree(std::vector<std::pair<std::string, Value>> vector) : root(nullptr), tree_size(0) {
+  for (auto& element : vector) {
+    insert(element.first, std::move(element.second));
+  }
+}
+
+template <typename Value>
+RadixTree<Value>::RadixTree(const RadixTree<Value>& other) : root(clone(other.root)), tree_size(other.tree_size) {}
+
+template <typename Value>
+RadixTree<Value>::RadixTree(RadixTree<Value>&& other) noexcept : root(other.root), tree_size(other.tree_size) {
+  other.root = nullptr;
+  other.tree_size = 0;
+}
+
+template <typename Value>
+RadixTree<Value>::~RadixTree() {
+  clear();
+}
+
+template <typename Value>
+RadixTree<Value>& RadixTree<Value>::operator=(const RadixTree<Value>& other) {
+  if (this != &other) {
+    RadixTree<Value> copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename Value>
+RadixTree<Value>& RadixTree<Value>::operator=(RadixTree<Value>&& other) noexcept {
+  if (this != &other) {
+    clear();
+    std::swap(root, other.root);
+    std::swap(tree_size, other.tree_size);
+  }
+  return *this;
+}
+
+template <typename Value>
+Value& RadixTree<Value>::search(const std::string& key) {
+  const Leaf* leaf = find_leaf(key);
+  if (leaf == nullptr) throw std::out_of_range("Key not found!");
+  return const_cast<Leaf*>(leaf)->value;
+}
+
+template <typename Value>
+const Value& RadixTree<Value>::search(const std::string& key) const {
+  const Leaf* leaf = find_leaf(key);
+  if (leaf == nullptr) throw std::out_of_range("Key not found!");
+  return leaf->value;
+}
+
+template <typename Value>
+Value* RadixTree<Value>::find(const std::string& key) {
+  const Leaf* leaf = find_leaf(key);
+  return leaf == nullptr ? nullptr : &const_cast<Leaf*>(leaf)->value;
+}
+
+template <typename Value>
+const Value* RadixTree<Value>::find(const std::string& key) const {
+  const Leaf* leaf = find_leaf(key);
+  return leaf == nullptr ? nullptr : &leaf->value;
+}
+
+template <typename Value>
+const bool RadixTree<Value>::contains(const std::string& key) const {
+  return find_leaf(key) != nullptr;
+}
+
+template <typename Value>
+const bool RadixTree<Value>::empty() const {
+  return root == nullptr;
+}
+
+template <typename Value>
+const int RadixTree<Value>::size() const {
+  return tree_size;
+}
+
+template <typename Value>
+const MemoryUsage RadixTree<Value>::memory_usage() const {
+  MemoryUsage usage;
+  usage.overhead = sizeof(*this);
+  measure(root, usage);
+  return usage;
+}
+
+template <typename Value>
+void RadixTree<Value>::insert(const std::string& key, const Value& value) {
+  bool inserted;
+  emplace(key, inserted, value);
+}
+
+template <typename Value>
+void RadixTree<Value>::insert(std::string&& key, Value&& value) {
+  bool inserted;
+  emplace(key, inserted, std::move(value));
+}
+
+template <typename Value>
+template <typename... Args>
+bool RadixTree<Value>::try_emplace(const std::string& key, Args&&... args) {
+  bool inserted;
+  emplace(key, inserted, std::forward<Args>(args)...);
+  return inserted;
+}
+
+template <typename Value>
+template <typename... Args>
+Value& RadixTree<Value>::get_or_insert(const std::string& key, Args&&... args) {
+  bool inserted;
+  return emplace(key, inserted, std::forward<Args>(args)...)->value;
+}
+
+template <typename Value>
+template <typename V>
+bool RadixTree<Value>::insert_or_assign(const std::string& key, V&& value) {
+  // The value is only forwarded into a new leaf, so it is still intact when the key already exists
+  bool inserted;
+  Leaf* leaf = emplace(key, inserted, std::forward<V>(value));
+  if (!inserted) leaf->value = std::forward<V>(value);
+  return inserted;
+}
+
+template <typename Value>
+void RadixTree<Value>::remove(const std::string& key) {
+  if (root == nullptr) return;
+
+  if (root->type == RadixNodeType::Leaf) {
+    if (find_leaf(key) == nullptr) return;
+    free_node(root);
+    root = nullptr;
+    tree_size--;
+    return;
+  }
+
+  // Walk down to the inner node holding the key's leaf, which is the only node that needs compacting
+  RadixNode** slot = &root;
+  size_t depth = 0;
+  while (true) {
+    RadixInner* inner = as_inner(*slot);
+    size_t length = inner->prefix.size();
+    if (key.size() - depth < length || key.compare(depth, length, inner->prefix.view()) != 0) return;
+    depth += length;
+
+    if (depth == key.size()) {
+      if (inner->terminal == nullptr) return;
+      free_node(inner->terminal);
+      inner->terminal = nullptr;
+      tree_size--;
+      compact(*slot);
+      return;
+    }
+
+    unsigned char byte = (unsigned char)key[depth];
+    RadixNode** child = find_child(inner, byte);
+    if (child == nullptr) return;
+    depth++;
+
+    if ((*child)->type == RadixNodeType::Leaf) {
+      std::string_view suffix = as_leaf(*child)->suffix.view();
+      if (key.size() - depth != suffix.size() || key.compare(depth, std::string::npos, suffix) != 0) return;
+      free_node(*child);
+      tree_size--;
+      remove_child(*slot, byte);
+      return;
+    }
+
+    slot = child;
+  }
+}
+
+template <typename Value>
+void RadixTree<Value>::replace(const std::string& key, const Value& value) {
+  search(key) = value;
+}
+
+template <typename Value>
+void RadixTree<Value>::clear() {
+  clear(root);
+  root = nullptr;
+  tree_size = 0;
+}
+
+template <typename Value>
+template <typename Fn>
+void RadixTree<Value>::for_each_prefix(const std::string& prefix, Fn fn) {
+  size_t depth = 0;
+  const RadixNode* node = find_prefix(prefix, depth);
+  if (node == nullptr) return;
+
+  std::string key = prefix.substr(0, depth);
+  for_each(const_cast<RadixNode*>(node), key, fn);
+}
+
+template <typename Value>
+const size_t RadixTree<Value>::count_prefix(const std::string& prefix) const {
+  size_t depth = 0;
+  const RadixNode* node = find_prefix(prefix, depth);
+  if (node == nullptr) return 0;
+
+  size_t count = 0;
+  std::string key = prefix.substr(0, depth);
+  auto counter = [&count](const std::string&, const Value&) { count++; };
+  for_each(const_cast<RadixNode*>(node), key, counter);
+  return count;
+}
+
+template <typename Value>
+void RadixTree<Value>::in_order() {
+  for_each([](const std::string& key, const Value& value) {
+    std::cout << "(" << key << "," << value << "), ";
+  });
+  std::cout << std::endl;
+}
+
+template <typename Value>
+std::vector<std::pair<std::string, Value>> RadixTree<Value>::to_vector() {
+  std::vector<std::pair<std::string, Value>> vector;
+  vector.reserve(tree_size);
+  for_each([&vector](const std::string& key, const Value& value) {
+    vector.push_back(std::pair<std::string, Value>(key, value));
+  });
+  return vector;
+}
+
+template <typename Value>
+template <typename Fn>
+void RadixTree<Value>::for_each(Fn fn) {
+  if (root == nullptr) return;
+
+  std::string key;
+  for_each(root, key, fn);
+}
+
+template <typename Value>
+template <typename T, typename Op>
+T RadixTree<Value>::reduce(T init, Op op) const {
+  if (root == nullptr) return init;
+
+  // The traversal is shared with for_each; op only ever sees const values
+  std::string key;
+  auto fold = [&init, &op](const std::string& key, const Value& value) { init = op(std::move(init), key, value); };
+  for_each(root, key, fold);
+  return init;
+}
+
+template <typename Value>
+template <typename Pred>
+const size_t RadixTree<Value>::count_if(Pred pred) const {
+  return reduce(size_t(0), [&pred](size_t count, const std::string& key, const Value& value) {
+    return pred(key, value) ? count + 1 : count;
+  });
+}
+
+#endif
@@ -0,0 +1,88 @@
+// TreeCompare.hpp
+#ifndef TREECOMPARE_H
+#define TREECOMPARE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Prefix of a key cached in every AVLTree and BST node, so a comparator can settle most comparisons without reading the key
+// Empty for every key type but std::string; nodes derive from it, so nodes of other keys do not grow
+template <typename Key>
+struct KeyPrefix {
+  KeyPrefix() {}
+  explicit KeyPrefix(const Key&) {}
+};
+
+// The first 8 bytes of a string, big-endian and zero padded, so prefixes compare as integers the way the strings compare
+template <>
+struct KeyPrefix<std::string> {
+  uint64_t bits;                      // First 8 bytes of the key
+
+  KeyPrefix() : bits(0) {}
+  explicit KeyPrefix(const std::string& key) : bits(0) {
+    size_t count = key.size() < 8 ? key.size() : 8;
+    for (size_t i = 0; i < count; i++) {
+      bits |= uint64_t(static_cast<unsigned char>(key[i])) << (56 - 8 * i);
+    }
+  }
+};
+
+// Comparator policies of AVLTree and BST
+// A comparator returns a negative int, zero or a positive int as its first key orders before, like or after its second,
+// so each tree level costs one comparison instead of a < followed by a >
+// Any type with int operator()(const Key&, const Key&) const will do; it may add an overload also taking the KeyPrefix of each key
+
+// Default comparator, built from operator< for keys without a cheaper three-way comparison
+template <typename Key, typename Enable = void>
+struct ThreeWayCompare {
+  int operator()(const Key& a, const Key& b) const {
+    return a < b ? -1 : (b < a ? 1 : 0);
+  }
+};
+
+// Integers and floating point keys compare without branching
+template <typename Key>
+struct ThreeWayCompare<Key, std::enable_if_t<std::is_arithmetic<Key>::value>> {
+  int operator()(const Key& a, const Key& b) const {
+    return int(b < a) - int(a < b);
+  }
+};
+
+// Strings compare in one pass, and through their cached prefixes first when the tree supplies them
+template <>
+struct ThreeWayCompare<std::string> {
+  int operator()(const std::string& a, const std::string& b) const {
+    return a.compare(b);
+  }
+
+  int operator()(const std::string& a, const KeyPrefix<std::string>& a_prefix, const std::string& b, const KeyPrefix<std::string>& b_prefix) const {
+    if (a_prefix.bits != b_prefix.bits) return a_prefix.bits < b_prefix.bits ? -1 : 1;
+
+    // Equal prefixes of strings holding at least 8 bytes leave only the tails to compare
+    if (a.size() >= 8 && b.size() >= 8) return a.compare(8, std::string::npos, b, 8, std::string::npos);
+    return a.compare(b);
+  }
+};
+
+// Uses the comparator's prefix overload when it has one
+template <typename Compare, typename Key>
+auto compare_prefixed(const Compare& compare, const Key& a, const KeyPrefix<Key>& a_prefix, const Key& b, const KeyPrefix<Key>& b_prefix, int)
+    -> decltype(int(compare(a, a_prefix, b, b_prefix))) {
+  return compare(a, a_prefix, b, b_prefix);
+}
+
+// Falls back on comparing the keys alone
+template <typename Compare, typename Key>
+int compare_prefixed(const Compare& compare, const Key& a, const KeyPrefix<Key>&, const Key& b, const KeyPrefix<Key>&, long) {
+  return compare(a, b);
+}
+
+// Compares two keys with the given comparator, through their cached prefixes if it supports them
+template <typename Compare, typename Key>
+int compare_keys(const Compare& compare, const Key& a, const KeyPrefix<Key>& a_prefix, const Key& b, const KeyPrefix<Key>& b_prefix) {
+  return compare_prefixed(compare, a, a_prefix, b, b_prefix, 0);
+}
+
+#endif
@@ -0,0 +1,148 @@
+// TreeStats.hpp
+#ifndef TREESTATS_H
+#define TREESTATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Struct holding a snapshot of the counters of a stats policy
+struct TreeStatsSnapshot {
+  uint64_t comparisons = 0;           // Nodes a key was compared against while descending
+  uint64_t rotations = 0;             // rotate_left and rotate_right calls
+  uint64_t allocations = 0;           // Nodes allocated
+  uint64_t frees = 0;                 // Nodes freed
+  uint64_t max_depth = 0;             // Deepest level a descent reached, the root being level 1
+  uint64_t iterator_steps = 0;        // Iterator increments
+};
+
+// Stats policy of AVLTree and BST that counts nothing
+// Every hook is an empty inline function, so a tree using it compiles to the same code as one without hooks
+struct NoTreeStats {
+  static constexpr bool enabled = false;
+
+  static void comparison() {}
+  static void rotation() {}
+  static void allocation() {}
+  static void free() {}
+  static void depth(int) {}
+  static void iterator_step() {}
+
+  static TreeStatsSnapshot snapshot() { return TreeStatsSnapshot(); }
+  static void reset() {}
+};
+
+// Stats policy of AVLTree and BST that counts into per-thread blocks
+// A thread only ever writes its own block with relaxed loads and stores, so counting costs no locked instructions
+// snapshot() sums every live block plus the counts of threads that have exited
+// Trees sharing a Tag share counters; give a tree its own Tag type to observe it alone
+template <typename Tag = void>
+class CountingTreeStats {
+private:
+  enum Counter { Comparisons, Rotations, Allocations, Frees, MaxDepth, IteratorSteps, CounterCount };
+
+  // Struct holding the counters of one thread, registered for as long as the thread lives
+  struct Block {
+    std::atomic<uint64_t> counts[CounterCount];
+
+    Block() {
+      for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+      }
+      Registry& shared = registry();
+      std::lock_guard<std::mutex> guard(shared.lock);
+      shared.blocks.push_back(this);
+    }
+
+    ~Block() {
+      Registry& shared = registry();
+      std::lock_guard<std::mutex> guard(shared.lock);
+      fold(shared.retired, *this);
+      shared.blocks.erase(std::find(shared.blocks.begin(), shared.blocks.end(), this));
+    }
+  };
+
+  // Struct holding every live block and the totals of exited threads
+  struct Registry {
+    std::mutex lock;
+    std::vector<Block*> blocks;
+    uint64_t retired[CounterCount] = {};
+  };
+
+  static Registry& registry() {
+    static Registry shared;
+    return shared;
+  }
+
+  static Block& local() {
+    thread_local Block block;
+    return block;
+  }
+
+  // Adds a block's counts to totals; the maximum depth is a maximum, not a sum
+  static void fold(uint64_t* totals, const Block& block) {
+    for (int i = 0; i < CounterCount; i++) {
+      uint64_t count = block.counts[i].load(std::memory_order_relaxed);
+      totals[i] = i == MaxDepth ? std::max(totals[i], count) : totals[i] + count;
+    }
+  }
+
+  static void add(Counter counter) {
+    std::atomic<uint64_t>& count = local().counts[counter];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+public:
+  static constexpr bool enabled = true;
+
+  static void comparison() { add(Comparisons); }
+  static void rotation() { add(Rotations); }
+  static void allocation() { add(Allocations); }
+  static void free() { add(Frees); }
+  static void iterator_step() { add(IteratorSteps); }
+  static void depth(int level) {
+    std::atomic<uint64_t>& deepest = local().counts[MaxDepth];
+    if (uint64_t(level) > deepest.load(std::memory_order_relaxed)) deepest.store(uint64_t(level), std::memory_order_relaxed);
+  }
+
+  // Returns the counts of every thread so far
+  static TreeStatsSnapshot snapshot() {
+    uint64_t totals[CounterCount] = {};
+    Registry& shared = registry();
+    {
+      std::lock_guard<std::mutex> guard(shared.lock);
+      for (int i = 0; i < CounterCount; i++) {
+        totals[i] = shared.retired[i];
+      }
+      for (const Block* block : shared.blocks) {
+        fold(totals, *block);
+      }
+    }
+
+    TreeStatsSnapshot snapshot;
+    snapshot.comparisons = totals[Comparisons];
+    snapshot.rotations = totals[Rotations];
+    snapshot.allocations = totals[Allocations];
+    snapshot.frees = totals[Frees];
+    snapshot.max_depth = totals[MaxDepth];
+    snapshot.iterator_steps = totals[IteratorSteps];
+    return snapshot;
+  }
+
+  // Zeroes every counter; counts made by other threads while resetting may survive it
+  static void reset() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    for (auto& total : shared.retired) {
+      total = 0;
+    }
+    for (Block* block : shared.blocks) {
+      for (auto& count : block->counts) {
+        count.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+#endif